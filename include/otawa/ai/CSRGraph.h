@@ -0,0 +1,119 @@
+/*
+ *	CSRGraph class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_CSRGRAPH_H_
+#define OTAWA_AI_CSRGRAPH_H_
+
+#include <elm/util/AllocArray.h>
+#include <otawa/cfg/features.h>
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+class CSRGraph {
+public:
+
+	class Arc {
+		friend class CSRGraph;
+	public:
+		inline Block *source(void) const { return _source; }
+		inline Edge *edge(void) const { return _edge; }
+		inline Block *sink(void) const { return _sink; }
+		inline bool isCall(void) const { return (_flags & CALL) != 0; }
+		inline bool isReturn(void) const { return (_flags & RETURN) != 0; }
+	private:
+		static const t::uint32 CALL = 0x01, RETURN = 0x02;
+		Block *_source, *_sink;
+		Edge *_edge;
+		t::uint32 _flags;
+	};
+
+	typedef Block *vertex_t;
+	typedef const Arc *edge_t;
+
+	CSRGraph(const CFGCollection& coll);
+
+	inline const CFGCollection& collection(void) const { return _coll; }
+	inline vertex_t entry(void) const { return _entry; }
+	inline vertex_t exit(void) const { return _exit; }
+	inline vertex_t sinkOf(edge_t e) const { return e->sink(); }
+	inline vertex_t sourceOf(edge_t e) const { return e->source(); }
+	inline bool isCall(edge_t e) const { return e->isCall(); }
+	inline bool isReturn(edge_t e) const { return e->isReturn(); }
+	inline bool isReached(vertex_t v) const { return _reached[v->id()]; }
+	inline vertex_t vertex(int i) const { return _blocks[i]; }
+	inline edge_t arc(int i) const { return &_arcs[i]; }
+
+	class Iterator: public PreIterator<Iterator, vertex_t> {
+	public:
+		inline Iterator(const CSRGraph& g): _g(g), _i(0) { }
+		inline bool ended(void) const { return _i >= _g._blocks.count(); }
+		inline vertex_t item(void) const { return _g._blocks[_i]; }
+		inline void next(void) { _i++; }
+	private:
+		const CSRGraph& _g;
+		int _i;
+	};
+
+	class Successor: public PreIterator<Successor, edge_t> {
+	public:
+		inline Successor(const CSRGraph& g, vertex_t v)
+			: _p(&g._arcs[0] + g._out_start[v->id()]), _e(&g._arcs[0] + g._out_start[v->id() + 1]) { }
+		inline bool ended(void) const { return _p >= _e; }
+		inline edge_t item(void) const { return _p; }
+		inline void next(void) { _p++; }
+	private:
+		const Arc *_p, *_e;
+	};
+	inline Successor succs(vertex_t v) const { return Successor(*this, v); }
+
+	class Predecessor: public PreIterator<Predecessor, edge_t> {
+	public:
+		inline Predecessor(const CSRGraph& g, vertex_t v)
+			: _a(&g._arcs[0]), _p(&g._in[0] + g._in_start[v->id()]), _e(&g._in[0] + g._in_start[v->id() + 1]) { }
+		inline bool ended(void) const { return _p >= _e; }
+		inline edge_t item(void) const { return _a + *_p; }
+		inline void next(void) { _p++; }
+	private:
+		const Arc *_a;
+		const int *_p, *_e;
+	};
+	inline Predecessor preds(vertex_t v) const { return Predecessor(*this, v); }
+
+	// Indexed concept
+	inline int index(vertex_t v) const { return v->id(); }
+	inline int count(void) const { return _blocks.count(); }
+	inline int index(edge_t e) const { return e - &_arcs[0]; }
+	inline int countArcs(void) const { return _arcs.count(); }
+
+private:
+	const CFGCollection& _coll;
+	Block *_entry, *_exit;
+	AllocArray<Block *> _blocks;
+	AllocArray<bool> _reached;
+	AllocArray<int> _out_start, _in_start, _in;
+	AllocArray<Arc> _arcs;
+};
+
+} }	// otawa::ai
+
+#endif /* OTAWA_AI_CSRGRAPH_H_ */
@@ -0,0 +1,187 @@
+/*
+ *	RankedWorkList classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2020, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_AI_RANKEDWORKLIST_H_
+#define OTAWA_AI_RANKEDWORKLIST_H_
+
+#include <elm/data/ListQueue.h>
+#include <elm/data/SortedList.h>
+#include <elm/data/Vector.h>
+#include <elm/util/BitVector.h>
+
+namespace otawa { namespace ai {
+
+using namespace elm;
+
+template <class G>
+class RankedItem {
+public:
+	typedef typename G::vertex_t vertex_t;
+	inline RankedItem(void): rank(0), seq(0), v(vertex_t()) { }
+	inline RankedItem(int r, int s, vertex_t x): rank(r), seq(s), v(x) { }
+	inline bool operator<(const RankedItem& i) const
+		{ return rank < i.rank || (rank == i.rank && seq < i.seq); }
+	static inline int compare(const RankedItem& i1, const RankedItem& i2)
+		{ return i1 < i2 ? -1 : (i2 < i1 ? 1 : 0); }
+	inline int doCompare(const RankedItem& i1, const RankedItem& i2) const
+		{ return compare(i1, i2); }
+	int rank, seq;
+	vertex_t v;
+};
+
+template <class G>
+class AbstractRankedWorkList {
+public:
+	typedef typename G::vertex_t vertex_t;
+
+	inline AbstractRankedWorkList(G& graph, bool dedup)
+		: _graph(graph), _dedup(dedup), _in(dedup ? graph.count() : 0), _seq(0) { }
+
+protected:
+	inline bool enter(vertex_t v) {
+		if(!_dedup)
+			return true;
+		int i = _graph.index(v);
+		if(_in.bit(i))
+			return false;
+		_in.set(i);
+		return true;
+	}
+	inline void leave(vertex_t v) { if(_dedup) _in.clear(_graph.index(v)); }
+	inline int seq(void) { return _seq++; }
+
+private:
+	G& _graph;
+	bool _dedup;
+	BitVector _in;
+	int _seq;
+};
+
+template <class G>
+class SortedWorkList: public AbstractRankedWorkList<G> {
+public:
+	typedef typename G::vertex_t vertex_t;
+	inline SortedWorkList(G& graph, bool dedup = true): AbstractRankedWorkList<G>(graph, dedup) { }
+	inline bool isEmpty(void) const { return _list.isEmpty(); }
+	inline operator bool(void) const { return !isEmpty(); }
+	inline void put(vertex_t v, int rank)
+		{ if(this->enter(v)) _list.add(RankedItem<G>(rank, this->seq(), v)); }
+	inline vertex_t get(void)
+		{ vertex_t v = _list.first().v; _list.removeFirst(); this->leave(v); return v; }
+private:
+	SortedList<RankedItem<G>, RankedItem<G> > _list;
+};
+
+template <class G>
+class HeapWorkList: public AbstractRankedWorkList<G> {
+public:
+	typedef typename G::vertex_t vertex_t;
+	inline HeapWorkList(G& graph, bool dedup = true): AbstractRankedWorkList<G>(graph, dedup) { }
+	inline bool isEmpty(void) const { return _heap.isEmpty(); }
+	inline operator bool(void) const { return !isEmpty(); }
+
+	void put(vertex_t v, int rank) {
+		if(!this->enter(v))
+			return;
+		RankedItem<G> x(rank, this->seq(), v);
+		int i = _heap.length();
+		_heap.add(x);
+		while(i > 0) {
+			int p = (i - 1) / 2;
+			if(!(x < _heap[p]))
+				break;
+			_heap[i] = _heap[p];
+			i = p;
+		}
+		_heap[i] = x;
+	}
+
+	vertex_t get(void) {
+		ASSERT(!isEmpty());
+		vertex_t v = _heap[0].v;
+		RankedItem<G> x = _heap.pop();
+		int n = _heap.length();
+		if(n > 0) {
+			int i = 0;
+			while(true) {
+				int c = 2 * i + 1;
+				if(c >= n)
+					break;
+				if(c + 1 < n && _heap[c + 1] < _heap[c])
+					c++;
+				if(!(_heap[c] < x))
+					break;
+				_heap[i] = _heap[c];
+				i = c;
+			}
+			_heap[i] = x;
+		}
+		this->leave(v);
+		return v;
+	}
+
+private:
+	Vector<RankedItem<G> > _heap;
+};
+
+template <class G>
+class BucketWorkList: public AbstractRankedWorkList<G> {
+public:
+	typedef typename G::vertex_t vertex_t;
+	inline BucketWorkList(G& graph, bool dedup = true)
+		: AbstractRankedWorkList<G>(graph, dedup), _min(0), _cnt(0) { }
+	~BucketWorkList(void)
+		{ for(int i = 0; i < _buckets.length(); i++) if(_buckets[i]) delete _buckets[i]; }
+	inline bool isEmpty(void) const { return _cnt == 0; }
+	inline operator bool(void) const { return !isEmpty(); }
+
+	void put(vertex_t v, int rank) {
+		ASSERTP(rank >= 0, "bucket work list requires positive ranks");
+		if(!this->enter(v))
+			return;
+		while(rank >= _buckets.length())
+			_buckets.add(nullptr);
+		if(!_buckets[rank])
+			_buckets[rank] = new ListQueue<vertex_t>();
+		_buckets[rank]->put(v);
+		if(_cnt == 0 || rank < _min)
+			_min = rank;
+		_cnt++;
+	}
+
+	vertex_t get(void) {
+		ASSERT(!isEmpty());
+		while(!_buckets[_min] || _buckets[_min]->isEmpty())
+			_min++;
+		vertex_t v = _buckets[_min]->get();
+		_cnt--;
+		this->leave(v);
+		return v;
+	}
+
+private:
+	Vector<ListQueue<vertex_t> *> _buckets;
+	int _min, _cnt;
+};
+
+} }		// otawa::ai
+
+#endif /* OTAWA_AI_RANKEDWORKLIST_H_ */
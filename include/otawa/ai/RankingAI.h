@@ -22,16 +22,16 @@
 #ifndef INCLUDE_OTAWA_AI_ORDERED_AI_H_
 #define INCLUDE_OTAWA_AI_ORDERED_AI_H_
 
-#include <elm/data/SortedList.h>
 #include <elm/types.h>
 #include <otawa/prop/Identifier.h>
 #include "features.h"
+#include "RankedWorkList.h"
 
 namespace otawa { namespace ai {
 
 using namespace elm;
 
-template <class A, class R = PropertyRanking>
+template <class A, class R = PropertyRanking, class W = HeapWorkList<typename A::graph_t> >
 class RankingAI {
 public:
 	typedef A adapter_t;
@@ -40,20 +40,23 @@ public:
 	typedef typename A::graph_t graph_t;
 	typedef typename graph_t::vertex_t vertex_t;
 	typedef typename A::store_t store_t;
+	typedef W worklist_t;
 
-	RankingAI(A& adapter, R& rank = single<R>()):
+	RankingAI(A& adapter, R& rank = single<R>(), bool dedup = true):
 		_adapter(adapter),
-		_rank(rank)
+		_rank(rank),
+		_todo(adapter.graph(), dedup),
+		_visits(0)
 		{ }
 
 	void run(void) {
 		t s;
-		_todo.add(_adapter.graph().entry());
+		put(_adapter.graph().entry());
 		while(_todo) {
 
 			// process current item
-			vertex_t v = _todo.first();
-			_todo.removeFirst();
+			vertex_t v = _todo.get();
+			_visits++;
 			_adapter.update(v, s);
 
 			// propagate modification
@@ -61,17 +64,21 @@ public:
 			if(!_adapter.domain().equals(s, p)) {
 				_adapter.store().set(v, s);
 				for(auto v_w = _adapter.graph().succs(v); v_w; v_w++)
-					_todo.add(_adapter.graph().sinkOf(v_w));
+					put(_adapter.graph().sinkOf(v_w));
 			}
 		}
 	}
 
-	inline int doCompare(vertex_t v1, vertex_t v2) const { return _rank.rankOf(v1) - _rank.rankOf(v2); }
+	inline int visits(void) const { return _visits; }
+	inline void resetVisits(void) { _visits = 0; }
 
 private:
+	inline void put(vertex_t v) { _todo.put(v, _rank.rankOf(v)); }
+
 	A& _adapter;
 	R& _rank;
-	SortedList<vertex_t, RankingAI<A, R>> _todo;
+	W _todo;
+	int _visits;
 };
 
 } }		// otawa::ai
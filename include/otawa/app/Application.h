@@ -30,6 +30,8 @@ namespace otawa {
 
 using namespace elm;
 
+class Profiler;
+
 
 // LogOption class
 class LogOption: public option::AbstractValueOption {
@@ -93,6 +95,8 @@ protected:
 	option::ListOption<string> log_for;
 	option::ListOption<string> dump_for;
 	option::SwitchOption view;
+	option::SwitchOption profile;
+	option::Value<string> profile_trace;
 
 private:
 	LogOption log_level;
@@ -101,6 +105,7 @@ private:
 	PropList props;
 	PropList *props2;
 	WorkSpace *ws;
+	Profiler *prof;
 };
 
 }	// otawa
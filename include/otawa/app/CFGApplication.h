@@ -43,6 +43,10 @@ protected:
 		cfg_virtualize,
 		cfg_unroll,
 		no_cfg_tune;
+	option::Value<string> cfg_snapshot;
+
+private:
+	bool restored;
 };
 
 } // otawa
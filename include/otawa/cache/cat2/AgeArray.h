@@ -0,0 +1,98 @@
+/*
+ *	cache::AgePool and cache::AgeArray classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_CACHE_CAT2_AGEARRAY_H_
+#define OTAWA_CACHE_CAT2_AGEARRAY_H_
+
+#include <atomic>
+#include <mutex>
+#include <elm/assert.h>
+#include <elm/data/Vector.h>
+#include <elm/types.h>
+
+namespace otawa { namespace cache {
+
+using namespace elm;
+
+class AgePool {
+public:
+	AgePool(int size);
+	inline int size(void) const { return _size; }
+	inline void lock(void) { _refs++; }
+	inline void unlock(void) { if(--_refs == 0) delete this; }
+	void *allocate(void);
+	void release(void *p);
+
+private:
+	~AgePool(void);
+	int _size, _chunk;
+	std::atomic<int> _refs;
+	std::mutex _mutex;
+	void *_free;
+	Vector<char *> _slabs;
+};
+
+class AgeArray {
+	friend class AgePool;
+public:
+	typedef t::int8 age_t;
+
+	AgeArray(int size, int init, AgePool *pool = nullptr);
+	inline AgeArray(const AgeArray& a): _b(a._b) { _b->refs++; }
+	inline ~AgeArray(void) { drop(_b); }
+
+	inline AgeArray& operator=(const AgeArray& a) {
+		a._b->refs++;
+		drop(_b);
+		_b = a._b;
+		return *this;
+	}
+
+	inline int count(void) const { return _b->size; }
+	inline AgePool *pool(void) const { return _b->pool; }
+	inline int operator[](int i) const { ASSERT(0 <= i && i < _b->size); return ages(_b)[i]; }
+	inline bool shares(const AgeArray& a) const { return _b == a._b; }
+	bool equals(const AgeArray& a) const;
+
+	inline age_t *write(void) { if(_b->refs > 1) detach(); return ages(_b); }
+	inline void set(int i, int a) { ASSERT(0 <= i && i < _b->size); if(ages(_b)[i] != a) write()[i] = a; }
+	void fill(int a);
+
+private:
+	typedef struct buf_t {
+		std::atomic<int> refs;
+		int size;
+		AgePool *pool;
+	} buf_t;
+
+	static int storage(int size);
+	static inline age_t *ages(buf_t *b) { return reinterpret_cast<age_t *>(b + 1); }
+	static buf_t *make(int size, AgePool *pool);
+	static void free(buf_t *b);
+	static inline void drop(buf_t *b) { if(--b->refs == 0) free(b); }
+	void detach(void);
+
+	buf_t *_b;
+};
+
+} }	// otawa::cache
+
+#endif /* OTAWA_CACHE_CAT2_AGEARRAY_H_ */
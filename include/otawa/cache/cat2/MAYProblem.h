@@ -31,6 +31,7 @@
 #include <otawa/cache/LBlockSet.h>
 #include <otawa/hard/Cache.h>
 #include <otawa/cfg/BasicBlock.h>
+#include <otawa/cache/cat2/AgeArray.h>
 
 namespace otawa {
 
@@ -51,29 +52,18 @@ class MAYProblem {
 			 */
 			
 		
-			inline Domain(const int _size, const int _A)
-			: A (_A), size(_size)
+			inline Domain(const int _size, const int _A, cache::AgePool *pool = nullptr)
+			: A (_A), size(_size), age(_size, -1, pool)
 			{
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
+				ASSERT(A < 127);
 			}
 			
-			inline ~Domain() {
-				delete [] age;
-			}
-			
-			inline Domain(const Domain &source) : A(source.A), size(source.size) {
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = source.age[i];
-
+			inline Domain(const Domain &source) : A(source.A), size(source.size), age(source.age) {
 			} 
 		
 			inline Domain& operator=(const Domain &src) {
 				ASSERT((A == src.A) && (size == src.size));
-				for (int i = 0; i < size ; i++)
-					age[i] = src.age[i];
+				age = src.age;
 				return(*this);
 				
 			}
@@ -85,10 +75,11 @@ class MAYProblem {
 			
 			inline void lub(const Domain &dom) {
 				ASSERT((A == dom.A) && (size == dom.size));
-
+				if (age.shares(dom.age))
+					return;
 				for (int i = 0; i < size; i++) {
 					if (((age[i] > dom.age[i]) && (dom.age[i] != -1)) || (age[i] == -1)) 
-						age[i] = dom.age[i];
+						age.set(i, dom.age[i]);
 				}
 			}
 			
@@ -100,23 +91,17 @@ class MAYProblem {
 				ASSERT((id >= 0) && (id < size));
 				if (age[id] == -1)
 					return;
-				age[id] += damage;
-				if (age[id] >= A)
-					age[id] = -1;
+				int a = age[id] + damage;
+				age.set(id, a >= A ? -1 : a);
 			}
 			
 			inline bool equals(const Domain &dom) const {
 				ASSERT((A == dom.A) && (size == dom.size));
-				for (int i = 0; i < size; i++)
-					if (age[i] != dom.age[i])
-						return false;
-				return true;
+				return age.equals(dom.age);
 			}
 			
 			inline void empty() {
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
-				
+				age.fill(-1);
 			}
 			
 			inline bool contains(const int id) {
@@ -126,21 +111,22 @@ class MAYProblem {
 			
 			
 			inline void inject(const int id) {
-				if (contains(id)) {
+				bool in = contains(id);
+				cache::AgeArray::age_t *a = age.write();
+				if (in) {
 					for (int i = 0; i < size; i++) {
-						if ((age[i] <= age[id]) && (age[i] != -1))
-							age[i]++;						
+						if ((a[i] <= a[id]) && (a[i] != -1))
+							a[i]++;						
 					}
-					age[id] = 0;
 				} else {
 					for (int i = 0; i < size; i++) {
-						if (age[i] != -1) 
-							age[i]++;
-						if (age[i] == A)
-							age[i] = -1;
+						if (a[i] != -1) 
+							a[i]++;
+						if (a[i] == A)
+							a[i] = -1;
 					}
 				}
-				age[id] = 0;				
+				a[id] = 0;				
 			}
 			
 			inline void print(elm::io::Output &output) const {
@@ -172,20 +158,27 @@ class MAYProblem {
 			inline void setAge(const int id, const int _age) {
 				ASSERT(id < size);
 				ASSERT((_age < A) || (_age == -1));
-				age[id] = _age;
+				age.set(id, _age);
+			}
+			
+			inline cache::AgePool *pool(void) const {
+				return age.pool();
 			}
 		
+		private:
 			/*
 			 * For each cache block belonging to the set: 
 			 * age[block] represents its age, from 0 (newest) to A-1 (oldest).
 			 * The value -1 means that the block is not in the set.
+			 * Copies share the storage until modified.
 			 */  
-			int *age;
+			cache::AgeArray age;
 	};
 	
 	private:
 	
 	// Fields
+	cache::AgePool *_pool;
 	LBlockSet *lbset;
 	WorkSpace *fw;
 	const int line;
@@ -209,6 +202,7 @@ class MAYProblem {
 	const Domain& bottom(void) const;
 	const Domain& top(void) const;
 	const Domain& entry(void) const;
+	inline cache::AgePool *pool(void) const { return _pool; }
 	
 		
 	inline void lub(Domain &a, const Domain &b) const {
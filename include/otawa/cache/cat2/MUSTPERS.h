@@ -39,8 +39,8 @@ public:
 	class Domain {
 		friend class MUSTPERS;
 	public:
-		inline Domain(const int _size, const int _A)
-			: pers(PERSProblem::Domain(_size, _A)), must(MUSTProblem::Domain(_size, _A))
+		inline Domain(const int _size, const int _A, cache::AgePool *pool = nullptr)
+			: pers(PERSProblem::Domain(_size, _A, pool)), must(MUSTProblem::Domain(_size, _A, pool))
 			{ }
 			
 			inline Domain(const Domain &source) : pers(source.pers), must(source.must) { }
@@ -31,6 +31,7 @@
 #include <otawa/hard/Cache.h>
 #include <otawa/cfg/BasicBlock.h>
 #include <otawa/dfa/hai/HalfAbsInt.h>
+#include <otawa/cache/cat2/AgeArray.h>
 
 
 namespace otawa {
@@ -43,29 +44,18 @@ class PERSProblem {
 			int A, size;
 			
 			public:			
-			inline Item(const int _size, const int _A)
-			: A (_A), size(_size)
+			inline Item(const int _size, const int _A, cache::AgePool *pool = nullptr)
+			: A (_A), size(_size), age(_size, -1, pool)
 			{
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
+				ASSERT(A < 127);
 			}
 			
-			inline ~Item() {
-				delete [] age;
-			}
-			
-			inline Item(const Item &source) : A(source.A), size(source.size) {
-				age = new int [size];
-				for (int i = 0; i < size; i++)
-					age[i] = source.age[i];
-
+			inline Item(const Item &source) : A(source.A), size(source.size), age(source.age) {
 			} 
 			
 			inline Item& operator=(const Item &src) {
 				ASSERT((A == src.A) && (size == src.size));		
-				for (int i = 0; i < size ; i++)
-					age[i] = src.age[i];
+				age = src.age;
 				return *this;
 			}
 			
@@ -73,30 +63,26 @@ class PERSProblem {
 				ASSERT((id >= 0) && (id < size));
 				
 				if ((newage != -1) && ((age[id] > newage) || (age[id] == -1)))
-					age[id] = newage;
+					age.set(id, newage);
 			}
 			
 			inline void lub(const Item &dom) {
 				/* ASSERT((A == dom.A) && (size == dom.size)); */
-
+				if (age.shares(dom.age))
+					return;
 				for (int i = 0; i < size; i++) {					
 					if ((age[i] == -1) || ((age[i] < dom.age[i]) && (dom.age[i] != -1)) )
-						age[i] = dom.age[i];
+						age.set(i, dom.age[i]);
 				}
 			}
 			
 			inline bool equals(const Item &dom) const {
 				ASSERT((A == dom.A) && (size == dom.size));
-				for (int i = 0; i < size; i++)
-					if (age[i] != dom.age[i])
-						return false;
-				return true;
+				return age.equals(dom.age);
 			}
 			
 			inline void empty() {
-				for (int i = 0; i < size; i++)
-					age[i] = -1;
-				
+				age.fill(-1);
 			}
 			
 			inline bool contains(const int id) {
@@ -105,19 +91,19 @@ class PERSProblem {
 			}
 			
 			inline void inject(MUSTProblem::Domain *must, const int id) {
+				cache::AgeArray::age_t *a = age.write();
 				if (must->contains(id)) {
 					for (int i = 0; i < size; i++) {
-						if ((age[i] < age[id]) && (age[i] != -1) && (age[i] != A))
-							age[i]++;						
+						if ((a[i] < a[id]) && (a[i] != -1) && (a[i] != A))
+							a[i]++;						
 					}
-					age[id] = 0;
 				} else {
 					for (int i = 0; i < size; i++) {
-						if ((age[i] != -1) && (age[i] != A)) 
-							age[i]++;
+						if ((a[i] != -1) && (a[i] != A)) 
+							a[i]++;
 					}
 				}
-				age[id] = 0;				
+				a[id] = 0;				
 			}
 			
 			inline bool isWiped(const int id) {
@@ -136,9 +122,8 @@ class PERSProblem {
 				ASSERT((id >= 0) && (id < size));
 				if (age[id] == -1)
 					return;
-				age[id] += damage;
-				if (age[id] > A)
-					age[id] = A;
+				int a = age[id] + damage;
+				age.set(id, a > A ? A : a);
 			}
 			
 			inline void print(elm::io::Output &output) const {
@@ -156,13 +141,19 @@ class PERSProblem {
 				output << "]";
 				
 			}
+			
+			inline cache::AgePool *pool(void) const {
+				return age.pool();
+			}
 		
+		private:
 			/*
 			 * For each cache block belonging to the set: 
 			 * age[block] represents its age, from 0 (newest) to A-1 (oldest).
 			 * The value -1 means that the block is not in the set.
+			 * Copies share the storage until modified.
 			 */  
-			int *age;
+			cache::AgeArray age;
 	};
 	
 	class Domain {
@@ -170,8 +161,8 @@ class PERSProblem {
 			bool isBottom;
 		public:
 
-			inline Domain(const int _size, const int _A)
-			: A (_A), size(_size), whole(_size, _A)
+			inline Domain(const int _size, const int _A, cache::AgePool *pool = nullptr)
+			: A (_A), size(_size), whole(_size, _A, pool)
 			{
 				isBottom = true;
 				whole.empty();
@@ -366,9 +357,7 @@ class PERSProblem {
 			
 			inline void enterContext() {
 				ASSERT(!isBottom);
-				Item item(size, A);
-				item.empty();
-				data.push(new Item(item));
+				data.push(new Item(size, A, whole.pool()));
 				
 			}
 			
@@ -397,6 +386,10 @@ class PERSProblem {
 	};
 
 	
+	private:
+	cache::AgePool *_pool;
+	
+	public:
 	Domain callstate;
 	
 	private:
@@ -423,6 +416,7 @@ class PERSProblem {
 	// Problem methods
 	const Domain& bottom(void) const;
 	const Domain& entry(void) const;
+	inline cache::AgePool *pool(void) const { return _pool; }
 		
 	inline void lub(Domain &a, const Domain &b) const {
 		a.lub(b);
@@ -0,0 +1,59 @@
+/*
+ *	DomTree class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2020, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_CFG_DOMTREE_H
+#define OTAWA_CFG_DOMTREE_H
+
+#include <elm/data/Array.h>
+#include <otawa/cfg/CFG.h>
+#include <otawa/prop/Identifier.h>
+
+namespace otawa {
+
+class DomTree {
+public:
+	DomTree(CFG *cfg, bool post = false);
+
+	inline CFG *cfg(void) const { return _cfg; }
+	inline bool isPost(void) const { return _post_dom; }
+	inline Block *root(void) const { return _root; }
+	inline bool isReachable(Block *b) const { return _pre[b->index()] >= 0; }
+	inline Block *idom(Block *b) const { return _idom[b->index()]; }
+	inline bool dom(Block *b1, Block *b2) const {
+		int i1 = b1->index(), i2 = b2->index();
+		return i1 == i2
+			|| (_pre[i1] >= 0 && _pre[i2] >= 0 && _pre[i1] <= _pre[i2] && _post[i2] <= _post[i1]);
+	}
+	inline int depth(Block *b) const { return _depth[b->index()]; }
+
+private:
+	CFG *_cfg;
+	bool _post_dom;
+	Block *_root;
+	AllocArray<Block *> _idom;
+	AllocArray<int> _pre, _post, _depth;
+};
+
+extern p::id<DomTree *> DOM_TREE;
+extern p::id<DomTree *> POSTDOM_TREE;
+
+}	// otawa
+
+#endif	// OTAWA_CFG_DOMTREE_H
@@ -30,7 +30,6 @@ namespace otawa {
 // External
 class BasicBlock;
 class Edge;
-namespace dfa { class BitSet; }
 
 // Dominance class
 class Dominance: public ConcurrentCFGProcessor, public DomInfo {
@@ -51,6 +50,7 @@ public:
 	static bool isLoopHeader(Block *bb);
 
 protected:
+	void setup(WorkSpace *ws) override;
 	void processCFG(WorkSpace *fw, CFG *cfg) override;
 	void cleanup(WorkSpace *ws) override;
 	void dumpCFG(CFG *g, Output& out) override;
@@ -59,9 +59,6 @@ private:
 	void markLoopHeaders(CFG *cfg);
 };
 
-// Features
-extern Identifier<const dfa::BitSet *> REVERSE_DOM;
-
 } // otawa
 
 #endif // OTAWA_CFG_DOMINANCE_H
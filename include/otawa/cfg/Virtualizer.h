@@ -36,6 +36,33 @@ namespace otawa {
 using namespace elm;
 class CFGCollection;
 
+// VirtualContext class
+class VirtualContext: public PropList {
+public:
+	VirtualContext(CFG *cfg, VirtualContext *caller = nullptr, SynthBlock *call = nullptr);
+	~VirtualContext(void);
+
+	inline CFG *cfg(void) const { return _cfg; }
+	inline VirtualContext *caller(void) const { return _caller; }
+	inline SynthBlock *call(void) const { return _call; }
+	inline VirtualContext *next(void) const { return _next; }
+	inline int depth(void) const { return _depth; }
+	bool isIn(CFG *cfg) const;
+	ContextualPath path(void) const;
+	PropList& props(Block *v);
+	const PropList& propsOf(Block *v) const;
+
+private:
+	friend class Virtualizer;
+	CFG *_cfg;
+	VirtualContext *_caller;
+	SynthBlock *_call;
+	VirtualContext *_next;
+	int _depth;
+	HashMap<Block *, PropList *> _props;
+};
+io::Output& operator<<(io::Output& out, const VirtualContext *ctx);
+
 // Virtualizer class
 class Virtualizer: public CFGProvider {
 
@@ -48,6 +75,7 @@ public:
 protected:
 	void processWorkSpace(WorkSpace *ws) override;
 	void cleanup(WorkSpace *ws) override;
+	void destroy(WorkSpace *ws) override;
 	
 private:
 	void make(struct call_t *stack, CFG *cfg, CFGMaker& maker, elm::Option<int> local_inlining, ContextualPath &path);
@@ -55,12 +83,14 @@ private:
 	CFGMaker& makerOf(CFG *cfg);
 	CFGMaker& newMaker(Inst *first);
 	bool isInlined(CFG* cfg, Option<int> local_inlining, ContextualPath &path);
+	void makeContexts(CFGCollection *coll);
 
-	bool virtualize;
+	bool virtualize, sharing;
 	CFG *entry;
 	List<CFG *> todo;
 	HashMap<CFG *, CFGMaker *> map;
 	FragTable<CFGMaker *> makers;
+	Vector<VirtualContext *> contexts;
 	//CFGCollection *coll;
 };
 
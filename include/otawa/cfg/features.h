@@ -126,6 +126,9 @@ extern Identifier<Block*> UNROLLED_FROM;
 extern Identifier<bool> VIRTUAL_DEFAULT;
 extern Identifier<bool> NO_INLINE;
 extern Identifier<bool> INLINING_POLICY;
+extern Identifier<bool> VIRTUAL_SHARING;
+class VirtualContext;
+extern p::id<VirtualContext *> VIRTUAL_CONTEXTS;
 extern p::feature VIRTUALIZED_CFG_FEATURE;
 
 // CFG_CHECKSUM_FEATURE
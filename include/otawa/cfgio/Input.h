@@ -31,6 +31,8 @@ namespace otawa { namespace cfgio {
 
 using namespace elm;
 
+namespace bin { class Image; }
+
 class Input: public Processor {
 	/*typedef avl::Map<xom::String, Block *> bb_map_t;
 	typedef avl::Map<xom::String, CFGMaker *> cfg_map_t;
@@ -61,6 +63,8 @@ protected:
 
 
 private:
+	void readXML(WorkSpace *ws);
+	void readBinary(WorkSpace *ws, const bin::Image& img);
 	/*void reset(void);
 	void clear(void);
 	void raiseError(xom::Element *elt, const string& msg);
@@ -43,6 +43,7 @@ protected:
 	string id(CFG *cfg);
 	string id(Block *bb);
 	void processProps(xom::Element *parent, const PropList& props);
+	void writeBinary(WorkSpace *ws, io::OutStream& out);
 	xom::Element *root, *cfg_node;
 	int last_bb;
 	avl::Set<const AbstractIdentifier *> ids;
@@ -50,6 +51,7 @@ protected:
 	bool all;
 	bool no_insts;
 	bool line_info;
+	bool binary;
 };
 
 } }	// otawa::cfgio
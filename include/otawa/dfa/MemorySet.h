@@ -50,6 +50,7 @@ public:
 
 	typedef struct t {
 		node_t * h;
+		inline t(void): h(0) { }
 		inline t(node_t *node) { h = node; }
 		inline operator node_t *(void) const { return h; }
 		inline Iter areas(void) const { return Iter(h); }
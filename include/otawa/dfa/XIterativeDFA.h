@@ -8,6 +8,8 @@
 #define OTAWA_DFA_XITERATIVEDFA_H
 
 #include <elm/assert.h>
+#include <elm/data/Vector.h>
+#include <elm/util/BitVector.h>
 
 namespace otawa { namespace dfa {
 
@@ -17,10 +19,13 @@ class XIterativeDFA {
 	V& visit;
 	int size;
 	typename V::domain_t **outs, **gens, **preserves, *new_out, **ins;
+	int cur;
+	elm::Vector<int> *succs, *preds;
 public:
 	inline XIterativeDFA(V& visitor);
 	inline ~XIterativeDFA(void);
 	inline void process(void);
+	inline void processWorklist(void);
 	inline void nextPred(int pred);
 	inline typename V::domain_t *in(const typename V::key_t& key)
 		{ return ins[visit.index(key)]; }
@@ -30,13 +35,16 @@ public:
 		{ return gens[visit.index(key)]; }
 	inline typename V::domain_t *preserve(const typename V::key_t& key)
 		{ return preserves[visit.index(key)]; }
+private:
+	inline bool update(int i);
+	inline void buildGraph(void);
 };
 
 
 // Inlines
 template <class V>
 inline XIterativeDFA<V>::XIterativeDFA(V& visitor)
-: visit(visitor), ins(0) {
+: visit(visitor), ins(0), cur(-1), succs(0), preds(0) {
 	size = visit.size();
 	ins = new typename V::domain_t *[size];
 	outs = new typename V::domain_t *[size];
@@ -62,40 +70,168 @@ inline XIterativeDFA<V>::~XIterativeDFA(void) {
 	delete [] outs;
 	delete [] gens;
 	delete [] preserves;
+	if(succs)
+		delete [] succs;
+	if(preds)
+		delete [] preds;
 }
 
 template <class V>
 inline void XIterativeDFA<V>::nextPred(int pred) {
 	ASSERT(pred < size);
-	new_out->join(outs[pred]);
+	if(cur >= 0) {
+		succs[pred].add(cur);
+		preds[cur].add(pred);
+	}
+	else
+		new_out->join(outs[pred]);
+}
+
+template <class V>
+inline bool XIterativeDFA<V>::update(int i) {
+	typename V::domain_t *tmp;
+	new_out->reset();
+	visit.visitPreds(*this, i);
+	tmp = new_out;
+	new_out = ins[i];
+	ins[i] = tmp;
+	new_out->reset();
+	new_out->join(ins[i]);
+	new_out->meet(preserves[i]);
+	new_out->join(gens[i]);
+	if(new_out->equals(outs[i]))
+		return false;
+	tmp = new_out;
+	new_out = outs[i];
+	outs[i] = tmp;
+	return true;
 }
 
 template <class V>
 inline void XIterativeDFA<V>::process(void) {
 	bool fixpoint = false;
-	typename V::domain_t *tmp;
 	new_out = visit.empty();
 	while(!fixpoint) {
 		fixpoint = true;
-		for(int i = 0; i < size; i++) {
-			new_out->reset();
-			visit.visitPreds(*this, i);
-			tmp = new_out;
-			new_out = ins[i];
-			ins[i] = tmp;
-			new_out->reset();
-			new_out->join(ins[i]);
-			new_out->meet(preserves[i]);
-			new_out->join(gens[i]);
-			if(!new_out->equals(outs[i])) {
+		for(int i = 0; i < size; i++)
+			if(update(i))
 				fixpoint = false;
-				tmp = new_out;
-				new_out = outs[i];
-				outs[i] = tmp;
+	}
+	visit.free(new_out);
+}
+
+template <class V>
+inline void XIterativeDFA<V>::buildGraph(void) {
+	if(succs)
+		return;
+	succs = new elm::Vector<int>[size];
+	preds = new elm::Vector<int>[size];
+	for(cur = 0; cur < size; cur++)
+		visit.visitPreds(*this, cur);
+	cur = -1;
+}
+
+template <class V>
+inline void XIterativeDFA<V>::processWorklist(void) {
+	buildGraph();
+
+	// compute the reverse post-order (iterative DFS)
+	int *order = new int[size], *next = new int[size], *stack = new int[size];
+	int n = size, sp = 0;
+	elm::BitVector visited(size);
+	for(int r = 0; r < size; r++) {
+		if(visited.bit(r))
+			continue;
+		visited.set(r);
+		next[r] = 0;
+		stack[sp++] = r;
+		while(sp) {
+			int v = stack[sp - 1];
+			if(next[v] < succs[v].length()) {
+				int w = succs[v][next[v]++];
+				if(!visited.bit(w)) {
+					visited.set(w);
+					next[w] = 0;
+					stack[sp++] = w;
+				}
+			}
+			else {
+				order[--n] = v;
+				sp--;
+			}
+		}
+	}
+
+	// find the SCCs in topological order (Kosaraju on the transposed graph)
+	int *comp = next, c = 0;
+	for(int i = 0; i < size; i++)
+		comp[i] = -1;
+	for(int i = 0; i < size; i++) {
+		int r = order[i];
+		if(comp[r] >= 0)
+			continue;
+		comp[r] = c;
+		stack[sp++] = r;
+		while(sp) {
+			int v = stack[--sp];
+			for(int j = 0; j < preds[v].length(); j++) {
+				int w = preds[v][j];
+				if(comp[w] < 0) {
+					comp[w] = c;
+					stack[sp++] = w;
+				}
+			}
+		}
+		c++;
+	}
+
+	// group the nodes by SCC, each SCC in reverse post-order
+	int *first = new int[c + 1];
+	for(int i = 0; i <= c; i++)
+		first[i] = 0;
+	for(int i = 0; i < size; i++)
+		first[comp[i] + 1]++;
+	for(int i = 0; i < c; i++)
+		first[i + 1] += first[i];
+	int *nodes = stack;
+	for(int i = 0; i < size; i++)
+		nodes[i] = order[i];
+	for(int i = 0; i < size; i++) {
+		int v = nodes[i];
+		order[first[comp[v]]++] = v;
+	}
+	for(int i = c; i > 0; i--)
+		first[i] = first[i - 1];
+	first[0] = 0;
+
+	// solve each SCC in turn, re-processing only nodes whose predecessors changed
+	elm::BitVector pending(size, true);
+	new_out = visit.empty();
+	for(int k = 0; k < c; k++) {
+		bool again = true;
+		while(again) {
+			again = false;
+			for(int i = first[k]; i < first[k + 1]; i++) {
+				int v = order[i];
+				if(!pending.bit(v))
+					continue;
+				pending.clear(v);
+				if(update(v))
+					for(int j = 0; j < succs[v].length(); j++) {
+						int w = succs[v][j];
+						pending.set(w);
+						if(comp[w] == k)
+							again = true;
+					}
 			}
 		}
 	}
 	visit.free(new_out);
+
+	delete [] order;
+	delete [] next;
+	delete [] stack;
+	delete [] first;
 }
 
 } } // otawa::dfa
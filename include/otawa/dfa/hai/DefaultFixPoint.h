@@ -58,6 +58,7 @@ public:
 
 	inline FixPointState *newState(void) { return(new FixPointState(bottom())); }
 	inline void init(HalfAbsInt<DefaultFixPoint> *_ai);
+	inline HalfAbsInt<DefaultFixPoint> *absInt(void) const { return ai; }
 	void fixPoint(Block *bb, bool &fixpoint, Domain &in, bool firstTime) const;
 
 	// edge marking functions
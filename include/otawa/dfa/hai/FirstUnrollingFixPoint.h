@@ -63,6 +63,7 @@ public:
 
 	inline int getIter(Block *bb) const { return(ai->getFixPointState(bb)->numIter); }
 	inline void init(HalfAbsInt<FirstUnrollingFixPoint> *_ai) { ai = _ai; }
+	inline HalfAbsInt<FirstUnrollingFixPoint> *absInt(void) const { return ai; }
 	void fixPoint(Block *bb, bool &fixpoint, Domain &in, bool firstTime) const;
 	
 	// edge marking functions
@@ -26,6 +26,7 @@
 
 
 #include <elm/assert.h>
+#include <elm/data/HashMap.h>
 #include <elm/data/VectorQueue.h>
 #include <elm/data/Vector.h>
 #include <otawa/cfg/CFG.h>
@@ -35,6 +36,7 @@
 #include <otawa/cfg/features.h>
 #include <otawa/prop/Identifier.h>
 #include <otawa/prog/WorkSpace.h>
+#include "WorkList.h"
 #ifdef	HAI_JSON
 #	include <otawa/dfa/Debug.h>
 #endif
@@ -80,7 +82,7 @@ extern Identifier<bool> HAI_INFINITE_LOOP;
 template <class FixPoint>
 class HalfAbsInt {
 public:
-	inline HalfAbsInt(FixPoint& _fp, WorkSpace& _fw);
+	inline HalfAbsInt(FixPoint& _fp, WorkSpace& _fw, bool ordered = true);
 	inline ~HalfAbsInt(void);
   	inline typename FixPoint::FixPointState *getFixPointState(Block *bb);
 	int solve(otawa::CFG *main_cfg = 0,
@@ -89,12 +91,17 @@ public:
 	inline typename FixPoint::Domain entryEdgeUnion(Block *bb);
 	template <class GC> inline void collect(const GC* gc) const;
 
+	// statistics of the last run
+	inline int iterations(void) const { return iter_cnt; }
+	inline int headerVisits(Block *h) const { return header_visits.get(h, 0); }
+	inline const HashMap<Block *, int>& headerVisits(void) const { return header_visits; }
+
 private:
 	FixPoint& fp;
 	WorkSpace &ws;
 	CFG& entry_cfg;
 	CFG *cur_cfg;
-	Vector<Block*> *workList;
+	WorkList *workList;
 	Vector<Edge*> *callStack;
 	Vector<CFG*> *cfgStack;
 	Block *current;
@@ -103,6 +110,8 @@ private:
 	bool enter_call; /* enter_call == true: we need to process this call. enter_call == false: already processed (call return) */
 	bool fixpoint;
 	bool mainEntry;
+	int iter_cnt;
+	HashMap<Block *, int> header_visits;
 	static Identifier<typename FixPoint::FixPointState*> FIXPOINT_STATE;
 	inline bool isEdgeDone(Edge *edge);
 	inline bool tryAddToWorkList(Block *bb);
@@ -138,7 +147,7 @@ template <class FixPoint>
 Identifier<typename FixPoint::FixPointState*> HalfAbsInt<FixPoint>::FIXPOINT_STATE("", 0);
 
 template <class FixPoint>
-inline HalfAbsInt<FixPoint>::HalfAbsInt(FixPoint& _fp, WorkSpace& _fw)
+inline HalfAbsInt<FixPoint>::HalfAbsInt(FixPoint& _fp, WorkSpace& _fw, bool ordered)
 :	fp(_fp),
  	ws(_fw),
  	entry_cfg(**ENTRY_CFG(_fw)),
@@ -149,9 +158,12 @@ inline HalfAbsInt<FixPoint>::HalfAbsInt(FixPoint& _fp, WorkSpace& _fw)
  	next_edge(0),
  	enter_call(0),
  	fixpoint(0),
- 	mainEntry(false)
+ 	mainEntry(false),
+ 	iter_cnt(0)
 {
-	workList = new Vector<Block*>();
+	if(INVOLVED_CFGS(_fw) == nullptr)
+		throw otawa::Exception("HalfAbsInt requires the CFG collection (COLLECTED_CFG_FEATURE)");
+	workList = new WorkList(INVOLVED_CFGS(_fw), ordered);
 	callStack = new Vector<Edge*>();
 	cfgStack = new Vector<CFG*>();
 	fp.init(this);
@@ -197,23 +209,12 @@ void HalfAbsInt<FixPoint>::inputProcessing(typename FixPoint::Domain &entdom) {
 
 	// exit with remaining back-end
     // if unknown vertex, look for dead-end blocks
-    if(current->isExit() && current->cfg()->unknown() != 0) {
-
-    	// find remaining block
-    	int rem = -1;
-    	for(int i = workList->length() - 1; i >= 0; i--)
-    		if(workList->get(i)->cfg() == current->cfg()) {
-    			rem = i;
-    			break;
-    		}
-
-    	// re-schedule remaining
-    	if(rem >= 0) {
-    		Block *bb = workList->get(rem);
-    		workList->set(rem, current);
-    		current = bb;
-    		HAI_TRACE("\tDELAYED BY " << current);
-    	}
+    if(current->isExit() && current->cfg()->unknown() != 0
+    && workList->contains(current->cfg())) {
+    	Block *bb = workList->popFrom(current->cfg());
+    	workList->push(current);
+    	current = bb;
+    	HAI_TRACE("\tDELAYED BY " << current);
     }
 
 	// main entry case
@@ -478,12 +479,13 @@ Edge *HalfAbsInt<FixPoint>::detectCalls(bool &enter_call, Vector<Edge*> &call_ed
 
 template <class FixPoint>
 int HalfAbsInt<FixPoint>::solve(otawa::CFG *main_cfg, typename FixPoint::Domain *entdom, Block *start_bb) {
-	int iterations = 0;
     typename FixPoint::Domain default_entry(fp.entry());
 
     // initialization
     workList->clear();
     callStack->clear();
+    iter_cnt = 0;
+    header_visits.clear();
     mainEntry = true;
     if(!main_cfg)
     	main_cfg = &entry_cfg;
@@ -508,9 +510,11 @@ int HalfAbsInt<FixPoint>::solve(otawa::CFG *main_cfg, typename FixPoint::Domain
 	while(!workList->isEmpty()) {
 
 		// next step
-		iterations++;
+		iter_cnt++;
 		fixpoint = false;
-		current = workList->pop();
+		current = workList->pop(cur_cfg);
+		if(LOOP_HEADER(current))
+			header_visits.put(current, header_visits.get(current, 0) + 1);
 
 		// update the state
 		//next_edge = detectCalls(enter_call, call_edges, current);
@@ -525,7 +529,7 @@ int HalfAbsInt<FixPoint>::solve(otawa::CFG *main_cfg, typename FixPoint::Domain
 			for(Block::EdgeIter bei=current->outs(); bei(); bei++) {
 				if(bei->target() != current)
 					if(!HAI_INFINITE_LOOP(current))
-						ASSERTP(false, "HalfAbsInt finishes at CFG " << current->cfg()->index() << ", " << current << ", does not end with the exit block. (iteration = " << iterations << ")");
+						ASSERTP(false, "HalfAbsInt finishes at CFG " << current->cfg()->index() << ", " << current << ", does not end with the exit block. (iteration = " << iter_cnt << ")");
 			} // end of each output edge of the current block
 		} // end of the current block is not an exit block, and workList is empty
 	}
@@ -536,7 +540,7 @@ int HalfAbsInt<FixPoint>::solve(otawa::CFG *main_cfg, typename FixPoint::Domain
     	HAI_BASE = 0;
 #	endif
 
-	return(iterations);
+	return(iter_cnt);
 }
 
 
@@ -602,6 +606,10 @@ inline typename FixPoint::Domain HalfAbsInt<FixPoint>::entryEdgeUnion(Block *bb)
 template <class FixPoint>
 inline bool HalfAbsInt<FixPoint>::tryAddToWorkList(Block *bb) {
 
+	// already scheduled
+	if(workList->contains(bb))
+		return true;
+
 	if(HAI_BYPASS_TARGET(bb)) {
 		typename FixPoint::Domain *bypassState = fp.getMark(bb);
 		if(!bypassState) {
@@ -85,6 +85,7 @@ private:
 	
 	// Mutators 
 	inline void init(HalfAbsInt<WideningFixPoint> *_ai);
+	inline HalfAbsInt<WideningFixPoint> *absInt(void) const { return ai; }
 	
 	// FixPoint function
 	void fixPoint(Block *bb, bool &fixpoint, Domain &in, bool firstTime) const;
@@ -0,0 +1,161 @@
+/*
+ *	hai::WorkList class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_DFA_HAI_WORKLIST_H_
+#define OTAWA_DFA_HAI_WORKLIST_H_
+
+#include <elm/data/Vector.h>
+#include <elm/util/BitVector.h>
+#include <otawa/cfg/features.h>
+
+namespace otawa { namespace dfa { namespace hai {
+
+using namespace elm;
+
+class WorkList {
+
+	// pending blocks of a CFG by loop depth
+	class Queue {
+	public:
+		inline Queue(void): top(0), cnt(0) { }
+		inline ~Queue(void) { for(int i = 0; i < levels.length(); i++) delete levels[i]; }
+		inline bool isEmpty(void) const { return !cnt; }
+
+		inline void push(Block *b, int d) {
+			while(levels.length() <= d)
+				levels.add(new Vector<Block *>());
+			levels[d]->push(b);
+			if(d >= top)
+				top = d + 1;
+			cnt++;
+		}
+
+		inline Block *pop(void) {
+			ASSERT(cnt);
+			while(levels[top - 1]->isEmpty())
+				top--;
+			cnt--;
+			return levels[top - 1]->pop();
+		}
+
+	private:
+		Vector<Vector<Block *> *> levels;
+		int top, cnt;
+	};
+
+public:
+	inline WorkList(const CFGCollection *coll, bool ordered = true)
+		: in(coll->countBlocks()), depths(coll->countBlocks()), queues(new Queue[coll->count()]), cnt(0), _ordered(ordered)
+		{ for(int i = 0; i < coll->countBlocks(); i++) depths.add(-1); }
+	inline ~WorkList(void) { delete [] queues; }
+
+	inline bool isEmpty(void) const { return !cnt; }
+	inline int count(void) const { return cnt; }
+	inline bool contains(Block *b) const { return in.bit(b->id()); }
+	inline bool isOrdered(void) const { return _ordered; }
+
+	inline bool contains(CFG *g) const {
+		if(_ordered)
+			return !queues[g->index()].isEmpty();
+		for(int i = 0; i < stack.length(); i++)
+			if(stack[i]->cfg() == g)
+				return true;
+		return false;
+	}
+
+	inline void push(Block *b) {
+		if(in.bit(b->id()))
+			return;
+		in.set(b->id());
+		cnt++;
+		if(!_ordered) {
+			stack.push(b);
+			return;
+		}
+		Queue& q = queues[b->cfg()->index()];
+		if(q.isEmpty())
+			active.push(b->cfg()->index());
+		q.push(b, depth(b));
+	}
+
+	inline Block *pop(CFG *g = nullptr) {
+		ASSERT(cnt);
+		if(!_ordered)
+			return take(stack.length() - 1);
+		Queue *q = g ? &queues[g->index()] : nullptr;
+		if(!q || q->isEmpty()) {
+			while(queues[active.top()].isEmpty())
+				active.pop();
+			q = &queues[active.top()];
+		}
+		Block *b = q->pop();
+		in.clear(b->id());
+		cnt--;
+		return b;
+	}
+
+	inline Block *popFrom(CFG *g) {
+		if(_ordered)
+			return pop(g);
+		int i = stack.length() - 1;
+		while(stack[i]->cfg() != g)
+			i--;
+		return take(i);
+	}
+
+	inline void clear(void) {
+		while(cnt)
+			pop();
+		active.clear();
+	}
+
+private:
+
+	inline Block *take(int i) {
+		Block *b = stack[i];
+		stack.removeAt(i);
+		in.clear(b->id());
+		cnt--;
+		return b;
+	}
+
+	inline int depth(Block *b) {
+		int& d = depths[b->id()];
+		if(d < 0) {
+			d = 0;
+			for(LoopIter h(b); h(); h++)
+				d++;
+		}
+		return d;
+	}
+
+	BitVector in;
+	Vector<int> depths;
+	Queue *queues;
+	Vector<int> active;
+	int cnt;
+	bool _ordered;
+	Vector<Block *> stack;
+};
+
+} } }	// otawa::dfa::hai
+
+#endif /* OTAWA_DFA_HAI_WORKLIST_H_ */
@@ -29,6 +29,7 @@
 
 namespace otawa { namespace etime {
 
+class ConfigCache;
 class ConfigSet;
 class EdgeTimeBuilder;
 
@@ -48,18 +49,22 @@ private:
 
 class EdgeTimeBuilder: public GraphBBTime<EdgeTimeGraph> {
 	friend class EdgeTimeGraph;
+	friend class EdgeRunner;
 public:
 	static p::declare reg;
 	EdgeTimeBuilder(p::declare& r = reg);
+	virtual ~EdgeTimeBuilder(void);
 	typedef enum { IN_PREFIX = 0, IN_EDGE = 1, IN_BLOCK = 2, IN_SIZE = 3 } place_t;
 
 protected:
 	virtual void configure(const PropList& props);
 
 	// BBProcessor overload
+	virtual void processWorkSpace(WorkSpace *ws);
 	virtual void setup(WorkSpace *ws);
 	virtual void processBB(WorkSpace *ws, CFG *cfg, Block *bb);
 	virtual void cleanup(WorkSpace *ws);
+	virtual void collectStats(WorkSpace *ws);
 
 	// to customize
 	typedef Pair<Event *, place_t> event_t;
@@ -70,6 +75,7 @@ protected:
 	virtual void processSequence(void);
 	virtual void clean(ParExeGraph *graph);
 	void processTimes(const config_list_t& confs);
+	void generate(const config_list_t& confs);
 	void applyStrictSplit(const config_list_t& confs);
 	void applyFloppySplit(const config_list_t& confs);
 	void applyWeightedSplit(const config_list_t& confs);
@@ -82,6 +88,7 @@ protected:
 	inline Vector<Resource *> *ressources(void) { return &_hw_resources; }
 
 private:
+	class Job;
 
 	class EventComparator {
 	public:
@@ -95,6 +102,10 @@ private:
 
 	void apply(Event *event, ParExeInst *inst);
 	void rollback(Event *event, ParExeInst *inst);
+	void toggle(int i, bool on, const Vector<ParExeInst *>& insts);
+	bool isMonotonic(void);
+	static bool dominates(const Vector<t::uint32>& masks, t::uint32 mask, bool super);
+	ot::time evaluate(void);
 	EventCollector *get(Event *event);
 	void genForOneCost(ot::time cost, Edge *edge, event_list_t& events);
 	ParExeNode *getBranchNode(void);
@@ -102,6 +113,10 @@ private:
 	void sortEvents(event_list_t& events, BasicBlock *bb, place_t place, Edge *edge = 0);
 	void displayConfs(const Vector<ConfigSet>& confs, const event_list_t& events);
 	int countDynEvents(const event_list_t& events);
+	EdgeTimeBuilder *fork(void);
+	void processJob(Job *job);
+	void mergeJobs(bool gen);
+	string makeKey(void);
 
 	ParExeInst *findInst(Inst *i, ParExeInst *from);
 	ParExeNode *findNode(ParExeInst *i, const hard::PipelineUnit *unit);
@@ -123,6 +138,7 @@ private:
 	event_list_t events;
 	ParExeSequence *seq;
 	EdgeTimeGraph *graph;
+	bool incremental;
 	ParExeNode *bnode;
 	ParExeEdge *bedge;
 	BasicBlock *source, *target;
@@ -134,6 +150,18 @@ private:
 	// configuration
 	bool record;
 	t::uint32 event_mask;
+
+	// parallel mode
+	bool par;
+	Vector<Job *> jobs;
+	Job *job;
+
+	// configuration cache
+	bool use_memo;
+	sys::Path memo_path;
+	ConfigCache *memo;
+	string memo_key;
+	bool forked;
 };
 
 } }	// otawa::etime
@@ -23,6 +23,7 @@
 
 #include <elm/data/List.h>
 #include <elm/data/Vector.h>
+#include <elm/sys/Path.h>
 #include <otawa/cfg/CFG.h>
 #include <otawa/events/features.h>
 #include <otawa/proc/Feature.h>
@@ -125,6 +126,9 @@ extern p::alias<Event *> PREFIX_EVENT;
 extern p::id<bool> PREDUMP;
 extern p::id<int> EVENT_THRESHOLD;
 extern p::id<bool> RECORD_TIME;
+extern p::id<bool> PARALLEL;
+extern p::id<bool> CONFIG_CACHE;
+extern p::id<sys::Path> CONFIG_CACHE_PATH;
 extern p::feature EDGE_TIME_FEATURE;
 extern p::id<ot::time> LTS_TIME;
 extern p::id<Pair<ot::time, ilp::Var *> > HTS_CONFIG;
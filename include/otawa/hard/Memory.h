@@ -22,9 +22,11 @@
 #ifndef OTAWA_HARD_MEMORY_H
 #define OTAWA_HARD_MEMORY_H
 
+#include <atomic>
 #include <elm/assert.h>
 #include <elm/data/HashMap.h>
 #include <elm/data/Array.h>
+#include <elm/data/Vector.h>
 #include <elm/string.h>
 #include <elm/serial2/collections.h>
 #include <elm/serial2/macros.h>
@@ -203,6 +205,10 @@ public:
 	ot::time writeTime(Address a) const;
 	ot::time accessTime(Address a) const;
 
+	// lookup statistics
+	inline t::uint64 lookups(void) const { return _lookups.load(std::memory_order_relaxed); }
+	inline t::uint64 hits(void) const { return _hits.load(std::memory_order_relaxed); }
+
 	// deprecated
 	inline ot::time worstAccess(void) const { return worstAccessTime(); }
 	inline ot::time worstReadAccess(void) const { return worstReadTime(); }
@@ -213,6 +219,10 @@ private:
 	AllocArray<const Bus *> _buses;
 	mutable ot::time _waccess, _wread, _wwrite;
 	mutable ot::time _baccess, _bread, _bwrite;
+
+	void buildIndex(void);
+	Vector<const Bank *> _index;
+	mutable std::atomic<t::uint64> _lookups, _hits;
 };
 
 // features
@@ -0,0 +1,134 @@
+/*
+ *	icache::SetProjector and icache::SetProjectedGraph classes interface
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_ICACHE_SETPROJECTEDGRAPH_H_
+#define OTAWA_ICACHE_SETPROJECTEDGRAPH_H_
+
+#include <elm/data/Vector.h>
+#include <elm/util/AllocArray.h>
+#include <otawa/cfg/features.h>
+#include <otawa/hard/Cache.h>
+#include "features.h"
+
+namespace otawa { namespace icache {
+
+using namespace elm;
+
+class SetProjector {
+	friend class SetProjectedGraph;
+public:
+	SetProjector(const CFGCollection& coll);
+
+	inline const CFGCollection& collection(void) const { return _coll; }
+	inline Block *entry(void) const { return _coll.entry()->entry(); }
+	inline Block *exit(void) const { return _coll.entry()->exit(); }
+	inline int count(void) const { return _blocks.count(); }
+	inline bool isReached(Block *v) const { return _reached[v->id()]; }
+	bool isCall(Edge *e) const;
+	bool isReturn(Edge *e) const;
+
+private:
+	typedef struct arc_t {
+		Edge *edge;
+		Block *sink;
+		bool structural;
+	} arc_t;
+
+	const CFGCollection& _coll;
+	AllocArray<Block *> _blocks;
+	AllocArray<bool> _reached;
+	AllocArray<int> _start;
+	AllocArray<arc_t> _arcs;
+};
+
+class SetProjectedGraph {
+public:
+
+	class Link {
+		friend class SetProjectedGraph;
+	public:
+		inline Block *source(void) const { return _source; }
+		inline Edge *edge(void) const { return _edge; }
+		inline Block *target(void) const { return _target; }
+		inline Block *sink(void) const { return _sink; }
+	private:
+		Block *_source, *_target, *_sink;
+		Edge *_edge;
+	};
+
+	typedef Block *vertex_t;
+	typedef const Link *edge_t;
+
+	SetProjectedGraph(const SetProjector& proj, const hard::Cache& cache, int set, bool persistence = true);
+
+	inline vertex_t entry(void) const { return _proj.entry(); }
+	inline vertex_t exit(void) const { return _proj.exit(); }
+	inline vertex_t sinkOf(edge_t e) const { return e->sink(); }
+	inline vertex_t sourceOf(edge_t e) const { return e->source(); }
+	inline bool isCall(edge_t e) const { return _proj.isCall(e->edge()); }
+	inline bool isReturn(edge_t e) const { return _proj.isReturn(e->edge()); }
+	inline bool isRelevant(vertex_t v) const { return _index[v->id()] >= 0; }
+	inline int countLinks(void) const { return _out.count(); }
+
+	class Iter: public PreIterator<Iter, edge_t> {
+	public:
+		inline Iter(const SetProjectedGraph& g, const AllocArray<int>& s, const AllocArray<int>& l, int i)
+			: _g(g), _l(l), _i(s[i]), _e(s[i + 1]) { }
+		inline bool ended(void) const { return _i >= _e; }
+		inline edge_t item(void) const { return &_g._links[_l[_i]]; }
+		inline void next(void) { _i++; }
+	private:
+		const SetProjectedGraph& _g;
+		const AllocArray<int>& _l;
+		int _i, _e;
+	};
+
+	class Successor: public Iter {
+	public:
+		inline Successor(const SetProjectedGraph& g, vertex_t v): Iter(g, g._out_start, g._out, g._index[v->id()]) { }
+	};
+	inline Successor succs(vertex_t v) const { return Successor(*this, v); }
+
+	class Predecessor: public Iter {
+	public:
+		inline Predecessor(const SetProjectedGraph& g, vertex_t v): Iter(g, g._in_start, g._in, v->id()) { }
+	};
+	inline Predecessor preds(vertex_t v) const { return Predecessor(*this, v); }
+
+	// Indexed concept
+	inline int index(vertex_t v) const { return _index[v->id()]; }
+	inline int count(void) const { return _vertices.length(); }
+
+private:
+	bool accesses(const Bag<Access>& accs) const;
+
+	const SetProjector& _proj;
+	const hard::Cache& _cache;
+	int _set;
+	AllocArray<int> _index;
+	Vector<Block *> _vertices;
+	Vector<Link> _links;
+	AllocArray<int> _in_start, _out_start, _in, _out;
+};
+
+} }	// otawa::icache
+
+#endif /* OTAWA_ICACHE_SETPROJECTEDGRAPH_H_ */
@@ -158,6 +158,7 @@ private:
 extern p::id<Container<ACS> > MUST_INIT;
 extern p::id<Container<ACS> > PERS_INIT;
 extern p::id<Container<ACS> > MAY_INIT;
+extern p::id<bool> PARALLEL;
 extern p::feature MUST_PERS_ANALYSIS_FEATURE;
 extern p::feature MAY_ANALYSIS_FEATURE;
 extern p::id<Container<ACS> > MUST_IN;
@@ -0,0 +1,67 @@
+/*
+ *	ilp::PresolvedSystem class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ILP_PRESOLVEDSYSTEM_H_
+#define OTAWA_ILP_PRESOLVEDSYSTEM_H_
+
+#include <elm/data/HashMap.h>
+#include <otawa/ilp/AbstractSystem.h>
+
+namespace otawa {
+
+class Manager;
+
+namespace ilp {
+
+using namespace elm;
+
+class PresolvedSystem: public AbstractSystem {
+public:
+	PresolvedSystem(Manager *manager, const string& plugin = "", bool max = true);
+	~PresolvedSystem(void);
+
+	bool solve(WorkSpace *ws) override;
+	bool solve(WorkSpace *ws, otawa::Monitor& mon) override;
+	double valueOf(Var *var) override;
+	double value(void) override;
+	string lastErrorMessage(void) override;
+	ILPPlugin *plugin(void) override;
+
+	inline System *reduced(void) const { return _sys; }
+	inline int countFixed(void) const { return _fixed; }
+	inline int countSubstituted(void) const { return _subst; }
+	inline int countRemoved(void) const { return _removed; }
+	inline int countBounds(void) const { return _bounds; }
+
+private:
+	void clear(void);
+
+	Manager *_man;
+	string _plugin;
+	System *_sys;
+	double _value;
+	HashMap<Var *, double> _values;
+	string _msg;
+	int _fixed, _subst, _removed, _bounds;
+};
+
+} }		// otawa::ilp
+
+#endif /* OTAWA_ILP_PRESOLVEDSYSTEM_H_ */
@@ -17,6 +17,7 @@ namespace otawa {
 using namespace elm;
 
 // Externals
+class VirtualContext;
 namespace ilp {
 	class System;
 } // ilp
@@ -46,8 +47,10 @@ private:
 	void transferConflict(Inst *source, /*BasicBlock*/Block *bb, const ContextualPath& path, bool intoLoop);//MDM
 	
 	DomInfo *dom;
+	VirtualContext *vctx;
 
 	bool scan(Block *v, Block *t, const ContextualPath& path);
+	void scanContexts(CFG *cfg, Block *h, const ContextualPath& path);
 	bool transfer(Inst *source, Block *bb, const ContextualPath& path);
 	bool lookLineAt(Inst *source, Block *bb, const ContextualPath& path);
 };
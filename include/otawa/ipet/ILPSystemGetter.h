@@ -47,6 +47,8 @@ protected:
 	void destroy(WorkSpace *ws) override;
 private:
 	bool max;
+	bool network;
+	bool presolve;
 };
 
 } } // otawa::ipet
@@ -0,0 +1,67 @@
+/*
+ *	NetworkSystem class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_IPET_NETWORKSYSTEM_H_
+#define OTAWA_IPET_NETWORKSYSTEM_H_
+
+#include <elm/data/HashMap.h>
+#include <otawa/ilp/AbstractSystem.h>
+
+namespace otawa {
+
+class Manager;
+
+namespace ipet {
+
+using namespace elm;
+
+class NetworkSystem: public ilp::AbstractSystem {
+public:
+	NetworkSystem(Manager *manager, const string& plugin = "", bool max = true, bool presolve = false);
+	~NetworkSystem(void);
+
+	bool solve(WorkSpace *ws) override;
+	bool solve(WorkSpace *ws, otawa::Monitor& mon) override;
+	double valueOf(ilp::Var *var) override;
+	double value(void) override;
+	string lastErrorMessage(void) override;
+	ilp::ILPPlugin *plugin(void) override;
+
+	inline bool isNative(void) const { return _native; }
+	inline ilp::System *fallback(void) const { return _fallback; }
+
+private:
+	bool solveNative(WorkSpace *ws, string& reason);
+	bool solveFallback(WorkSpace *ws, otawa::Monitor& mon);
+	void clear(void);
+
+	Manager *_man;
+	string _plugin;
+	bool _native, _presolve;
+	double _value;
+	HashMap<ilp::Var *, double> _values;
+	ilp::System *_fallback;
+	HashMap<ilp::Var *, ilp::Var *> _map;
+	string _msg;
+};
+
+} }		// otawa::ipet
+
+#endif /* OTAWA_IPET_NETWORKSYSTEM_H_ */
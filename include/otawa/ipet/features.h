@@ -72,6 +72,8 @@ extern p::feature FLOW_FACTS_CONFLICT_CONSTRAINTS_FEATURE;  // conflict MDM
 extern p::feature FLOW_FACTS_FEATURE;
 
 extern p::id<bool> MAXIMIZE;
+extern p::id<bool> NETWORK_SOLVER;
+extern p::id<bool> PRESOLVE;
 extern p::feature ILP_SYSTEM_FEATURE;
 extern Identifier<ilp::System *> SYSTEM;
 
@@ -140,7 +140,6 @@ namespace otawa {
     template <class G>
 		class GraphBBTime: public BBProcessor {
     private:
-		WorkSpace *_ws;
 		PropList _props;
 		int _prologue_depth;
 		OutStream *_output_stream;
@@ -148,6 +147,7 @@ namespace otawa {
 		String _graphs_dir_name;
 
     protected:
+		WorkSpace *_ws;
 		bool _do_output_graphs;
 		bool _do_consider_icache;
 		const hard::Memory *mem;
@@ -161,6 +161,8 @@ namespace otawa {
 		virtual void buildFMTimingContextListForICache(List<TimingContext *> *list, ParExeSequence *seq);
 		virtual void computeDefaultTimingContextForICache(TimingContext *dtctxt, ParExeSequence *seq);
 		virtual void BuildVectorOfHwResources();
+		void prepareProcessor(WorkSpace *ws);
+		void releaseProcessor(void);
 		virtual void configureMem(WorkSpace *ws) {
 			if(ws->isProvided(hard::CACHE_CONFIGURATION_FEATURE))
 				icache = hard::CACHE_CONFIGURATION_FEATURE.get(ws)->instCache();
@@ -264,6 +266,21 @@ void GraphBBTime<G>::configure(const PropList& props) {
 	template <class G>  
 		void GraphBBTime<G>::processWorkSpace(WorkSpace *ws) {
 
+		prepareProcessor(ws);
+
+		// Perform the actual process
+		BBProcessor::processWorkSpace(ws);
+	}
+
+	// -- prepareProcessor ------------------------------------------------------------------------------------------
+
+	/**
+	 * Build the micro-processor description, the hardware resources and
+	 * the memory configuration used to build the execution graphs.
+	 * @param ws	Current workspace.
+	 */
+	template <class G>
+		void GraphBBTime<G>::prepareProcessor(WorkSpace *ws) {
 		_ws = ws;
 		const hard::Processor *proc = hard::PROCESSOR_FEATURE.get(_ws);
 		if(proc == &hard::Processor::null)
@@ -271,9 +288,19 @@ void GraphBBTime<G>::configure(const PropList& props) {
 		_microprocessor = new ParExeProc(proc);
 		BuildVectorOfHwResources();															// ===== TO BE ENABLED
 		configureMem(_ws);
+	}
 
-		// Perform the actual process
-		BBProcessor::processWorkSpace(ws);
+	/**
+	 * Release the micro-processor description and the hardware resources
+	 * built by prepareProcessor().
+	 */
+	template <class G>
+		void GraphBBTime<G>::releaseProcessor(void) {
+		for(int i = 0; i < _hw_resources.length(); i++)
+			delete _hw_resources[i];
+		_hw_resources.clear();
+		delete _microprocessor;
+		_microprocessor = nullptr;
 	}
 
 	// -- Build vector of pipeline-related resources -----------------------------------------------------------
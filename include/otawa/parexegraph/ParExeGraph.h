@@ -248,6 +248,15 @@ namespace otawa {
 		int _capacity;																										// ====== REALLY USEFUL? (used in analyze())
 		bool _explicit;
 
+		// incremental analysis (see reanalyze())
+		Vector<ParExeNode *> _order;								// topological order of the last analyze()
+		Vector<int> _rank;											// rank in _order by node index (-1 if not ordered)
+		Vector<int> _init_delays;									// initial delays by rank and resource
+		BitVector _stale;											// nodes to re-propagate by rank
+		int _first_stale;											// lowest stale rank
+		void recordOrder(void);
+		int computeCost(void);
+
 
 		inline string comment(string com)
 			{ if(_explicit) return com; else return ""; }
@@ -287,6 +296,8 @@ namespace otawa {
 		void createSequenceResources();
 		RegResource *newRegResource(const hard::Register *r);
 		int analyze();
+		int reanalyze();
+		void invalidate(ParExeNode *node);
 		virtual void initDelays();
 		void clearDelays();
 		void restoreDefaultLatencies();
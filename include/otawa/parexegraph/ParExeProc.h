@@ -94,6 +94,7 @@ namespace otawa {
     Vector<ParExeNode *> _nodes;
   public:
     inline ParExeStage(pipeline_stage_category_t category, int latency, int width, order_t policy, ParExeQueue *sq, ParExeQueue *dq, elm::String name, int index=0, const hard::PipelineUnit *unit = 0);
+    ~ParExeStage(void);
 
 	inline void addNode(ParExeNode * node)
 		{ _nodes.add(node); }
@@ -148,7 +149,7 @@ namespace otawa {
   class ParExePipeline { 
   	public:
     ParExePipeline()  : _first_stage(nullptr), _last_stage(nullptr) {}
-    ~ParExePipeline() {    }
+    ~ParExePipeline();
     inline ParExeStage *lastStage() {return _last_stage;}
     inline ParExeStage *firstStage() {return _first_stage; }
     inline void addStage(ParExeStage *stage);
@@ -199,6 +200,7 @@ namespace otawa {
 	  } instruction_category_t;
 
 	  ParExeProc(const hard::Processor *proc);
+	  ~ParExeProc(void);
 	  inline const hard::Processor *processor(void) const { return _proc; }
 	  inline void addQueue(elm::String name, int size){_queues.add(new ParExeQueue(name, size));}
 	  inline ParExeQueue * queue(int index) {return _queues[index];}
@@ -23,21 +23,15 @@
 
 #include "CFGProcessor.h"
 
-#include <elm/sys/Thread.h>
 #include <otawa/cfg/features.h>
 
 namespace otawa {
 
 class ConcurrentCFGProcessor: public CFGProcessor {
-	friend class CFGRunnable;
 public:
 	ConcurrentCFGProcessor(p::declare& r);
 protected:
-	virtual void processWorkSpace(WorkSpace *ws);
-private:
-	void nextCFG(void);
-	sys::Mutex *mutex;
-	CFGCollection::Iter it;
+	void processAll(WorkSpace *ws) override;
 };
 
 }	// otawa
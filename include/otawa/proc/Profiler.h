@@ -0,0 +1,77 @@
+/*
+ *	Profiler class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_PROC_PROFILER_H_
+#define OTAWA_PROC_PROFILER_H_
+
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <otawa/prop/Identifier.h>
+
+namespace otawa {
+
+using namespace elm;
+
+class AbstractFeature;
+class Processor;
+
+class Profiler {
+public:
+
+	class Record {
+	public:
+		string name;
+		string chain;
+		int depth;
+		t::uint64 start, wall, self, cpu;
+		t::int64 rss, props, live;
+	};
+
+	Profiler(void);
+	~Profiler(void);
+
+	void start(const AbstractFeature& feature);
+	void stop(const AbstractFeature& feature);
+	void enter(const Processor& proc);
+	void leave(const Processor& proc);
+
+	inline const Vector<Record *>& records(void) const { return recs; }
+	void printTrace(io::Output& out) const;
+	void printSummary(io::Output& out) const;
+
+private:
+	typedef struct frame_t {
+		const Processor *proc;
+		Record *rec;
+		t::uint64 cpu, child;
+		t::int64 rss, added, disposed;
+	} frame_t;
+
+	t::uint64 base;
+	Vector<const AbstractFeature *> feats;
+	Vector<frame_t> stack;
+	Vector<Record *> recs;
+};
+
+extern p::id<Profiler *> PROFILER;
+
+}	// otawa
+
+#endif /* OTAWA_PROC_PROFILER_H_ */
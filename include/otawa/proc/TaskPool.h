@@ -0,0 +1,86 @@
+/*
+ *	TaskPool class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_PROC_TASKPOOL_H_
+#define OTAWA_PROC_TASKPOOL_H_
+
+#include <atomic>
+#include <type_traits>
+#include <elm/data/Vector.h>
+#include <otawa/prop/Identifier.h>
+
+namespace otawa {
+
+using namespace elm;
+
+class TaskQueue;
+class TaskState;
+class TaskWorker;
+
+class TaskPool {
+	friend class TaskWorker;
+public:
+
+	class Task {
+		friend class TaskPool;
+	public:
+		inline Task(void): _scope(nullptr) { }
+		virtual ~Task(void);
+		virtual void run(void) = 0;
+	private:
+		std::atomic<int> *_scope;
+	};
+
+	TaskPool(int count = 0);
+	~TaskPool(void);
+	inline int count(void) const { return _count; }
+
+	void spawn(Task *task);
+	template <class F, class = typename std::enable_if<!std::is_convertible<F, Task *>::value>::type>
+		inline void spawn(const F& f) { spawn(static_cast<Task *>(new FunTask<F>(f))); }
+	void wait(void);
+
+	template <class C, class F> void forEach(const C& coll, const F& f)
+		{ for(auto x: coll) spawn([f, x]() { f(x); }); wait(); }
+
+private:
+	template <class F> class FunTask: public Task {
+	public:
+		inline FunTask(const F& f): _f(f) { }
+		void run(void) override { _f(); }
+	private:
+		F _f;
+	};
+
+	Task *take(int i);
+	bool execute(int i);
+	void join(int i);
+
+	int _count;
+	Vector<TaskQueue *> queues;
+	Vector<TaskWorker *> workers;
+	TaskState *state;
+};
+
+extern p::id<int> THREAD_COUNT;
+
+}	// otawa
+
+#endif /* OTAWA_PROC_TASKPOOL_H_ */
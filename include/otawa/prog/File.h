@@ -34,6 +34,7 @@ namespace otawa {
 
 // Defined classes
 class ProgItem;
+class Process;
 
 // File class
 class File: public PropList {
@@ -41,7 +42,7 @@ class File: public PropList {
 public:
 	static rtti::Type& __type;
 
-	inline File(String name): _name(name) { }
+	inline File(String name): _name(name), _proc(nullptr) { }
 	inline CString name(void) { return _name.toCString(); }
 	Inst *findInstAt(address_t address);
 	ProgItem *findItemAt(address_t address);
@@ -49,7 +50,7 @@ public:
 	inline const syms_t& symbols(void) const { return syms; }
 
 	// Segment management
-	inline void addSegment(Segment *seg) { segs.add(seg); }
+	void addSegment(Segment *seg);
 	Segment *findSegmentAt(Address addr);
 	class SegIter: public Vector<Segment *>::Iter {
 	public:
@@ -74,6 +75,7 @@ protected:
 
 private:
 	String _name;
+	Process *_proc;
 	Vector<Segment *> segs;
 	syms_t syms;
 };
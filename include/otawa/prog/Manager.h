@@ -117,6 +117,7 @@ extern p::id<elm::string> SIMULATOR_NAME;
 extern p::id<int> PIPELINE_DEPTH;
 extern p::id<bool> NO_SYSTEM;
 extern p::id<bool> NO_STACK;
+extern p::id<bool> PREDECODE;
 extern p::id<string> NO_RETURN_FUNCTION;
 
 extern p::id<elm::sys::Path> CONFIG_PATH;
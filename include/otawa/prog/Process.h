@@ -22,6 +22,7 @@
 #ifndef OTAWA_PROGRAM_PROCESS_H
 #define OTAWA_PROGRAM_PROCESS_H
 
+#include <atomic>
 #include <elm/data/List.h>
 #include <elm/data/Vector.h>
 #include <elm/stree/Tree.h>
@@ -50,6 +51,8 @@ class Loader;
 class Manager;
 class Processor;
 class Process;
+class SegmentIndex;
+class TaskPool;
 namespace sem { class Block; }
 namespace sim { class Simulator; }
 class Symbol;
@@ -156,6 +159,10 @@ public:
 	virtual void deleteNop(Inst *inst);
 	virtual int maxTemp(void) const;
 	Segment *findSegmentAt(Address addr) const;
+	inline t::uint64 segmentLookups(void) const { return seg_lookups.load(std::memory_order_relaxed); }
+	inline t::uint64 segmentHits(void) const { return seg_hits.load(std::memory_order_relaxed); }
+	void predecode(TaskPool& pool);
+	virtual bool isDecodingReentrant(void) const;
 
 	// Memory access
 	virtual void get(Address at, t::int8& val);
@@ -197,15 +204,22 @@ public:
 
 protected:
 	friend class WorkSpace;
+	friend class File;
 	void addFile(File *file);
 	void provide(AbstractFeature& feature);
 
 private:
+	const SegmentIndex *segmentIndex(void) const;
+	void invalidateSegments(void);
+
 	Vector<File *> _files;
 	List<AbstractFeature *> provided;
 	File *prog;
 	Manager *man;
 	stree::Tree<Address::offset_t, Symbol *> *smap;
+	mutable std::atomic<SegmentIndex *> seg_index;
+	mutable std::atomic<bool> seg_stale;
+	mutable std::atomic<t::uint64> seg_lookups, seg_hits;
 };
 
 
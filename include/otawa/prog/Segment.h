@@ -35,6 +35,7 @@ using namespace elm;
 class ProgItem;
 class CodeItem;
 class Data;
+class TaskPool;
 
 // Segment class
 class Segment: public PropList {
@@ -62,6 +63,10 @@ public:
 	Inst *findInstAt(const Address& addr);
 	inline bool contains(const Address& addr) const { return address() <= addr && addr < topAddress(); }
 
+	// pre-decoding
+	void predecode(int inst_size, TaskPool *pool = nullptr);
+	inline bool isPredecoded(void) const { return _insts != nullptr; }
+
 	// ItemIter class	
 	class ItemIter: public PreIterator<ItemIter, ProgItem *> {
 	public:
@@ -94,12 +99,24 @@ protected:
 	void insert(ProgItem *item);
 
 private:
+	Inst *decodeSafe(address_t address);
+	Inst *link(Inst *inst);
+	Inst *lookup(const Address& addr) const;
+	int lookupIndex(const Address& addr) const;
+	ProgItem *itemAfter(const Address& addr);
+	ProgItem *itemBefore(ProgItem *next);
+	void dropConflicts(Inst *inst);
+	void unlink(ProgItem *item);
+
 	flags_t _flags;
 	CString _name;
 	Address _address;
 	ot::size _size;
-	inhstruct::DLList _items;
+	inhstruct::DLList _items, _dropped;
 	ProgItem **map;
+	Inst **_insts;
+	t::uint32 *_offs;
+	int _icnt, _isize;
 };
 
 };	// namespace otawa
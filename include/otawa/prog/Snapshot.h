@@ -0,0 +1,91 @@
+/*
+ *	SnapshotSaver and SnapshotLoader classes interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_PROG_SNAPSHOT_H_
+#define OTAWA_PROG_SNAPSHOT_H_
+
+#include <elm/sys/Path.h>
+#include <otawa/cfg/features.h>
+#include <otawa/proc/Processor.h>
+
+namespace otawa {
+
+using namespace elm;
+
+class SnapshotSerializer {
+public:
+	SnapshotSerializer(const AbstractIdentifier& id);
+	virtual ~SnapshotSerializer();
+	inline const AbstractIdentifier& identifier() const { return _id; }
+	virtual void save(io::Output& out, const Property *prop) const = 0;
+	virtual bool load(cstring text, PropList& props) const = 0;
+	static const SnapshotSerializer *find(const AbstractIdentifier *id);
+private:
+	const AbstractIdentifier& _id;
+};
+
+class SnapshotSaver: public Processor {
+public:
+	static p::declare reg;
+	SnapshotSaver(p::declare& r = reg);
+
+protected:
+	void configure(const PropList& props) override;
+	void processWorkSpace(WorkSpace *ws) override;
+
+private:
+	sys::Path path;
+	Vector<const AbstractIdentifier *> ids;
+	Vector<const AbstractFeature *> feats;
+};
+
+class SnapshotLoader: public Processor {
+public:
+	static p::declare reg;
+	SnapshotLoader(p::declare& r = reg);
+
+	static bool matches(WorkSpace *ws, const sys::Path& path, Address entry = Address::null,
+		const PropList& props = PropList::EMPTY);
+	void *interfaceFor(const AbstractFeature &feature) override;
+
+protected:
+	void configure(const PropList& props) override;
+	void processWorkSpace(WorkSpace *ws) override;
+	void cleanup(WorkSpace *ws) override;
+	void destroy(WorkSpace *ws) override;
+
+private:
+	sys::Path path;
+	Vector<t::uint8> buf;
+	CFGCollection *coll;
+	Vector<const AbstractIdentifier *> ws_ids;
+};
+
+// configuration
+extern p::id<sys::Path> SNAPSHOT_PATH;
+extern p::id<cstring> SNAPSHOT_INCLUDE;
+extern p::id<cstring> SNAPSHOT_PROVIDE;
+
+// feature
+extern p::feature SNAPSHOT_RESTORED_FEATURE;
+
+}	// otawa
+
+#endif /* OTAWA_PROG_SNAPSHOT_H_ */
@@ -55,6 +55,7 @@ class Loader;
 class Manager;
 class Process;
 class Processor;
+class TaskPool;
 namespace hard {
 	class CacheConfiguration;
 	class Platform;
@@ -122,6 +123,8 @@ public:
 	static sys::Thread *run(sys::Runnable& run);
 	static void runAll(sys::Runnable& run);
 	static void remove(Property *prop);
+	static void quiesce(void);
+	TaskPool& pool(void);
 
 	// deprecated
 	ast::ASTInfo *getASTInfo(void);
@@ -151,6 +154,7 @@ private:
 	bool cancelled;
 	string _name;
 	sys::Path wdir;
+	TaskPool *_pool;
 };
 
 };	// otawa
@@ -32,6 +32,7 @@ namespace otawa {
 
 // pre-declaration
 class AbstractIdentifier;
+class PropIndex;
 class Type;
 
 
@@ -66,12 +67,13 @@ private:
 // PropList class
 class PropList {
 	mutable Property *head;
+	static const AbstractIdentifier& INDEX;
 public:
 	static rtti::Type& __type;
 	static const PropList EMPTY;
 	inline PropList(const PropList& props): head(0) { addProps(props); };
 	inline PropList(void): head(0) { };
-	inline ~PropList(void) { clearProps(); };
+	inline ~PropList(void) { clear(false); };
 
 	// Property access
 	Property *getProp(const AbstractIdentifier *id) const;
@@ -87,10 +89,16 @@ public:
 		{ return getProp(&id) != 0; }
 
 	// Global management
+	static void startCounting(void);
+	static void stopCounting(void);
+	static t::uint64 countAdded(void);
+	static t::uint64 countDisposed(void);
 	void clearProps(void);
 	void addProps(const PropList& props);
 	void takeProps(PropList& props);
 	void print(elm::io::Output& out) const;
+	void setIndexed(bool indexed);
+	inline bool isIndexed(void) const { return head != 0 && head->id() == &INDEX; }
 	inline PropList& operator=(const PropList& props)
 		{ clearProps(); addProps(props); return *this; }
 
@@ -98,8 +106,8 @@ public:
 	class Iter: public elm::PreIterator<Iter, Property *> {
 	public:
 		inline Iter(void): prop(nullptr) { }
-		inline Iter(const PropList& list): prop(list.head) { }
-		inline Iter(const PropList *list): prop(list->head) { }
+		inline Iter(const PropList& list): prop(list.first()) { }
+		inline Iter(const PropList *list): prop(list->first()) { }
 		inline void next(void) { ASSERT(prop); prop = prop->next(); }
 		inline bool ended(void) const { return prop == 0; }
 		inline Property *item(void) const { ASSERT(prop); return prop; }
@@ -160,6 +168,11 @@ public:
 	};
 	inline GetterRange all(const AbstractIdentifier& id) const { return GetterRange(id, *this); }
 
+private:
+	inline Property *first(void) const { return isIndexed() ? head->_next : head; }
+	inline PropIndex *index(void) const;
+	void clear(bool keep_index);
+	void reindex(const AbstractIdentifier *id, Property *from);
 };
 
 
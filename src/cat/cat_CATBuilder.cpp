@@ -93,7 +93,7 @@ void CATBuilder::processLBlockSet(WorkSpace *fw, cache::LBlockSet *lbset) {
 	const CFGCollection *coll = INVOLVED_CFGS(fw);
 	dfa::XCFGVisitor<CATProblem> visitor(*coll, prob);
 	dfa::XIterativeDFA<dfa::XCFGVisitor<CATProblem> > engine(visitor);
-	engine.process();
+	engine.processWorklist();
 
 	// Assign ACS to BB
 	for (CFGCollection::Iter cfg(coll); cfg; cfg++) {
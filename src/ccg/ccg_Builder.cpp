@@ -167,7 +167,7 @@ void Builder::processLBlockSet(WorkSpace *fw, otawa::ccg::LBlockSet *lbset) {
 	const CFGCollection *coll = INVOLVED_CFGS(fw);
 	dfa::XCFGVisitor<Problem> visitor(*coll, prob);
 	dfa::XIterativeDFA<dfa::XCFGVisitor<Problem> > engine(visitor);
-	engine.process();
+	engine.processWorklist();
 
 	// Add the annotations from the DFA result
 	for (CFGCollection::Iter cfg(coll); cfg; cfg++) {
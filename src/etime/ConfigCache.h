@@ -0,0 +1,215 @@
+/*
+ *	ConfigCache class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2014, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+#ifndef OTAWA_ETIME_CONFIGCACHE_H_
+#define OTAWA_ETIME_CONFIGCACHE_H_
+
+#include <elm/data/HashMap.h>
+#include <elm/io/InFileStream.h>
+#include <elm/io/OutFileStream.h>
+#include <elm/sys/Thread.h>
+#include <otawa/cfg/Block.h>
+#include <otawa/etime/Config.h>
+
+namespace otawa { namespace etime {
+
+/**
+ * Cache of the configuration sets computed by EdgeTimeBuilder indexed
+ * by a key describing the instruction sequence and its events
+ * (see EdgeTimeBuilder::makeKey()). The cache may be shared by several
+ * threads and may be saved to and loaded from a file.
+ *
+ * The file starts with a header made of a magic word, the format version,
+ * a byte order marker, the name of the builder (the configuration times
+ * depend on the EdgeTimeBuilder subclass), the signature of the hardware
+ * configuration (see hard::signature()) and the checksum of the program.
+ * A file whose header does not match the current format, byte order, builder,
+ * hardware and program is rejected. The header is followed by the entries, each one
+ * encoded as the key (length and characters), the number of configuration
+ * sets and, for each set, its time, its number of configurations and
+ * the configuration bits.
+ */
+class ConfigCache {
+public:
+	typedef Vector<ConfigSet> config_list_t;
+
+	ConfigCache(const string& builder = "", t::uint32 hard_sig = 0, t::uint32 prog_sum = 0)
+		: _builder(builder), _hard_sig(hard_sig), _prog_sum(prog_sum), _hits(0), _misses(0), _mutex(sys::Mutex::make()) { }
+	~ConfigCache(void) { delete _mutex; }
+
+	inline int hits(void) const { return _hits; }
+	inline int misses(void) const { return _misses; }
+	inline const HashMap<Block *, int>& blockHits(void) const { return _bhits; }
+	inline const HashMap<Block *, int>& blockMisses(void) const { return _bmisses; }
+
+	/**
+	 * Look for the configurations of the given key.
+	 * @param key		Looked key.
+	 * @param confs		Filled with the found configurations.
+	 * @param b			Block the lookup is performed for (for statistics).
+	 * @return			True if the key is found, false else.
+	 */
+	bool get(const string& key, config_list_t& confs, Block *b) {
+		_mutex->lock();
+		bool found = _map.hasKey(key);
+		if(found) {
+			confs = _map.get(key, confs);
+			_hits++;
+			_bhits.put(b, _bhits.get(b, 0) + 1);
+		}
+		else {
+			_misses++;
+			_bmisses.put(b, _bmisses.get(b, 0) + 1);
+		}
+		_mutex->unlock();
+		return found;
+	}
+
+	/**
+	 * Record the configurations for the given key.
+	 * @param key	Key of the configurations.
+	 * @param confs	Configurations to record.
+	 */
+	void put(const string& key, const config_list_t& confs) {
+		_mutex->lock();
+		_map.put(key, confs);
+		_mutex->unlock();
+	}
+
+	/**
+	 * Load the cache content from the given file.
+	 * @param path	Path of the file.
+	 * @return		True if the file has been loaded, false if it cannot be read,
+	 * 				is not a cache file, is corrupted or has been built for another format
+	 * 				version, byte order, builder, hardware configuration or program.
+	 */
+	bool load(const sys::Path& path) {
+		io::InFileStream in(path);
+		if(!in.isReady())
+			return false;
+		t::uint32 magic, version, order, hard_sig, prog_sum;
+		if(!read(in, magic) || magic != MAGIC
+		|| !read(in, version) || version != VERSION
+		|| !read(in, order) || order != ORDER_MARK)
+			return false;
+		string builder;
+		if(!read(in, builder) || builder != _builder
+		|| !read(in, hard_sig) || hard_sig != _hard_sig
+		|| !read(in, prog_sum) || prog_sum != _prog_sum)
+			return false;
+		while(true) {
+			string key;
+			t::uint32 len;
+			if(!read(in, len))
+				break;
+			if(!read(in, key, len))
+				return false;
+			t::uint32 n;
+			if(!read(in, n))
+				return false;
+			config_list_t confs;
+			for(t::uint32 i = 0; i < n; i++) {
+				ot::time time;
+				t::uint32 cnt;
+				if(!read(in, time) || !read(in, cnt))
+					return false;
+				ConfigSet set(time);
+				for(t::uint32 j = 0; j < cnt; j++) {
+					t::uint32 bits;
+					if(!read(in, bits))
+						return false;
+					set.add(Config(bits));
+				}
+				confs.add(set);
+			}
+			_map.put(key, confs);
+		}
+		return true;
+	}
+
+	/**
+	 * Save the cache content to the given file.
+	 * @param path	Path of the file.
+	 * @return		True if the file has been written, false else.
+	 */
+	bool save(const sys::Path& path) {
+		io::OutFileStream out(path);
+		if(!out.isReady())
+			return false;
+		write(out, t::uint32(MAGIC));
+		write(out, t::uint32(VERSION));
+		write(out, t::uint32(ORDER_MARK));
+		write(out, _builder);
+		write(out, _hard_sig);
+		write(out, _prog_sum);
+		for(HashMap<string, config_list_t>::PairIter e(_map); e(); e++) {
+			const string& key = (*e).fst;
+			const config_list_t& confs = (*e).snd;
+			write(out, key);
+			write(out, t::uint32(confs.length()));
+			for(int i = 0; i < confs.length(); i++) {
+				write(out, confs[i].time());
+				write(out, t::uint32(confs[i].count()));
+				for(ConfigSet::Iter c(confs[i]); c(); c++)
+					write(out, (*c).bits());
+			}
+		}
+		return true;
+	}
+
+private:
+	static const t::uint32 MAGIC = 0x45544331;	// "ETC1"
+	static const t::uint32 VERSION = 3;
+	static const t::uint32 ORDER_MARK = 0x01020304;
+	static const t::uint32 MAX_STRING = 1 << 20;
+
+	template <class T> static inline bool read(io::InStream& in, T& v)
+		{ return in.read(reinterpret_cast<char *>(&v), sizeof(T)) == int(sizeof(T)); }
+	template <class T> static inline void write(io::OutStream& out, const T& v)
+		{ out.write(reinterpret_cast<const char *>(&v), sizeof(T)); }
+
+	// strings are saved as their length followed by their characters:
+	// a length over MAX_STRING denotes a corrupted file
+	static bool read(io::InStream& in, string& s, t::uint32 len) {
+		if(len > MAX_STRING)
+			return false;
+		char *buf = new char[len];
+		bool ok = in.read(buf, len) == int(len);
+		if(ok)
+			s = string(buf, len);
+		delete [] buf;
+		return ok;
+	}
+	static inline bool read(io::InStream& in, string& s)
+		{ t::uint32 len; return read(in, len) && read(in, s, len); }
+	static inline void write(io::OutStream& out, const string& s)
+		{ write(out, t::uint32(s.length())); out.write(s.chars(), s.length()); }
+
+	string _builder;
+	t::uint32 _hard_sig, _prog_sum;
+	HashMap<string, config_list_t> _map;
+	HashMap<Block *, int> _bhits, _bmisses;
+	int _hits, _misses;
+	sys::Mutex *_mutex;
+};
+
+} }	// otawa::etime
+
+#endif /* OTAWA_ETIME_CONFIGCACHE_H_ */
@@ -20,11 +20,20 @@
  */
 
 #include <otawa/etime/EdgeTimeBuilder.h>
+#include <typeinfo>
 #include <elm/avl/Set.h>
+#include <elm/checksum/Fletcher.h>
+#include <elm/sys/Thread.h>
 #include <otawa/etime/features.h>
 #include <elm/data/quicksort.h>
 #include <otawa/etime/Config.h>
 #include <otawa/etime/EventCollector.h>
+#include <otawa/hard/Signature.h>
+#include <otawa/prog/File.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/stats/BBStatCollector.h>
+#include "ConfigCache.h"
 
 namespace otawa { namespace etime {
 
@@ -303,6 +312,97 @@ EventCollector::case_t EdgeTimeBuilder::make(const Event *e, EdgeTimeBuilder::pl
 }
 
 
+/**
+ * Edge to time in parallel mode with the configurations
+ * computed for each of its sequences.
+ */
+class EdgeTimeBuilder::Job {
+public:
+
+	class Result {
+	public:
+		inline Result(const event_list_t& a, const event_list_t& e, const config_list_t& c)
+			: all_events(a), events(e), confs(c) { }
+		event_list_t all_events, events;
+		config_list_t confs;
+	};
+
+	inline Job(BasicBlock *s, Edge *e, BasicBlock *t, CFG *c)
+		: source(s), edge(e), target(t), cfg(c) { }
+	~Job(void) { for(auto r: results) delete r; }
+
+	BasicBlock *source;
+	Edge *edge;
+	BasicBlock *target;
+	CFG *cfg;
+	Vector<Result *> results;
+};
+
+
+/**
+ * Runnable dispatching the jobs of an EdgeTimeBuilder to the threads
+ * launched by WorkSpace::runAll(). Each thread gets its own worker
+ * (see EdgeTimeBuilder::fork()) and the results are stored in the jobs
+ * so that no other synchronization is required.
+ */
+class EdgeRunner: public sys::Runnable {
+public:
+	EdgeRunner(EdgeTimeBuilder& builder)
+		: _builder(builder), _next(0), _failed(false), _mutex(sys::Mutex::make()) { }
+	~EdgeRunner(void) { delete _mutex; }
+
+	inline bool failed(void) const { return _failed; }
+	inline const string& error(void) const { return _error; }
+
+	void run(void) override {
+		_mutex->lock();
+		EdgeTimeBuilder *worker = _builder.fork();
+		_mutex->unlock();
+		try {
+			while(true) {
+				EdgeTimeBuilder::Job *job = next();
+				if(job == nullptr)
+					break;
+				worker->processJob(job);
+			}
+		}
+		catch(elm::Exception& e) {
+			fail(e.message());
+		}
+		catch(...) {
+			fail("unknown exception raised by an edge time computation");
+		}
+		worker->memo = nullptr;		// owned by the main builder
+		delete worker;
+	}
+
+private:
+	void fail(const string& msg) {
+		_mutex->lock();
+		if(!_failed) {
+			_failed = true;
+			_error = msg;
+		}
+		_mutex->unlock();
+	}
+
+	EdgeTimeBuilder::Job *next(void) {
+		_mutex->lock();
+		EdgeTimeBuilder::Job *r = nullptr;
+		if(!_failed && _next < _builder.jobs.length())
+			r = _builder.jobs[_next++];
+		_mutex->unlock();
+		return r;
+	}
+
+	EdgeTimeBuilder& _builder;
+	int _next;
+	bool _failed;
+	string _error;
+	sys::Mutex *_mutex;
+};
+
+
 /**
  * @class EdgeTimeBuilder
  * Compute execution time by edge using the parametric exegraph approach.
@@ -348,30 +448,109 @@ EdgeTimeBuilder::EdgeTimeBuilder(p::declare& r)
  	edge(0),
  	seq(0),
  	graph(0),
+ 	incremental(false),
  	bnode(0),
  	bedge(0),
  	source(0),
  	target(0),
 	record(false),
-	event_mask(0)
+	event_mask(0),
+	par(false),
+	job(nullptr),
+	use_memo(false),
+	memo(nullptr),
+	forked(false)
 { }
 
 
+/**
+ */
+EdgeTimeBuilder::~EdgeTimeBuilder(void) {
+	if(memo != nullptr)
+		delete memo;
+	if(forked)
+		releaseProcessor();
+}
+
+
 void EdgeTimeBuilder::configure(const PropList& props) {
 	GraphBBTime<EdgeTimeGraph>::configure(props);
 	_explicit = ipet::EXPLICIT(props);
 	predump = PREDUMP(props);
 	event_th = EVENT_THRESHOLD(props);
 	record = RECORD_TIME(props);
+	par = PARALLEL(props);
+	use_memo = CONFIG_CACHE(props);
+	memo_path = CONFIG_CACHE_PATH(props);
 	_props = props;
 }
 
 
+/**
+ * In parallel mode, the edges are only recorded while the blocks are traversed.
+ * Then they are timed by workers in parallel and, finally, the ILP contributions
+ * are generated in the traversal order.
+ */
+void EdgeTimeBuilder::processWorkSpace(WorkSpace *ws) {
+
+	// parallel mode disabled for readability of logs and graphs
+	if(par && (logFor(LOG_BLOCK) || _do_output_graphs))
+		par = false;
+
+	// traverse the blocks
+	GraphBBTime<EdgeTimeGraph>::processWorkSpace(ws);
+
+	// perform the parallel computation
+	if(par) {
+		EdgeRunner run(*this);
+		WorkSpace::runAll(run);
+		if(run.failed()) {
+			mergeJobs(false);
+			throw ProcessorException(*this, run.error());
+		}
+		mergeJobs(true);
+	}
+}
+
+
+/**
+ * Compute the checksum of the program file (0 if it cannot be read).
+ * @param ws	Current workspace.
+ * @return		Program checksum.
+ */
+static t::uint32 sumProgram(WorkSpace *ws) {
+	io::InFileStream in(ws->process()->program()->name());
+	if(!in.isReady())
+		return 0;
+	checksum::Fletcher sum;
+	char buf[4096];
+	while(true) {
+		int r = in.read(buf, sizeof(buf));
+		if(r <= 0)
+			break;
+		sum.put(buf, r);
+	}
+	return sum.sum();
+}
+
+
 /**
  */
 void EdgeTimeBuilder::setup(WorkSpace *ws) {
 	sys = ipet::SYSTEM(ws);
 
+	// prepare the configuration cache
+	if(memo != nullptr) {
+		delete memo;
+		memo = nullptr;
+	}
+	if(use_memo || !memo_path.isEmpty()) {
+		memo = new ConfigCache(name(), hard::signature(ws), sumProgram(ws));
+		if(!memo_path.isEmpty() && memo_path.exists() && !memo->load(memo_path))
+			warn(_ << "cannot load configuration cache from " << memo_path
+				<< " (unreadable or built for another version, builder, hardware or program)");
+	}
+
 }
 
 
@@ -383,6 +562,42 @@ void EdgeTimeBuilder::cleanup(WorkSpace *ws) {
 		delete *coll;
 	}
 	events.clear();
+
+	// save the configuration cache
+	if(memo != nullptr && !memo_path.isEmpty() && !memo->save(memo_path))
+		warn(_ << "cannot save configuration cache to " << memo_path);
+}
+
+
+/**
+ * Statistics of the configuration cache by block.
+ */
+class ConfigCacheStat: public BBStatCollector {
+public:
+	ConfigCacheStat(WorkSpace *ws, const HashMap<Block *, int>& counts, cstring id, cstring name, cstring desc)
+		: BBStatCollector(ws), _id(id), _name(name), _desc(desc)
+		{ for(HashMap<Block *, int>::PairIter c(counts); c(); c++) _counts.put((*c).fst, (*c).snd); }
+
+	cstring id() const override { return _id; }
+	cstring name() const override { return _name; }
+	cstring description() const override { return _desc; }
+	int getStat(BasicBlock *bb) override { return _counts.get(bb, 0); }
+
+private:
+	cstring _id, _name, _desc;
+	HashMap<Block *, int> _counts;
+};
+
+
+/**
+ */
+void EdgeTimeBuilder::collectStats(WorkSpace *ws) {
+	if(memo != nullptr) {
+		record(new ConfigCacheStat(ws, memo->blockHits(), "etime/cache_hits", "Configuration Cache Hits",
+			"Number of instruction sequences of the block whose times have been found in the configuration cache."));
+		record(new ConfigCacheStat(ws, memo->blockMisses(), "etime/cache_misses", "Configuration Cache Misses",
+			"Number of instruction sequences of the block whose times have been computed."));
+	}
 }
 
 
@@ -403,7 +618,10 @@ void EdgeTimeBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
 	for(auto p: ps) {
 		source = p.fst;
 		edge = p.snd;
-		processEdge(ws, cfg);
+		if(par)
+			jobs.add(new Job(source, edge, target, cfg));
+		else
+			processEdge(ws, cfg);
 	}
 
 #if 0
@@ -527,7 +745,7 @@ void EdgeTimeBuilder::processBB(WorkSpace *ws, CFG *cfg, Block *b) {
  * @return		Built graph.
  */
 EdgeTimeGraph *EdgeTimeBuilder::make(ParExeSequence *seq) {
-	EdgeTimeGraph *graph = new EdgeTimeGraph(this->workspace(), _microprocessor, &_hw_resources, seq, _props);
+	EdgeTimeGraph *graph = new EdgeTimeGraph(_ws, _microprocessor, &_hw_resources, seq, _props);
 	if(_do_output_graphs)
 		graph->setExplicit(true);
 	graph->build();
@@ -673,6 +891,64 @@ void EdgeTimeBuilder::processEdge(WorkSpace *ws, CFG *cfg) {
 }
 
 
+/**
+ * Build the key identifying the current sequence and its events in the
+ * configuration cache. It records, for each instruction, its part in the
+ * sequence, its kind, its address relatively to the sequence start,
+ * its used registers and its memory bank and, for each event, its
+ * instruction, kind, occurrence, place, type, cost and units. The position
+ * of the sequence in the instruction cache blocks is also recorded
+ * as it changes the fetch timing.
+ * @return	Key of the current sequence.
+ */
+string EdgeTimeBuilder::makeKey(void) {
+	StringBuffer buf;
+	Address base = seq->first()->inst()->address();
+	if(icache != nullptr)
+		buf << (base.offset() % icache->blockSize());
+	buf << '|';
+
+	// record instructions
+	for(ParExeSequence::InstIterator i(seq); i(); i++) {
+		Inst *inst = i->inst();
+		buf << int(i->codePart()) << ':' << io::hex(inst->kind()) << ':'
+			<< int(inst->address().offset() - base.offset()) << ':';
+		const Array<hard::Register *>& reads = inst->readRegs();
+		for(int j = 0; j < reads.count(); j++)
+			buf << reads[j]->platformNumber() << ',';
+		buf << ':';
+		const Array<hard::Register *>& writes = inst->writtenRegs();
+		for(int j = 0; j < writes.count(); j++)
+			buf << writes[j]->platformNumber() << ',';
+		if(mem != nullptr) {
+			const hard::Bank *bank = mem->get(inst->address());
+			if(bank != nullptr)
+				buf << ':' << bank->name() << '/' << bank->readLatency() << '/' << bank->writeLatency();
+		}
+		buf << ';';
+	}
+	buf << '|';
+
+	// record events
+	for(event_list_t::Iter e(all_events); e(); e++) {
+		Event *evt = (*e).fst;
+		buf << int(evt->inst()->address().offset() - base.offset()) << ':'
+			<< int(evt->kind()) << ':' << int(evt->occurrence()) << ':' << int((*e).snd) << ':'
+			<< int(evt->type()) << ':' << evt->cost() << ':' << evt->name();
+		if(evt->unit() != nullptr)
+			buf << ':' << evt->unit()->getName();
+		if(evt->related().fst != nullptr) {
+			buf << ':' << int(evt->related().fst->address().offset() - base.offset());
+			if(evt->related().snd != nullptr)
+				buf << '/' << evt->related().snd->getName();
+		}
+		buf << ';';
+	}
+
+	return buf.toString();
+}
+
+
 /**
  * Count the number of variable events in the event list.
  * @param events	Event list to process.
@@ -699,9 +975,27 @@ void EdgeTimeBuilder::processSequence(void) {
 				<< " -> " << (*e).fst->name() << " (" << (*e).fst->detail() << ") "
 				<< (*e).snd << io::endl;
 
+	// look in the configuration cache
+	if(memo != nullptr) {
+		memo_key = makeKey();
+		config_list_t confs;
+		if(memo->get(memo_key, confs, target)) {
+			if(logFor(LOG_BB))
+				log << "\t\t\t\tfound in configuration cache\n";
+			memo_key = "";
+			events.clear();
+			for(event_list_t::Iter e(all_events); e(); e++)
+				if((*e).fst->occurrence() == SOMETIMES)
+					events.add(*e);
+			generate(confs);
+			return;
+		}
+	}
+
 	// build the graph
 	PropList props;
 	graph = make(seq);
+	incremental = typeid(*graph) == typeid(EdgeTimeGraph);
 	graph->setBuilder(*this);
 	ASSERTP(graph->firstNode(), "no first node found: empty execution graph");
 
@@ -753,7 +1047,9 @@ void EdgeTimeBuilder::processSequence(void) {
 
 		// analyze
 		ot::time cost = graph->analyze();
-		genForOneCost(cost, edge, events);
+		Vector<ConfigSet> confs;
+		confs.add(ConfigSet(cost));
+		generate(confs);
 
 		// dump it if needed
 		if(_do_output_graphs) {
@@ -767,29 +1063,64 @@ void EdgeTimeBuilder::processSequence(void) {
 		return;
 	}
 
-	// compute all cases
-	t::uint32 prev = 0;
-	Vector<ConfigSet> confs;
+	// saturation pruning: if all events on cost as much as no event, all masks cost the same
 	custom.clear();
-	for(event_mask = 0; event_mask < t::uint32(1 << events.count()); event_mask++) {
+	bool pruning = false;
+	ot::time low = 0, high = 0;
+	if(isMonotonic()) {
+		low = evaluate();
+		for(int i = 0; i < events.count(); i++)
+			toggle(i, true, insts);
+		high = evaluate();
+		if(low == high) {
+			if(logFor(LOG_BB))
+				log << "\t\t\t\tall configurations dominated by cost " << low << io::endl;
+			delete graph;
+			Vector<ConfigSet> confs;
+			confs.add(ConfigSet(low));
+			generate(confs);
+			return;
+		}
+		for(int i = 0; i < events.count(); i++)
+			toggle(i, false, insts);
+		pruning = !_do_output_graphs;
+	}
+
+	// compute all cases in Gray code order (only one event changes at each step)
+	// when the cost is monotonic, a mask costing as much as all events on dominates
+	// its super-masks (same cost) and a mask costing as much as no event dominates
+	// its sub-masks: their cost is known without analyzing the graph
+	Vector<t::uint32> high_masks, low_masks;
+	Vector<ConfigSet> confs;
+	event_mask = 0;
+	for(t::uint32 k = 0; k < t::uint32(1 << events.count()); k++) {
 
 		// adjust the graph
-		for(int i = 0; i < events.count(); i++) {
-			if((prev & (1 << i)) != (event_mask & (1 << i))) {
-				if(event_mask & (1 << i))
-					apply(events[i].fst, insts[i]);
-				else
-					rollback(events[i].fst, insts[i]);
-			}
+		if(k != 0) {
+			int i = 0;
+			while(!(k & (1 << i)))
+				i++;
+			event_mask ^= 1 << i;
+			toggle(i, event_mask & (1 << i), insts);
 		}
-		prev = event_mask;
 
 		// predump implementation
 		if(_do_output_graphs && predump)
 			outputGraph(graph, 666, 666, 666, _ << source << " -> " << target);
 
 		// compute and store the new value
-		ot::time cost = graph->analyze();
+		ot::time cost;
+		if(pruning && dominates(high_masks, event_mask, true))
+			cost = high;
+		else if(pruning && dominates(low_masks, event_mask, false))
+			cost = low;
+		else {
+			cost = evaluate();
+			if(pruning && cost == high)
+				high_masks.add(event_mask);
+			else if(pruning && cost == low)
+				low_masks.add(event_mask);
+		}
 
 		// dump it if needed
 		if(_do_output_graphs) {
@@ -819,14 +1150,164 @@ void EdgeTimeBuilder::processSequence(void) {
 		displayConfs(confs, events);
 	delete graph;
 
-	// trivial case: 1 time
-	if(confs.length() == 1) {
+	// generate constraints
+	generate(confs);
+}
+
+
+/**
+ * Generate the ILP contribution for the configurations of the current sequence.
+ * In a worker of the parallel mode, the configurations are only recorded
+ * in the current job and generated later by the main builder.
+ * @param confs		Configuration sets sorted by increasing time.
+ */
+void EdgeTimeBuilder::generate(const config_list_t& confs) {
+	if(memo_key) {
+		memo->put(memo_key, confs);
+		memo_key = "";
+	}
+	if(job != nullptr)
+		job->results.add(new Job::Result(all_events, events, confs));
+	else if(confs.length() == 1)
 		genForOneCost(confs[0].time(), edge, all_events);
-		return;
+	else
+		processTimes(confs);
+}
+
+
+/**
+ * Build a worker for the parallel mode: it is a new instance of the
+ * builder, with the same configuration but with its own micro-processor
+ * description so that execution graphs can be built concurrently (the stages
+ * record the nodes of the graph under construction and cannot be shared).
+ * The micro-processor description and its resources are released with the worker.
+ * @return	Built worker (to delete by the caller).
+ */
+EdgeTimeBuilder *EdgeTimeBuilder::fork(void) {
+	EdgeTimeBuilder *w = static_cast<EdgeTimeBuilder *>(registration().make());
+	w->configure(_props);
+	w->prepareProcessor(_ws);
+	w->forked = true;
+	w->sys = sys;
+	w->memo = memo;
+	return w;
+}
+
+
+/**
+ * Compute the configurations of the given job (called in a worker).
+ * @param j		Job to process.
+ */
+void EdgeTimeBuilder::processJob(Job *j) {
+	job = j;
+	source = j->source;
+	edge = j->edge;
+	target = j->target;
+	processEdge(_ws, j->cfg);
+	job = nullptr;
+}
+
+
+/**
+ * Generate the ILP contributions of the jobs computed in parallel in the
+ * order they have been recorded and release them.
+ * @param gen	If false, only release the jobs.
+ */
+void EdgeTimeBuilder::mergeJobs(bool gen) {
+	for(auto j: jobs) {
+		if(gen) {
+			source = j->source;
+			edge = j->edge;
+			target = j->target;
+			for(auto r: j->results) {
+				all_events = r->all_events;
+				events = r->events;
+				generate(r->confs);
+			}
+		}
+		delete j;
 	}
+	jobs.clear();
+}
 
-	// generate constraints
-	processTimes(confs);
+
+/**
+ * Switch on or off the dynamic event at the given index and report the
+ * nodes of its instruction as changed to the graph for the next
+ * incremental analysis.
+ * @param i		Index of the event in events.
+ * @param on	True to apply the event, false to roll it back.
+ * @param insts	Instructions of the dynamic events.
+ */
+void EdgeTimeBuilder::toggle(int i, bool on, const Vector<ParExeInst *>& insts) {
+	if(on)
+		apply(events[i].fst, insts[i]);
+	else
+		rollback(events[i].fst, insts[i]);
+	for(ParExeInst::NodeIterator node(insts[i]); node(); node++)
+		graph->invalidate(*node);
+}
+
+
+/**
+ * Compute the cost of the current graph after some events have been toggled.
+ * The incremental ParExeGraph::reanalyze() relies on the default delay
+ * propagation: it is only used if the graph is a plain EdgeTimeGraph.
+ * Graphs built by an overridden make() may customize the timing
+ * (propagate(), initDelays()) and are fully analyzed each time.
+ * @return	Cost of the graph.
+ */
+ot::time EdgeTimeBuilder::evaluate(void) {
+	if(incremental)
+		return graph->reanalyze();
+	else
+		return graph->analyze();
+}
+
+
+/**
+ * Test if one of the given masks dominates a mask.
+ * @param masks		Dominating masks.
+ * @param mask		Tested mask.
+ * @param super		True if the masks dominate their super-masks,
+ * 					false if they dominate their sub-masks.
+ * @return			True if the mask is dominated, false else.
+ */
+bool EdgeTimeBuilder::dominates(const Vector<t::uint32>& masks, t::uint32 mask, bool super) {
+	for(int i = 0; i < masks.length(); i++)
+		if(super ? (masks[i] & ~mask) == 0 : (mask & ~masks[i]) == 0)
+			return true;
+	return false;
+}
+
+
+/**
+ * Test if the cost of the current graph is monotonic with the set of
+ * dynamic events, that is, if switching on an event cannot decrease the cost.
+ * This holds when:
+ * @li no event concerns the prefix (whose delays are used as reference
+ * to compute the cost),
+ * @li each event only increases latencies or adds edges of non-negative
+ * latency (a memory event adds its cost minus 1 to the latency and
+ * is only monotonic if its cost is at least 1),
+ * @li no queue resource makes the cost depend on the relative delays of resources,
+ * @li the delays are propagated by the default ParExeGraph implementation.
+ * @return	True if the cost is monotonic, false else.
+ */
+bool EdgeTimeBuilder::isMonotonic(void) {
+	if(!incremental)
+		return false;
+	for(int i = 0; i < events.count(); i++) {
+		if(events[i].snd == IN_PREFIX)
+			return false;
+		Event *e = events[i].fst;
+		if(e->cost() < (e->kind() == MEM ? 1 : 0))
+			return false;
+	}
+	for(int i = 0; i < graph->numResources(); i++)
+		if(graph->resource(i)->type() == Resource::QUEUE)
+			return false;
+	return true;
 }
 
 
@@ -1742,9 +2223,12 @@ void EdgeTimeBuilder::contributeConst(void) {
  * of events has been added to the ILP system.
  *
  * @p Configuration
+ * @li @ref CONFIG_CACHE
+ * @li @ref CONFIG_CACHE_PATH
  * @li @ref EVENT_THRESHOLD
  * @li @ref GRAPHS_OUTPUT_DIRECTORY
  * @li @ref ONLY_START
+ * @li @ref PARALLEL
  * @li @ref PREDUMP
  * @li @ref RECORD_TIME
  *
@@ -1772,6 +2256,18 @@ p::id<bool> RECORD_TIME("otawa::etime::RECORD_TIME", false);
  */
 p::id<ot::time> LTS_TIME("otawa::etime::LTS_TIME", -1);
 
+/**
+ * Configuration property of EDGE_TIME_FEATURE, if true, the execution graphs
+ * of the edges are built and analyzed in parallel (default to false).
+ * The contributions to the ILP system are generated afterwards in the order
+ * of the edges so that the result is the same as the sequential computation.
+ * Parallelism is only effective if OTAWA has been built with concurrency
+ * support (OTAWA_CONC) and is disabled when logging is set at block level
+ * or more or when the graphs are dumped.
+ * @ingroup etime
+ */
+p::id<bool> PARALLEL("otawa::etime::PARALLEL", false);
+
 /**
  * Produced only if the RECORD_TIME configuration is set,
  * record for each edge a pair(t, x) where (a) t the difference between maximum time
@@ -1790,6 +2286,28 @@ p::id<ot::time> LTS_TIME("otawa::etime::LTS_TIME", -1);
 p::id<Pair<ot::time, ilp::Var *> > HTS_CONFIG("otawa::etime::HTS_CONFIG", pair<ot::time, ilp::Var *>(0, nullptr));
 
 
+/**
+ * Configuration property of EDGE_TIME_FEATURE, if true, the configuration sets
+ * computed for an instruction sequence are stored in a cache and re-used
+ * for any other sequence with the same instructions and events (default to false).
+ * Hits and misses of the cache are recorded in the statistics.
+ * @ingroup etime
+ */
+p::id<bool> CONFIG_CACHE("otawa::etime::CONFIG_CACHE", false);
+
+/**
+ * Configuration property of EDGE_TIME_FEATURE giving the path of a file
+ * to load the configuration cache from (if it exists) and to save it to
+ * at the end of the computation. Setting this property enables the
+ * configuration cache (see @ref CONFIG_CACHE). The file records the signature
+ * of the hardware configuration and the checksum of the program: a file built
+ * for another hardware, program or file format version is ignored (and replaced
+ * at the end of the computation).
+ * @ingroup etime
+ */
+p::id<sys::Path> CONFIG_CACHE_PATH("otawa::etime::CONFIG_CACHE_PATH", "");
+
+
 /**
  * This property is used to configure the @ref EDGE_TIME_FEATURE and ask to dump the generated
  * execution graphs.
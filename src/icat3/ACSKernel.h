@@ -0,0 +1,64 @@
+/*
+ *	ACSKernel class interface
+ *	Copyright (c) 2017, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_ICAT3_ACSKERNEL_H_
+#define OTAWA_ICAT3_ACSKERNEL_H_
+
+#include <otawa/icat3/features.h>
+
+namespace otawa { namespace icat3 {
+
+class ACSKernel {
+public:
+	typedef void (*join_t)(age_t *d, const age_t *s, int n);
+	typedef bool (*equals_t)(const age_t *a, const age_t *b, int n);
+	typedef void (*inc_t)(age_t *a, int n, age_t lo, age_t hi, age_t ex);
+	typedef struct impl_t {
+		cstring name;
+		join_t max, min;
+		equals_t equals;
+		inc_t inc;
+	} impl_t;
+
+	static inline void max(ACS& d, const ACS& s)
+		{ if(d.count()) _.max_f(&d[0], &s[0], d.count()); }
+	static inline void minDefined(ACS& d, const ACS& s)
+		{ if(d.count()) _.min_f(&d[0], &s[0], d.count()); }
+	static inline bool equals(const ACS& a, const ACS& b)
+		{ return a.count() == 0 || _.equals_f(&a[0], &b[0], a.count()); }
+	static inline void inc(ACS& a, age_t lo, age_t hi, age_t ex)
+		{ if(a.count()) _.inc_f(&a[0], a.count(), lo, hi, ex); }
+	static inline cstring name(void) { return _._name; }
+	static int countImpls(void);
+	static const impl_t& impl(int i);
+
+private:
+	ACSKernel(void);
+	join_t max_f, min_f;
+	equals_t equals_f;
+	inc_t inc_f;
+	cstring _name;
+	static ACSKernel _;
+};
+
+} }		// otawa::icat3
+
+#endif /* OTAWA_ICAT3_ACSKERNEL_H_ */
@@ -23,6 +23,7 @@
 #define OTAWA_ICAT3_MAYDOMAIN_H_
 
 #include <otawa/icat3/features.h>
+#include "ACSKernel.h"
 
 namespace otawa { namespace icat3 {
 
@@ -38,8 +39,7 @@ public:
 	inline io::Printable<t, MayDomain> print(const t& a) const { return io::p(a, *this); }
 	inline bool contains(const t& a, int i) { return(a[i] != BOT_AGE); }
 	inline void copy(t& d, const t& s) { d.copy(s); }
-	inline bool equals(const t& a, const t& b)
-		{ for(int i = 0; i < n; i++) if(a[i] != b[i]) return false; return true; }
+	inline bool equals(const t& a, const t& b) { return ACSKernel::equals(a, b); }
 	void join(t& d, const t& s);
 	void fetch(t& a, const LBlock *lb);
 	void update(const icache::Access& access, t& a);
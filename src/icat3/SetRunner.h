@@ -0,0 +1,79 @@
+/*
+ *	SetRunner class interface
+ *	Copyright (c) 2016, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_ICAT3_SETRUNNER_H_
+#define OTAWA_ICAT3_SETRUNNER_H_
+
+#include <elm/sys/Thread.h>
+#include <otawa/icat3/features.h>
+#include <otawa/prog/WorkSpace.h>
+
+namespace otawa { namespace icat3 {
+
+/**
+ * Runnable dispatching the non-empty cache sets of an l-block
+ * collection to the threads launched by WorkSpace::runAll().
+ * Each set is given to exactly one thread that calls
+ * P::processSet(set) on it. As the sets are independent,
+ * the result does not depend on the order of processing.
+ *
+ * Without concurrency support, WorkSpace::runAll() runs the runnable
+ * in the current thread and the sets are processed in order.
+ *
+ * @param P		Type of processor (must provide processSet(int)).
+ */
+template <class P>
+class SetRunner: public sys::Runnable {
+public:
+	SetRunner(P& proc, const LBlockCollection& coll)
+		: _proc(proc), _coll(coll), _next(0), _mutex(sys::Mutex::make()) { }
+	~SetRunner(void) { delete _mutex; }
+
+	void run(void) override {
+		while(true) {
+			int set = next();
+			if(set < 0)
+				return;
+			_proc.processSet(set);
+		}
+	}
+
+private:
+	int next(void) {
+		_mutex->lock();
+		while(_next < _coll.sets() && _coll[_next].count() == 0)
+			_next++;
+		int r = -1;
+		if(_next < _coll.sets())
+			r = _next++;
+		_mutex->unlock();
+		return r;
+	}
+
+	P& _proc;
+	const LBlockCollection& _coll;
+	int _next;
+	sys::Mutex *_mutex;
+};
+
+} }	// otawa::icat3
+
+#endif /* OTAWA_ICAT3_SETRUNNER_H_ */
@@ -0,0 +1,276 @@
+/*
+ *	icat3::ACSKernel class implementation
+ *	Copyright (c) 2017, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include "ACSKernel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#	define ACS_X86
+#	include <immintrin.h>
+#endif
+
+namespace otawa { namespace icat3 {
+
+/**
+ * @class ACSKernel
+ * Vector kernels used by the ACS domains (MUST, PERS and MAY) to
+ * perform their element-wise operations on ages. The best implementation
+ * is selected at load time according to the running processor: AVX2, SSE2
+ * or a portable scalar fallback.
+ *
+ * The kernels work on any ACS size and alignment: the whole vectors are
+ * processed with unaligned loads and the remaining ages with the scalar code.
+ * All kernels produce exactly the same result as the scalar versions as long
+ * as ages are in [-1, 127[ (⊥ being -1).
+ *
+ * @ingroup icat3
+ */
+
+/**
+ * @fn void ACSKernel::max(ACS& d, const ACS& s);
+ * Perform d[i] = max(d[i], s[i]) with signed ages. As ⊥ = -1, this
+ * implements both the MUST and the PERS join.
+ * @param d		Target ACS.
+ * @param s		Source ACS.
+ */
+
+/**
+ * @fn void ACSKernel::minDefined(ACS& d, const ACS& s);
+ * Perform d[i] = min(d[i], s[i]) ignoring ⊥ ages (MAY join). This is an
+ * unsigned minimum as ⊥ = -1 is then the biggest value.
+ * @param d		Target ACS.
+ * @param s		Source ACS.
+ */
+
+/**
+ * @fn bool ACSKernel::equals(const ACS& a, const ACS& b);
+ * Test if both ACS are equal.
+ * @param a		First ACS.
+ * @param b		Second ACS.
+ * @return		True if they are equal, false else.
+ */
+
+/**
+ * @fn void ACSKernel::inc(ACS& a, age_t lo, age_t hi, age_t ex);
+ * Increment each age a[i] such that lo < a[i] < hi and a[i] ≠ ex.
+ * This is the ageing part of the fetch operation of all ACS domains.
+ * @param a		ACS to update.
+ * @param lo	Excluded lower bound.
+ * @param hi	Excluded upper bound.
+ * @param ex	Excluded age.
+ */
+
+/**
+ * @fn cstring ACSKernel::name(void);
+ * Get the name of the selected kernel implementation.
+ * @return	Kernel name ("avx2", "sse2" or "scalar").
+ */
+
+/**
+ * @class ACSKernel::impl_t
+ * Set of kernels of an implementation (mainly used for testing).
+ */
+
+
+// scalar kernels
+static void scalar_max(age_t *d, const age_t *s, int n) {
+	for(int i = 0; i < n; i++)
+		if(d[i] < s[i])
+			d[i] = s[i];
+}
+
+static void scalar_min(age_t *d, const age_t *s, int n) {
+	for(int i = 0; i < n; i++)
+		if(t::uint8(s[i]) < t::uint8(d[i]))
+			d[i] = s[i];
+}
+
+static bool scalar_equals(const age_t *a, const age_t *b, int n) {
+	for(int i = 0; i < n; i++)
+		if(a[i] != b[i])
+			return false;
+	return true;
+}
+
+static void scalar_inc(age_t *a, int n, age_t lo, age_t hi, age_t ex) {
+	for(int i = 0; i < n; i++)
+		if(lo < a[i] && a[i] < hi && a[i] != ex)
+			a[i]++;
+}
+
+
+#ifdef ACS_X86
+
+// SSE2 kernels (SSE2 lacks signed byte max: bias to unsigned)
+__attribute__((target("sse2")))
+static void sse2_max(age_t *d, const age_t *s, int n) {
+	const __m128i b = _mm_set1_epi8(char(0x80));
+	int i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(d + i)), b);
+		__m128i y = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(s + i)), b);
+		_mm_storeu_si128((__m128i *)(d + i), _mm_xor_si128(_mm_max_epu8(x, y), b));
+	}
+	scalar_max(d + i, s + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void sse2_min(age_t *d, const age_t *s, int n) {
+	int i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(d + i));
+		__m128i y = _mm_loadu_si128((const __m128i *)(s + i));
+		_mm_storeu_si128((__m128i *)(d + i), _mm_min_epu8(x, y));
+	}
+	scalar_min(d + i, s + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static bool sse2_equals(const age_t *a, const age_t *b, int n) {
+	int i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+		__m128i y = _mm_loadu_si128((const __m128i *)(b + i));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff)
+			return false;
+	}
+	return scalar_equals(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void sse2_inc(age_t *a, int n, age_t lo, age_t hi, age_t ex) {
+	const __m128i l = _mm_set1_epi8(lo), h = _mm_set1_epi8(hi), e = _mm_set1_epi8(ex);
+	int i = 0;
+	for(; i + 16 <= n; i += 16) {
+		__m128i x = _mm_loadu_si128((const __m128i *)(a + i));
+		__m128i m = _mm_and_si128(_mm_cmpgt_epi8(x, l), _mm_cmpgt_epi8(h, x));
+		m = _mm_andnot_si128(_mm_cmpeq_epi8(x, e), m);
+		_mm_storeu_si128((__m128i *)(a + i), _mm_sub_epi8(x, m));
+	}
+	scalar_inc(a + i, n - i, lo, hi, ex);
+}
+
+
+// AVX2 kernels
+__attribute__((target("avx2")))
+static void avx2_max(age_t *d, const age_t *s, int n) {
+	int i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(d + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(s + i));
+		_mm256_storeu_si256((__m256i *)(d + i), _mm256_max_epi8(x, y));
+	}
+	sse2_max(d + i, s + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void avx2_min(age_t *d, const age_t *s, int n) {
+	int i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(d + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(s + i));
+		_mm256_storeu_si256((__m256i *)(d + i), _mm256_min_epu8(x, y));
+	}
+	sse2_min(d + i, s + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static bool avx2_equals(const age_t *a, const age_t *b, int n) {
+	int i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+		__m256i y = _mm256_loadu_si256((const __m256i *)(b + i));
+		if(t::uint32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y))) != 0xffffffff)
+			return false;
+	}
+	return sse2_equals(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void avx2_inc(age_t *a, int n, age_t lo, age_t hi, age_t ex) {
+	const __m256i l = _mm256_set1_epi8(lo), h = _mm256_set1_epi8(hi), e = _mm256_set1_epi8(ex);
+	int i = 0;
+	for(; i + 32 <= n; i += 32) {
+		__m256i x = _mm256_loadu_si256((const __m256i *)(a + i));
+		__m256i m = _mm256_and_si256(_mm256_cmpgt_epi8(x, l), _mm256_cmpgt_epi8(h, x));
+		m = _mm256_andnot_si256(_mm256_cmpeq_epi8(x, e), m);
+		_mm256_storeu_si256((__m256i *)(a + i), _mm256_sub_epi8(x, m));
+	}
+	sse2_inc(a + i, n - i, lo, hi, ex);
+}
+
+#endif	// ACS_X86
+
+
+// implementations from the least to the most efficient
+static const ACSKernel::impl_t impls[] = {
+	{ "scalar", scalar_max, scalar_min, scalar_equals, scalar_inc },
+#	ifdef ACS_X86
+	{ "sse2", sse2_max, sse2_min, sse2_equals, sse2_inc },
+	{ "avx2", avx2_max, avx2_min, avx2_equals, avx2_inc },
+#	endif
+};
+
+
+/**
+ * Get the number of implementations supported by the running processor.
+ * @return	Number of supported implementations.
+ */
+int ACSKernel::countImpls(void) {
+	int n = 1;
+#	ifdef ACS_X86
+		__builtin_cpu_init();
+		if(__builtin_cpu_supports("sse2"))
+			n++;
+		if(n == 2 && __builtin_cpu_supports("avx2"))
+			n++;
+#	endif
+	return n;
+}
+
+
+/**
+ * Get an implementation supported by the running processor, the first
+ * one being the scalar implementation and the last one the selected one.
+ * @param i		Implementation index in [0, countImpls()[.
+ * @return		Implementation.
+ */
+const ACSKernel::impl_t& ACSKernel::impl(int i) {
+	ASSERT(0 <= i && i < countImpls());
+	return impls[i];
+}
+
+
+/**
+ * Select the kernels according to the running processor.
+ */
+ACSKernel::ACSKernel(void) {
+	const impl_t& i = impl(countImpls() - 1);
+	max_f = i.max;
+	min_f = i.min;
+	equals_f = i.equals;
+	inc_f = i.inc;
+	_name = i.name;
+}
+
+ACSKernel ACSKernel::_;
+
+} }		// otawa::icat3
@@ -21,13 +21,14 @@
  */
 
 #include <otawa/ai/ArrayStore.h>
-#include <otawa/cfg/CompositeCFG.h>
 #include <otawa/ai/SimpleAI.h>
 #include <otawa/cfg/features.h>
 #include <otawa/icache/features.h>
+#include <otawa/icache/SetProjectedGraph.h>
 #include <otawa/icat3/features.h>
 #include "../../include/otawa/ai/RankingAI.h"
 #include "MayDomain.h"
+#include "SetRunner.h"
 
 
 namespace otawa { namespace icat3 {
@@ -57,12 +58,8 @@ MayDomain::MayDomain(const LBlockCollection& coll, int set, const t *init)
 void MayDomain::join(t& d, const t& s) {
 	// J(a, a') = a" s.t.
 
-	// ∀ b ∈ B_s, a"[b] = min(a[b], a'[b])
-	for(int i = 0; i < n; i++)
-		if(d[i] == BOT_AGE)
-			d[i] = s[i];
-		else if(s[i] != BOT_AGE)
-			d[i] = min(d[i], s[i]);
+	// ∀ b ∈ B_s, a"[b] = min(a[b], a'[b]) ignoring ⊥
+	ACSKernel::minDefined(d, s);
 }
 
 /**
@@ -71,11 +68,10 @@ void MayDomain::fetch(t& a, const LBlock *lb) {
 	int b = lb->index();
 
 	// U(a, b) = a' s.t. ∀ b' ∈ B_s
-	for(int i = 0; i < n; i++)
-		// a'[b'] = a[b'] + 1	if a[b'] < a[b] ∧ a[b'] ≠ ⊥
-		if(a[i] <= a[b] && a[i] != A)
-			a[i]++;
-		// a'[b'] = a[b']		else
+	// a'[b'] = a[b'] + 1	if a[b'] ≤ a[b] ∧ a[b'] ≠ A
+	// a'[b'] = a[b']		else
+	// (a[b'] ≤ a[b] ⟺ a[b'] < a[b] + 1, the case a[b] = A being covered by a[b'] ≠ A)
+	ACSKernel::inc(a, type_info<age_t>::min, a[b] < A ? a[b] + 1 : A, A);
 
 	// a[b] = 0
 	a[b] = 0;
@@ -116,12 +112,12 @@ class MayAdapter {
 public:
 	typedef MayDomain domain_t;
 	typedef typename domain_t::t t;
-	typedef CompositeCFG graph_t;
+	typedef icache::SetProjectedGraph graph_t;
 	typedef ai::ArrayStore<domain_t, graph_t> store_t;
 
-	MayAdapter(int set, const t *init, const LBlockCollection& coll, const CFGCollection& cfgs):
+	MayAdapter(int set, const t *init, const LBlockCollection& coll, const icache::SetProjector& proj):
 		_domain(coll, set, init),
-		_graph(cfgs),
+		_graph(proj, *coll.cache(), set, false),
 		_store(_domain, _graph) { }
 
 	inline domain_t& domain(void) { return _domain; }
@@ -138,9 +134,9 @@ public:
 		_domain.copy(d, _domain.bot());
 		t s;
 
-		// update and join along edges
-		for(auto e = _graph.preds(v); e(); e++) {
-			Block *w = e->source();
+		// update and join along links
+		for(auto l = _graph.preds(v); l(); l++) {
+			Block *w = l->source();
 			_domain.copy(s, _store.get(w));
 
 			// apply block
@@ -152,7 +148,7 @@ public:
 
 			// apply edge
 			{
-				const Bag<icache::Access>& accs = icache::ACCESSES(*e);
+				const Bag<icache::Access>& accs = icache::ACCESSES(l->edge());
 				if(accs.count() > 0)
 					update(accs, s);
 			}
@@ -175,9 +171,10 @@ private:
  * @ingroup icat3
  */
 class MayAnalysis: public Processor {
+	friend class SetRunner<MayAnalysis>;
 public:
 	static p::declare reg;
-	MayAnalysis(p::declare& r = reg): Processor(r), init_may(nullptr), coll(nullptr), cfgs(nullptr) { }
+	MayAnalysis(p::declare& r = reg): Processor(r), init_may(nullptr), coll(nullptr), cfgs(nullptr), proj(nullptr), par(false) { }
 
 protected:
 
@@ -185,6 +182,7 @@ protected:
 		Processor::configure(props);
 		if(props.hasProp(MAY_INIT))
 			init_may = &MAY_INIT(props);
+		par = PARALLEL(props);
 	}
 
 	void setup(WorkSpace *ws) override {
@@ -192,6 +190,12 @@ protected:
 		ASSERT(coll != nullptr);
 		cfgs = otawa::INVOLVED_CFGS(ws);
 		ASSERT(cfgs != nullptr);
+		proj = new icache::SetProjector(*cfgs);
+	}
+
+	void cleanup(WorkSpace *ws) override {
+		delete proj;
+		proj = nullptr;
 	}
 
 	void processWorkSpace(WorkSpace *ws) override {
@@ -200,14 +204,21 @@ protected:
 		for(CFGCollection::BlockIter b(cfgs); b(); b++)
 			(*MAY_IN(*b)).configure(*coll);
 
-		// compute ACS
-		for(int i = 0; i < coll->cache()->setCount(); i++) {
-			if((*coll)[i].count()) {
-				if(logFor(LOG_FUN))
-					log << "\tanalyzing set " << i << io::endl;
-				processSet(i);
-			}
+		// compute ACS in parallel (logging disabled for readability)
+		if(par && !logFor(LOG_FUN)) {
+			SetRunner<MayAnalysis> run(*this, *coll);
+			WorkSpace::runAll(run);
 		}
+
+		// compute ACS in sequence
+		else
+			for(int i = 0; i < coll->cache()->setCount(); i++) {
+				if((*coll)[i].count()) {
+					if(logFor(LOG_FUN))
+						log << "\tanalyzing set " << i << io::endl;
+					processSet(i);
+				}
+			}
 	}
 
 	void destroy(WorkSpace *ws) override {
@@ -220,16 +231,21 @@ private:
 	void processSet(int i) {
 
 		// perform the analysis
-		MayAdapter ada(i, init_may ? &init_may->get(i) : nullptr, *coll, *cfgs);
+		MayAdapter ada(i, init_may ? &init_may->get(i) : nullptr, *coll, *proj);
 		ai::SimpleAI<MayAdapter> ana(ada);
 		ana.run();
 
-		// store the results
+		// store the results (irrelevant blocks are computed from the links traversing them)
+		MayDomain::t d;
 		for(CFGCollection::BlockIter b(cfgs); b(); b++)
 			if(b->isBasic()) {
-				ada.domain().copy((*MAY_IN(*b))[i], ada.store().get(*b));
+				if(ada.graph().isRelevant(*b))
+					ada.domain().copy(d, ada.store().get(*b));
+				else
+					ada.update(*b, d);
+				ada.domain().copy((*MAY_IN(*b))[i], d);
 				if(logFor(LOG_BLOCK)) {
-					log << "\t\t\t" << *b << ": " << ada.domain().print(ada.store().get(*b)) << io::endl;
+					log << "\t\t\t" << *b << ": " << ada.domain().print(d) << io::endl;
 				}
 			}
 
@@ -242,6 +258,8 @@ private:
 	const Container<ACS> *init_may;
 	const LBlockCollection *coll;
 	const CFGCollection *cfgs;
+	icache::SetProjector *proj;
+	bool par;
 };
 
 p::declare MayAnalysis::reg = p::init("otawa::icat3::MayAnalysis", Version(1, 0, 0))
@@ -260,6 +278,7 @@ p::declare MayAnalysis::reg = p::init("otawa::icat3::MayAnalysis", Version(1, 0,
  *
  * @par Configuraiton
  * @li @ref MAY_INIT
+ * @li @ref PARALLEL
  *
  * @par Implementation
  * @li @ref MayAnlysis
@@ -29,9 +29,10 @@
 #include <otawa/icache/features.h>
 #include <otawa/proc/EdgeProcessor.h>
 #include <otawa/icat3/features.h>
-#include <otawa/cfg/CompositeCFG.h>
+#include <otawa/icache/SetProjectedGraph.h>
 #include <otawa/ai/SimpleAI.h>
 #include "MustPersDomain.h"
+#include "SetRunner.h"
 
 #define DEBUG(x)	// cerr << "DEBUG: " << x << io::endl
 
@@ -192,17 +193,21 @@ void ACSStack::print(int set, const LBlockCollection& coll, io::Output& out) con
 
 
 /**
+ * The analysis is performed on the graph of the task projected on the analyzed set
+ * (see icache::SetProjectedGraph): the links of the graph are handled as the
+ * edges of the CompositeCFG they start with, the other blocks and edges
+ * of the path being the identity.
  */
 class MustPersAdapter {
 public:
 	typedef MustPersDomain domain_t;
 	typedef typename domain_t::t t;
-	typedef CompositeCFG graph_t;
+	typedef icache::SetProjectedGraph graph_t;
 	typedef ai::ArrayStore<domain_t, graph_t> store_t;
 
-	MustPersAdapter(int set, const MustDomain::t *must_init, const ACS *pers_init, const LBlockCollection& coll, const CFGCollection& cfgs):
+	MustPersAdapter(int set, const MustDomain::t *must_init, const ACS *pers_init, const LBlockCollection& coll, const icache::SetProjector& proj):
 		_domain(coll, set, must_init, pers_init),
-		_graph(cfgs),
+		_graph(proj, *coll.cache(), set),
 		_store(_domain, _graph) { }
 
 	inline domain_t& domain(void) { return _domain; }
@@ -222,12 +227,13 @@ public:
 		_domain.copy(d, _domain.bot());
 		t s;
 
-		// update and join along edges
+		// update and join along links
 		DEBUG("compute IN of " << v);
-		for(auto e = _graph.preds(v); e(); e++) {
-			Block *w = e->source();
+		for(auto l = _graph.preds(v); l(); l++) {
+			Edge *e = l->edge();
+			Block *w = l->source();
 			_domain.copy(s, _store.get(w));
-			DEBUG("  by " << *e << " in " << v->cfg());
+			DEBUG("  by " << e << " in " << v->cfg());
 			DEBUG("    " << _domain.print(s));
 
 			// apply block
@@ -238,24 +244,24 @@ public:
 			}
 
 			// loop support
-			if(LOOP_EXIT(*e))
+			if(LOOP_EXIT(e))
 				for(LoopIter h(e->source()); h(); h++) {
 					_domain.leaveLoop(s);
-					if(*h == LOOP_EXIT(*e))
+					if(*h == LOOP_EXIT(e))
 						break;
 				}
-			if(LOOP_HEADER(e->target()) && !BACK_EDGE(*e))
+			if(LOOP_HEADER(e->target()) && !BACK_EDGE(e))
 				_domain.enterLoop(s);
 
 			// subprogram call support (PERS ACS level fix)
-			if(_graph.isReturn(*e))
-				_domain.doReturn(s, v);
-			if(_graph.isCall(*e))
+			if(_graph.isReturn(*l))
+				_domain.doReturn(s, l->target());
+			if(_graph.isCall(*l))
 				_domain.doCall(s, e->sink()->outs()->sink());
 
 			// apply edge
 			{
-				const Bag<icache::Access>& accs = icache::ACCESSES(*e);
+				const Bag<icache::Access>& accs = icache::ACCESSES(e);
 				if(accs.count() > 0)
 					update(accs, s);
 			}
@@ -275,9 +281,10 @@ private:
 /**
  */
 class MustPersAnalysis: public Processor {
+	friend class SetRunner<MustPersAnalysis>;
 public:
 	static p::declare reg;
-	MustPersAnalysis(void): Processor(reg), coll(0), init_must(0), init_pers(0), cfgs(0) {
+	MustPersAnalysis(void): Processor(reg), coll(0), init_must(0), init_pers(0), cfgs(0), proj(0), par(false) {
 	}
 
 	virtual void configure(const PropList& props) {
@@ -286,6 +293,7 @@ public:
 			init_must = &MUST_INIT(props);
 		if(props.hasProp(PERS_INIT))
 			init_pers = &PERS_INIT(props);
+		par = PARALLEL(props);
 	}
 
 protected:
@@ -295,9 +303,15 @@ protected:
 		if(coll) {
 			cfgs = otawa::INVOLVED_CFGS(ws);
 			ASSERT(cfgs);
+			proj = new icache::SetProjector(*cfgs);
 		}
 	}
 
+	virtual void cleanup(WorkSpace *ws) {
+		delete proj;
+		proj = 0;
+	}
+
 	virtual void processWorkSpace(WorkSpace *ws) {
 		if(!coll)
 			return;
@@ -309,30 +323,44 @@ protected:
 			track(MUST_PERS_ANALYSIS_FEATURE, MUST_IN(*b));
 		}
 
-		// compute ACS
-		for(int i = 0; i < coll->cache()->setCount(); i++) {
-			if((*coll)[i].count()) {
-				if(logFor(LOG_FUN))
-					log << "\tanalyzing set " << i << io::endl;
-				processSet(i);
-			}
+		// compute ACS in parallel (logging disabled for readability)
+		if(par && !logFor(LOG_FUN)) {
+			SetRunner<MustPersAnalysis> run(*this, *coll);
+			WorkSpace::runAll(run);
 		}
+
+		// compute ACS in sequence
+		else
+			for(int i = 0; i < coll->cache()->setCount(); i++) {
+				if((*coll)[i].count()) {
+					if(logFor(LOG_FUN))
+						log << "\tanalyzing set " << i << io::endl;
+					processSet(i);
+				}
+			}
 	}
 
 	void processSet(int set) {
 
 		// perform the analysis
-		MustPersAdapter ada(set, init_must ? &init_must->get(set) : nullptr, init_pers ? &init_pers->get(set) : nullptr, *coll, *cfgs);
+		MustPersAdapter ada(set, init_must ? &init_must->get(set) : nullptr, init_pers ? &init_pers->get(set) : nullptr, *coll, *proj);
+		if(logFor(LOG_FUN))
+			log << "\t\tprojected graph: " << ada.graph().count() << " blocks out of " << proj->count() << io::endl;
 		ai::SimpleAI<MustPersAdapter> ana(ada);
 		ana.run();
 
-		// store the results
+		// store the results (irrelevant blocks are computed from the links traversing them)
+		MustPersDomain::t d;
 		for(CFGCollection::BlockIter b(cfgs); b(); b++)
 			if(b->isBasic()) {
-				ada.domain().mustDomain().copy((*MUST_IN(*b))[set], ada.store().get(*b).must);
-				ada.domain().persDomain().copy((*PERS_IN(*b))[set], ada.store().get(*b).pers);
+				if(ada.graph().isRelevant(*b))
+					ada.domain().copy(d, ada.store().get(*b));
+				else
+					ada.update(*b, d);
+				ada.domain().mustDomain().copy((*MUST_IN(*b))[set], d.must);
+				ada.domain().persDomain().copy((*PERS_IN(*b))[set], d.pers);
 				if(logFor(LOG_BLOCK)) {
-					log << "\t\t\t" << *b << ": " << ada.domain().print(ada.store().get(*b)) << io::endl;
+					log << "\t\t\t" << *b << ": " << ada.domain().print(d) << io::endl;
 				}
 			}
 	}
@@ -340,6 +368,8 @@ protected:
 	const LBlockCollection *coll;
 	const Container<ACS> *init_must, *init_pers;
 	const CFGCollection *cfgs;
+	icache::SetProjector *proj;
+	bool par;
 };
 
 p::declare MustPersAnalysis::reg = p::init("otawa::icat3::MustPersAnalysis", Version(1, 0, 0))
@@ -366,6 +396,20 @@ p::id<Container<ACS> > MUST_INIT("otawa::icat3::MUST_INIT");
  */
 p::id<Container<ACS> > PERS_INIT("otawa::icat3::PERS_INIT");
 
+/**
+ * Ask the ACS analyses to process the cache sets in parallel
+ * (default to false). Each set is analyzed independently and stored
+ * in its own slot of the result containers so that the result is
+ * the same as the sequential analysis. Parallelism is only effective
+ * if OTAWA has been built with concurrency support (OTAWA_CONC)
+ * and is disabled when logging is set at function level or more.
+ *
+ * @par Feature
+ * @li @ref MUST_PERS_ANALYSIS_FEATURE
+ * @li @ref MAY_ANALYSIS_FEATURE
+ */
+p::id<bool> PARALLEL("otawa::icat3::PARALLEL", false);
+
 /**
  * Feature performing instruction cache analysis with combined
  * MUST and PERS analyzes.
@@ -373,6 +417,7 @@ p::id<Container<ACS> > PERS_INIT("otawa::icat3::PERS_INIT");
  * @par Configuration
  * @li @ref MUST_INIT
  * @li @ref PERS_INIT
+ * @li @ref PARALLEL
  *
  * @par Properties
  * @li @ref MUST_STATE
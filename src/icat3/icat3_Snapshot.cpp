@@ -0,0 +1,135 @@
+/*
+ *	icat3 snapshot serializers
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <otawa/icat3/features.h>
+#include <otawa/prog/Snapshot.h>
+
+namespace otawa { namespace icat3 {
+
+/*
+ * The ACS containers are saved as a list of integers separated by spaces:
+ * @li container -- number of sets followed by the set values,
+ * @li ACS -- number of l-blocks followed by their ages,
+ * @li ACS stack -- 1 for bottom, else 0 followed by the whole ACS,
+ * the stack depth and the ACS of each level.
+ */
+
+// parse the next integer, return false if there is none
+static bool scan(const char *& p, int& v) {
+	char *e;
+	long r = strtol(p, &e, 10);
+	if(e == p)
+		return false;
+	p = e;
+	v = r;
+	return true;
+}
+
+static void save(io::Output& out, const ACS& a) {
+	out << ' ' << a.count();
+	for(int i = 0; i < a.count(); i++)
+		out << ' ' << int(a[i]);
+}
+
+static bool load(const char *& p, ACS& a) {
+	int n;
+	if(!scan(p, n) || n < 0)
+		return false;
+	a.set(n, new age_t[n]);
+	for(int i = 0; i < n; i++) {
+		int v;
+		if(!scan(p, v))
+			return false;
+		a[i] = v;
+	}
+	return true;
+}
+
+static void save(io::Output& out, const ACSStack& a) {
+	out << ' ' << int(a.isBottom());
+	if(a.isBottom())
+		return;
+	save(out, a.whole());
+	out << ' ' << a.depth();
+	for(int i = 0; i < a.depth(); i++)
+		save(out, a[i]);
+}
+
+static bool load(const char *& p, ACSStack& a) {
+	int bot, d;
+	a.stack().clear();
+	if(!scan(p, bot))
+		return false;
+	a.setBottom(bot != 0);
+	if(a.isBottom())
+		return true;
+	if(!load(p, a.whole()) || !scan(p, d) || d < 0)
+		return false;
+	for(int i = 0; i < d; i++) {
+		ACS s;
+		if(!load(p, s))
+			return false;
+		a.push(s);
+	}
+	return true;
+}
+
+
+/*
+ * Serializer of containers of ACS or of ACS stacks.
+ */
+template <class T>
+class ContainerSerializer: public SnapshotSerializer {
+public:
+	ContainerSerializer(const p::id<Container<T> >& id): SnapshotSerializer(id), _id(id) { }
+
+	void save(io::Output& out, const Property *prop) const override {
+		const Container<T>& c = _id.get(prop);
+		out << c.count();
+		for(int i = 0; i < c.count(); i++)
+			icat3::save(out, c[i]);
+	}
+
+	bool load(cstring text, PropList& props) const override {
+		const char *p = text.chars();
+		int n;
+		if(!scan(p, n) || n < 0)
+			return false;
+		Container<T> c;
+		c.set(n, new T[n]);
+		for(int i = 0; i < n; i++)
+			if(!icat3::load(p, c[i]))
+				return false;
+		_id.add(props, c);
+		return true;
+	}
+
+private:
+	const p::id<Container<T> >& _id;
+};
+
+static ContainerSerializer<ACS> must_in_ser(MUST_IN);
+static ContainerSerializer<ACSStack> pers_in_ser(PERS_IN);
+static ContainerSerializer<ACS> may_in_ser(MAY_IN);
+
+} }	// otawa::icat3
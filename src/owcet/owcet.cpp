@@ -26,6 +26,7 @@
 #include <otawa/cfg/features.h>
 #include <otawa/ilp/System.h>
 #include <otawa/ipet/IPET.h>
+#include <otawa/prog/Snapshot.h>
 #include <otawa/script/Script.h>
 #include <otawa/stats/StatInfo.h>
 #include <otawa/util/BBRatioDisplayer.h>
@@ -75,6 +76,9 @@ using namespace elm::option;
  * to pass parameters to the script and the supported @i ID depends on the launched script (see its documentation
  * for more details).
  * * -s, --script PATH: use the given script to compute the WCET.
+ * * --snapshot PATH: if PATH is a snapshot matching the executable, restore from it the CFGs, the loops
+ * and the recorded properties instead of computing them; else record them to PATH after the computation
+ * (identifiers to record are selected with --add-prop otawa::SNAPSHOT_INCLUDE=ID, see @ref snapshot).
  * * -S, --display-stats: display statistics produced by the analysis.
  * * --stats: outputs available statistics in work directory.
  * * -t, --timed: display computation time.
@@ -143,7 +147,8 @@ public:
 	timed			(SwitchOption			::Make(*this).cmd("--timed")	.cmd("-t").description("display computation")),
 	display_stats	(SwitchOption			::Make(*this).cmd("-S")			.cmd("--display-stats").description("display statistics")),
 	//detailed_stats	(SwitchOption			::Make(*this).cmd("-D")			.cmd("--detailed-stats").description("output detail of statistics")),
-	wcet_stats		(SwitchOption			::Make(*this).cmd("-w")			.cmd("--wcet-stat").description("detailed statistics about WCET"))
+	wcet_stats		(SwitchOption			::Make(*this).cmd("-w")			.cmd("--wcet-stat").description("detailed statistics about WCET")),
+	snapshot		(ValueOption<string>	::Make(*this).cmd("--snapshot").description("restore from or record to a snapshot of the CFGs and loops").argDescription("PATH"))
 	{ }
 
 protected:
@@ -199,8 +204,24 @@ protected:
 			ipet::EXPLICIT(props) = true;
 		TASK_ENTRY(props) = entry;
 		script::PATH(props) = path;
+
+		// the snapshot is restored by the script once its platform is loaded
+		if(snapshot)
+			SNAPSHOT_PATH(props) = Path(*snapshot);
+
+		// run the script
 		script::Script *scr = new script::Script();
 		workspace()->run(scr, props);
+		bool restored = workspace()->isProvided(SNAPSHOT_RESTORED_FEATURE);
+		if(restored && isVerbose())
+			cerr << "INFO: snapshot restored from " << *snapshot << io::endl;
+
+		// record the snapshot if needed
+		if(snapshot && !restored && !list) {
+			if(isVerbose())
+				cerr << "INFO: recording snapshot to " << *snapshot << io::endl;
+			workspace()->run<SnapshotSaver>(props);
+		}
 
 		// process the list option
 		if(list) {
@@ -272,6 +293,7 @@ private:
 	SwitchOption timed;
 	SwitchOption display_stats;
 	SwitchOption wcet_stats;
+	ValueOption<string> snapshot;
 	string bin, task;
 
 };
@@ -0,0 +1,353 @@
+/*
+ *	StackAnalysis state (internal interface)
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+#ifndef OTAWA_PROG_STACKSTATE_H_
+#define OTAWA_PROG_STACKSTATE_H_
+
+#include <otawa/prog/File.h>
+#include <otawa/prog/Process.h>
+#include <otawa/stack/features.h>
+
+#ifndef TRACED
+#	define TRACED(t)	//t
+#endif
+
+namespace otawa { namespace stack {
+
+/*
+ * Nodes of the states are allocated by chunks and recycled through a free list.
+ * As the states of an analysis share their nodes, all the chunks are released
+ * at once when the last node is freed. The arena is shared by all the analyses
+ * of the process: in the concurrent version (OTAWA_CONC), it is protected
+ * by a lock.
+ */
+template <class T>
+class Arena {
+public:
+	static void *allocate(void);
+	static void release(void *p);
+	static int count(void);
+};
+
+
+/*
+ * The state is a persistent map from addresses to values implemented
+ * as a treap whose priorities are a hash of the addresses: a set of
+ * addresses has a unique shape whatever the order of insertion.
+ * The nodes are reference-counted and never modified once built:
+ * a copy shares the root, set() copies the path to the changed address
+ * and join() or equals() stop as soon as they find a shared sub-tree.
+ */
+class State {
+public:
+
+	class Node {
+	public:
+		friend class State;
+		inline Node(const Value& address, const Value& value, Node *l, Node *r)
+			: left(l), right(r), addr(address), val(value), prio(hash(address)), rc(1) { }
+		static inline void *operator new(size_t size) { return Arena<Node>::allocate(); }
+		static inline void operator delete(void *p) { Arena<Node>::release(p); }
+
+		static inline t::uint32 hash(const Value& a) {
+			t::uint32 h = a.value() * 0x9e3779b1U ^ t::uint32(a.kind()) * 0x85ebca6bU;
+			return h ^ (h >> 16);
+		}
+		inline bool above(const Node *n) const
+			{ return prio > n->prio || (prio == n->prio && addr < n->addr); }
+
+	private:
+		Node *left, *right;
+		Value addr;
+		Value val;
+		t::uint32 prio;
+		int rc;
+	};
+
+	State(const Value& def = Value::all): root(0), def(def)
+		{ TRACED(cerr << "State(" << def << ")\n"); }
+	State(const State& state): root(share(state.root)), def(state.def)
+		{ TRACED(cerr << "State("; state.print(cerr); cerr << ")\n"); }
+	~State(void) { clear(); }
+
+	inline bool isBot(void) const { return def == Value::none; }
+	inline State& operator=(const State& state) { copy(state); return *this; }
+
+	void copy(const State& state) {
+		TRACED(cerr << "copy("; print(cerr); cerr << ", "; state.print(cerr); cerr << ") = ");
+		Node *old = root;
+		root = share(state.root);
+		def = state.def;
+		drop(old);
+		TRACED(print(cerr); cerr << io::endl);
+	}
+
+	void clear(void) {
+		drop(root);
+		root = 0;
+	}
+
+	void set(const Value& addr, const Value& val) {
+		TRACED(cerr << "set("; print(cerr); cerr << ", " << addr << ", " << val << ") = ");
+		if(def == Value::none) {
+			TRACED(print(cerr); cerr << io::endl);
+			return;
+		}
+		Node *old = root;
+
+		// consum all memory references
+		if(addr.kind() == ALL)
+			root = prefix(root);
+
+		// find a value
+		else {
+			const Node *cur = find(root, addr);
+			if(cur && val.kind() == ALL)
+				root = remove(root, addr);
+			else if(val.kind() != ALL && (!cur || cur->val != val))
+				root = insert(root, addr, val);
+			else
+				old = 0;
+		}
+
+		drop(old);
+		TRACED(print(cerr); cerr << io::endl);
+	}
+
+	bool equals(const State& state) const {
+		if(def.kind() != state.def.kind())
+			return false;
+		return equals(root, state.root);
+	}
+
+	void join(const State& state) {
+		TRACED(cerr << "join(\n\t"; print(cerr); cerr << ",\n\t";  state.print(cerr); cerr << "\n\t) = ");
+
+		// test none states
+		if(state.def == Value::none)
+			return;
+		if(def == Value::none) {
+			copy(state);
+			TRACED(print(cerr); cerr << io::endl;);
+			return;
+		}
+
+		Node *old = root;
+		root = join(root, state.root);
+		drop(old);
+		TRACED(print(cerr); cerr << io::endl;);
+	}
+
+	void print(io::Output& out) const {
+		if(def == Value::none)
+			out << '_';
+		else {
+			bool f =  true;
+			out << "{ ";
+			print(out, root, f);
+			out << " }";
+		}
+	}
+
+	Value fromImage(const Address& addr, Process *proc, int size) const {
+		switch(size) {
+		case 1: { t::uint8 v; proc->get(addr, v); return Value(CST, v); }
+		case 2: { t::uint16 v; proc->get(addr, v); return Value(CST, v); }
+		case 4: { t::uint32 v; proc->get(addr, v); return Value(CST, v); }
+		}
+		return def;
+	}
+
+	Value get(const Value& addr, Process *proc, int size) const {
+		const Node *cur = find(root, addr);
+		if(cur)
+			return cur->val;
+		if(addr.kind() == CST)
+			for(Process::FileIter file(proc); file(); file++)
+				for(File::SegIter seg(*file); seg(); seg++)
+					if(seg->contains(addr.value()))
+						return fromImage(addr.value(), proc, size);
+		return def;
+	}
+
+	static const State EMPTY, FULL;
+
+private:
+
+	// In the functions below, the parameter trees are borrowed
+	// while the returned trees are owned by the caller.
+
+	static inline Node *share(Node *n) { if(n) n->rc++; return n; }
+
+	static void drop(Node *n) {
+		while(n && !--n->rc) {
+			Node *r = n->right;
+			drop(n->left);
+			delete n;
+			n = r;
+		}
+	}
+
+	static const Node *find(const Node *n, const Value& addr) {
+		while(n && n->addr != addr)
+			n = addr < n->addr ? n->left : n->right;
+		return n;
+	}
+
+	static void split(Node *n, const Value& addr, Node *&l, Node *&r, Node *&found) {
+		if(!n) {
+			l = r = found = 0;
+		}
+		else if(n->addr == addr) {
+			l = share(n->left);
+			r = share(n->right);
+			found = n;
+		}
+		else if(n->addr < addr) {
+			Node *rl;
+			split(n->right, addr, rl, r, found);
+			l = new Node(n->addr, n->val, share(n->left), rl);
+		}
+		else {
+			Node *lr;
+			split(n->left, addr, l, lr, found);
+			r = new Node(n->addr, n->val, lr, share(n->right));
+		}
+	}
+
+	static Node *merge(Node *l, Node *r) {
+		if(!l)
+			return share(r);
+		else if(!r)
+			return share(l);
+		else if(l->above(r))
+			return new Node(l->addr, l->val, share(l->left), merge(l->right, r));
+		else
+			return new Node(r->addr, r->val, merge(l, r->left), share(r->right));
+	}
+
+	static Node *insert(Node *n, const Value& addr, const Value& val) {
+		Node *t = new Node(addr, val, 0, 0);
+		if(!n)
+			return t;
+		else if(n->addr == addr) {
+			t->left = share(n->left);
+			t->right = share(n->right);
+			return t;
+		}
+		else if(t->above(n)) {
+			Node *found;
+			split(n, addr, t->left, t->right, found);
+			return t;
+		}
+		delete t;
+		if(addr < n->addr)
+			return new Node(n->addr, n->val, insert(n->left, addr, val), share(n->right));
+		else
+			return new Node(n->addr, n->val, share(n->left), insert(n->right, addr, val));
+	}
+
+	static Node *remove(Node *n, const Value& addr) {
+		if(!n)
+			return 0;
+		else if(n->addr == addr)
+			return merge(n->left, n->right);
+		else if(addr < n->addr)
+			return new Node(n->addr, n->val, remove(n->left, addr), share(n->right));
+		else
+			return new Node(n->addr, n->val, share(n->left), remove(n->right, addr));
+	}
+
+	// keep only the register and SP-relative addresses (sorted before the others)
+	static Node *prefix(Node *n) {
+		if(!n)
+			return 0;
+		else if(n->addr.kind() > SP)
+			return prefix(n->left);
+		Node *r = prefix(n->right);
+		if(r == n->right) {
+			drop(r);
+			return share(n);
+		}
+		return new Node(n->addr, n->val, share(n->left), r);
+	}
+
+	static Node *join(Node *n1, Node *n2) {
+		if(n1 == n2)
+			return share(n1);
+		else if(!n1 || !n2)
+			return 0;
+
+		// join the sub-trees
+		Node *l2, *r2, *found;
+		split(n2, n1->addr, l2, r2, found);
+		Node *l = join(n1->left, l2), *r = join(n1->right, r2);
+		drop(l2);
+		drop(r2);
+
+		// join the values
+		Value val = n1->val;
+		if(found)
+			val.join(found->val);
+		if(!found || val.kind() == ALL) {
+			Node *res = merge(l, r);
+			drop(l);
+			drop(r);
+			return res;
+		}
+		else if(val == n1->val && l == n1->left && r == n1->right) {
+			drop(l);
+			drop(r);
+			return share(n1);
+		}
+		else
+			return new Node(n1->addr, val, l, r);
+	}
+
+	static bool equals(const Node *n1, const Node *n2) {
+		if(n1 == n2)
+			return true;
+		else if(!n1 || !n2)
+			return false;
+		else
+			return n1->addr == n2->addr && n1->val == n2->val
+				&& equals(n1->left, n2->left) && equals(n1->right, n2->right);
+	}
+
+	static void print(io::Output& out, const Node *n, bool& f) {
+		if(!n)
+			return;
+		print(out, n->left, f);
+		if(f)
+			f = false;
+		else
+			out << ", ";
+		out << n->addr << " = " << n->val;
+		print(out, n->right, f);
+	}
+
+	Node *root;
+	Value def;
+};
+
+} }	// otawa::stack
+
+#endif /* OTAWA_PROG_STACKSTATE_H_ */
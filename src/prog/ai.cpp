@@ -128,10 +128,11 @@ public:
  *
  * @section ai-method Method
  *
- * First, according to the program representation, developer has to choose a graph adapter. Currently, there is only two
+ * First, according to the program representation, developer has to choose a graph adapter. Currently, there are three
  * but more will be proposed in the near future:
  * * @ref CFGGraph -- to analyze a single CFG,
  * * @ref CFGCollectionGraph -- to analyze a set of CFGs representing a task (CFGs are calling each other).
+ * * @ref CSRGraph -- frozen and compact view of a task, faster to traverse for big CFG collections.
  *
  * Second, the abstract interpretation domain has to be designed. This is class providing the following resources:
  * @li empty constructor (for extend freedom in implementation of stage),
@@ -342,17 +343,36 @@ public:
  * in the adapter and uses a ranking function to organize vertices to process
  * the speed up the interpretation and convergence to the fix-point.
  *
+ * The vertices to process are stored in a work list whose policy is given
+ * by the W parameter: @ref HeapWorkList (default), @ref BucketWorkList or
+ * @ref SortedWorkList. Whatever the policy, vertices of smaller rank are
+ * processed first and, for the same rank, in insertion order.
+ *
  * @param A		Type of the adapter (must implement @ref AdapterConcept).
  * @param R		Type of the ranking function (must implement @ref RankingConcept).
+ * @param W		Type of the work list (must implement @ref RankedWorkListConcept).
  *
  * @ingroup ai
  */
 
 /**
- * @fn RankingAI::RankingAI(A& adapter, R& rank);
+ * @fn RankingAI::RankingAI(A& adapter, R& rank, bool dedup);
  * Build the abstract interpretation manager.
  * @param adapter	Adapter to use.
  * @param rank		Ranking function (default to @ref PropertyRanking).
+ * @param dedup		If true (default), a vertex already in the work list is not added again.
+ */
+
+/**
+ * @fn int RankingAI::visits(void) const;
+ * Get the number of vertex visits, that is, the number of vertex updates
+ * performed since the construction or the last call to resetVisits().
+ * @return	Number of visits.
+ */
+
+/**
+ * @fn void RankingAI::resetVisits(void);
+ * Reset the counter of vertex visits.
  */
 
 /**
@@ -513,6 +533,69 @@ p::interfaced_feature<CFGRanking> CFG_RANKING_FEATURE("otawa::ai::CFG_RANKING_FE
  */
 
 
+/**
+ * @class RankedWorkListConcept
+ * Concept of the work lists used by @ref RankingAI. The work list
+ * returns first the vertices of smaller rank and, for a same rank,
+ * in insertion order.
+ *
+ * @param G		Type of graph (must implement @ref GraphConcept).
+ * @ingroup ai
+ */
+
+/**
+ * @fn RankedWorkListConcept::RankedWorkListConcept(G& graph, bool dedup);
+ * Build the work list.
+ * @param graph		Graph the vertices comes from.
+ * @param dedup		If true, avoid duplicates in the work list.
+ */
+
+/**
+ * @fn bool RankedWorkListConcept::isEmpty(void) const;
+ * Test if the work list is empty.
+ * @return	True if it is empty, false else.
+ */
+
+/**
+ * @fn void RankedWorkListConcept::put(vertex_t v, int rank);
+ * Add a vertex to the work list.
+ * @param v		Added vertex.
+ * @param rank	Rank of the vertex.
+ */
+
+/**
+ * @fn vertex_t RankedWorkListConcept::get(void);
+ * Get and remove the vertex of smaller rank. It is an error to call this
+ * function on an empty work list.
+ * @return	Got vertex.
+ */
+
+/**
+ * @class SortedWorkList
+ * Ranked work list based on a sorted list: insertion is linear in the size
+ * of the list. Implements @ref RankedWorkListConcept.
+ * @param G		Graph type.
+ * @ingroup ai
+ */
+
+/**
+ * @class HeapWorkList
+ * Ranked work list based on a binary heap: insertion and retrieval are
+ * logarithmic in the size of the list. Implements @ref RankedWorkListConcept.
+ * @param G		Graph type.
+ * @ingroup ai
+ */
+
+/**
+ * @class BucketWorkList
+ * Ranked work list using a FIFO queue for each rank: insertion is performed
+ * in constant time and retrieval is amortized by the monotonic scan of the ranks.
+ * This is the best choice when ranks are small positive integers, as produced
+ * by @ref RANKING_FEATURE. Implements @ref RankedWorkListConcept.
+ * @param G		Graph type.
+ * @ingroup ai
+ */
+
 /**
  * @class SimpleWorkList
  * This class implements a very light and simple work list based on a list
@@ -0,0 +1,217 @@
+/*
+ *	CSRGraph class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <otawa/ai/CSRGraph.h>
+#include <otawa/cfg/CompositeCFG.h>
+
+namespace otawa { namespace ai {
+
+/**
+ * @class CSRGraph
+ * Frozen view of a CFG collection stored in compressed sparse row form.
+ * It presents the collection as @ref CompositeCFG does (calls are traversed,
+ * the limits between CFGs are hidden) but the graph is computed once
+ * and stored in contiguous arrays indexed by Block::id():
+ * @li the arcs are sorted by source block, so the successors of a block
+ * are a contiguous range of arcs,
+ * @li the predecessors of a block are a contiguous range of arc indexes,
+ * @li each arc records its source, sink, original edge and whether
+ * it is a call or a return.
+ *
+ * Walking the successors or predecessors of a block is then a linear scan
+ * that does not allocate nor dereference the blocks and edges of the CFG.
+ * This makes the fixpoint computations on big collections much less
+ * sensitive to the memory latency than with CompositeCFG.
+ *
+ * The arcs are the ones of CompositeCFG::preds() for the blocks reached
+ * from the task entry; the edge of an arc is the edge returned by this
+ * iterator. As the view is frozen, it must be rebuilt if the CFG
+ * collection is modified.
+ *
+ * This class implements the graph and indexed concepts of @ref ai and may
+ * be used with the analysis drivers, like SimpleAI or RankingAI, and
+ * with ArrayStore. The arcs are also indexed (index(edge_t)), allowing
+ * to store per-arc information in plain arrays.
+ *
+ * @ingroup ai
+ */
+
+/**
+ * @class CSRGraph::Arc
+ * Arc of a @ref CSRGraph.
+ */
+
+/**
+ * @fn Block *CSRGraph::Arc::source(void) const;
+ * Get the source block of the arc.
+ * @return	Source block.
+ */
+
+/**
+ * @fn Edge *CSRGraph::Arc::edge(void) const;
+ * Get the original CFG edge of the arc.
+ * @return	Arc edge.
+ */
+
+/**
+ * @fn Block *CSRGraph::Arc::sink(void) const;
+ * Get the sink block of the arc.
+ * @return	Sink block.
+ */
+
+/**
+ * @fn bool CSRGraph::Arc::isCall(void) const;
+ * Test if the arc enters a called CFG.
+ * @return	True if the arc is a call, false else.
+ */
+
+/**
+ * @fn bool CSRGraph::Arc::isReturn(void) const;
+ * Test if the arc leaves a called CFG.
+ * @return	True if the arc is a return, false else.
+ */
+
+/**
+ * Build the graph.
+ * @param coll	CFG collection of the task.
+ */
+CSRGraph::CSRGraph(const CFGCollection& coll)
+:	_coll(coll),
+	_entry(coll.entry()->entry()),
+	_exit(coll.entry()->exit()),
+	_blocks(coll.countBlocks()),
+	_reached(coll.countBlocks()),
+	_out_start(coll.countBlocks() + 1),
+	_in_start(coll.countBlocks() + 1)
+{
+	int n = _blocks.count();
+	_reached.fill(false);
+	_out_start.fill(0);
+	_in_start.fill(0);
+	for(CFGCollection::BlockIter v(&coll); v(); v++)
+		_blocks[v->id()] = *v;
+
+	// find the blocks reached from the entry
+	CompositeCFG g(coll);
+	Vector<Block *> todo;
+	todo.push(_entry);
+	_reached[_entry->id()] = true;
+	while(todo) {
+		Block *v = todo.pop();
+		for(auto e = g.succs(v); e(); e++) {
+			Block *w = g.sinkOf(*e);
+			if(!_reached[w->id()]) {
+				_reached[w->id()] = true;
+				todo.push(w);
+			}
+		}
+	}
+
+	// count the arcs by source and by sink
+	for(int i = 0; i < n; i++)
+		if(_reached[i])
+			for(auto e = g.preds(_blocks[i]); e(); e++) {
+				_out_start[e->source()->id() + 1]++;
+				_in_start[i + 1]++;
+			}
+	for(int i = 0; i < n; i++) {
+		_out_start[i + 1] += _out_start[i];
+		_in_start[i + 1] += _in_start[i];
+	}
+
+	// record the arcs
+	_arcs = AllocArray<Arc>(_out_start[n]);
+	_in = AllocArray<int>(_in_start[n]);
+	AllocArray<int> oc(_out_start), ic(_in_start);
+	for(int i = 0; i < n; i++)
+		if(_reached[i])
+			for(auto e = g.preds(_blocks[i]); e(); e++) {
+				int k = oc[e->source()->id()]++;
+				Arc& a = _arcs[k];
+				a._source = e->source();
+				a._edge = *e;
+				a._sink = _blocks[i];
+				a._flags = 0;
+				if(e->sink()->isCall() || (e->source()->isEntry() && e->source() != _entry))
+					a._flags |= Arc::CALL;
+				if(e->source()->isCall() || (e->sink()->isExit() && e->sink() != _exit))
+					a._flags |= Arc::RETURN;
+				_in[ic[i]++] = k;
+			}
+}
+
+/**
+ * @fn const CFGCollection& CSRGraph::collection(void) const;
+ * Get the CFG collection the graph is built from.
+ * @return	CFG collection.
+ */
+
+/**
+ * @fn bool CSRGraph::isCall(edge_t e) const;
+ * Test if an arc enters a called CFG (same definition as CompositeCFG).
+ * @param e		Tested arc.
+ * @return		True if e is a call, false else.
+ */
+
+/**
+ * @fn bool CSRGraph::isReturn(edge_t e) const;
+ * Test if an arc leaves a called CFG (same definition as CompositeCFG).
+ * @param e		Tested arc.
+ * @return		True if e is a return, false else.
+ */
+
+/**
+ * @fn bool CSRGraph::isReached(vertex_t v) const;
+ * Test if a block is reached from the task entry.
+ * @param v		Tested block.
+ * @return		True if v is reached, false else.
+ */
+
+/**
+ * @fn vertex_t CSRGraph::vertex(int i) const;
+ * Get a block by its index.
+ * @param i		Block index (as returned by index(vertex_t)).
+ * @return		Matching block.
+ */
+
+/**
+ * @fn edge_t CSRGraph::arc(int i) const;
+ * Get an arc by its index.
+ * @param i		Arc index (as returned by index(edge_t)).
+ * @return		Matching arc.
+ */
+
+/**
+ * @fn int CSRGraph::index(edge_t e) const;
+ * Get the index of an arc.
+ * @param e		Arc to get index for.
+ * @return		Arc index in [0, countArcs()[.
+ */
+
+/**
+ * @fn int CSRGraph::countArcs(void) const;
+ * Get the number of arcs.
+ * @return	Arc count.
+ */
+
+} }	// otawa::ai
@@ -20,10 +20,12 @@
  */
 
 #include <elm/io/ansi.h>
+#include <elm/io/OutFileStream.h>
 #include <elm/sys/System.h>
 #include <otawa/app/Application.h>
 #include <otawa/cfgio/Output.h>
 #include <otawa/proc/ProcessorPlugin.h>
+#include <otawa/proc/Profiler.h>
 #include <otawa/stats/features.h>
 #include <otawa/util/SymAddress.h>
 #include <otawa/prog/Manager.h>
@@ -299,9 +301,12 @@ Application::Application(const Make& make):
 	log_for(option::ListOption<string>::Make(this).cmd("--log-for").help("only apply logging to the given processor")),
 	dump_for(option::ListOption<string>::Make(this).cmd("--dump-for").help("dump results of the named analyzes").arg("ANALYSIS NAME")),
 	view(option::SwitchOption::Make(*this).cmd("-W").cmd("--views").description("Dump views of the executable.")),
+	profile(option::SwitchOption::Make(*this).cmd("--profile").description("display a profile of the run processors")),
+	profile_trace(option::Value<string>::Make(*this).cmd("--profile-trace").description("output the profile of the run processors as a Chrome trace to PATH").arg("PATH")),
 	log_level(*this),
 	props2(0),
-	ws(0)
+	ws(0),
+	prof(nullptr)
 { }
 
 
@@ -408,6 +413,12 @@ void Application::run() {
 		if(work_dir)
 			ws->workDir(*work_dir);
 
+		// if required, install the profiler
+		if(profile || profile_trace) {
+			prof = new Profiler();
+			PROFILER(ws) = prof;
+		}
+
 		// if required, load the flowfacts
 		if(ff)
 			for(int i = 0; i < ff.count(); i++)
@@ -419,10 +430,27 @@ void Application::run() {
 		work(props);
 		complete(props);
 
+		// output the profile
+		if(prof != nullptr) {
+			if(profile)
+				prof->printSummary(cerr);
+			if(profile_trace) {
+				io::OutFileStream out(elm::sys::Path(*profile_trace));
+				if(!out.isReady())
+					error(_ << "cannot open " << *profile_trace << ": " << out.lastErrorMessage());
+				else {
+					io::Output output(out);
+					prof->printTrace(output);
+				}
+			}
+		}
+
 
 	// cleanup
 	if(ws)
 		delete ws;
+	if(prof != nullptr)
+		delete prof;
 }
 
 
@@ -21,6 +21,7 @@
 
 #include <otawa/prog/Process.h>
 #include <otawa/app/CFGApplication.h>
+#include <otawa/prog/Snapshot.h>
 #include <otawa/view/features.h>
 
 namespace otawa {
@@ -41,6 +42,8 @@ namespace otawa {
  *	* --virtualize -- replace each call to a function by a duplication of its CFG
  *		(improve the analysis precision but increase also the computation time).
  *	* --unroll-loops -- peel out the first iteration of each loop.
+ *	* --cfg-snapshot PATH -- restore the prepared CFGs from the snapshot PATH if it matches
+ *		the program and the task, else record them to PATH (see @ref snapshot).
  *
  * @ingroup application
  */
@@ -52,7 +55,9 @@ CFGApplication::CFGApplication(const Make& make)
 		cfg_raw(make_switch().cmd("--cfg-raw").help("do not perform any CFG transformation to support architecture features")),
 		cfg_virtualize(make_switch().cmd("--cfg-virtualize").help("duplicate called CFG according to their call sites")),
 		cfg_unroll(make_switch().cmd("--cfg-unroll").help("unroll the first iteration of each loop")),
-		no_cfg_tune(option::SwitchOption::Make(*this).cmd("--cfg-no-tune").description("disable tuning of CFGs for more user friendly work"))
+		no_cfg_tune(option::SwitchOption::Make(*this).cmd("--cfg-no-tune").description("disable tuning of CFGs for more user friendly work")),
+		cfg_snapshot(option::Value<string>::Make(*this).cmd("--cfg-snapshot").description("restore the CFGs from or record them to a snapshot").arg("PATH")),
+		restored(false)
 { }
 
 
@@ -71,6 +76,8 @@ void CFGApplication::processTask(const CFGCollection& coll, PropList& props) {
 void CFGApplication::work(const string& entry, PropList &props) {
 	prepareCFG(entry, props);
 	processTask(*COLLECTED_CFG_FEATURE.get(workspace()), props);
+	if(cfg_snapshot && !restored)
+		workspace()->run<SnapshotSaver>(props);
 }
 
 /**
@@ -84,6 +91,17 @@ void CFGApplication::prepareCFG(const string& entry, PropList& props) {
 	if(workspace()->isProvided(COLLECTED_CFG_FEATURE))
 		workspace()->invalidate(COLLECTED_CFG_FEATURE);
 
+	// restore the snapshot if any
+	restored = false;
+	if(cfg_snapshot) {
+		SNAPSHOT_PATH(props) = elm::sys::Path(*cfg_snapshot);
+		if(SnapshotLoader::matches(workspace(), *cfg_snapshot, parseAddress(entry))) {
+			workspace()->run<SnapshotLoader>(props);
+			restored = true;
+			return;
+		}
+	}
+
 	// tune the CFGs
 	if(!no_cfg_tune) {
 		Inst *i = workspace()->process()->findInstAt("__stack_chk_fail");
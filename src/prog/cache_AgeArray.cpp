@@ -0,0 +1,242 @@
+/*
+ *	cache::AgePool and cache::AgeArray classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <string.h>
+#include <new>
+#include <otawa/cache/cat2/AgeArray.h>
+
+namespace otawa { namespace cache {
+
+// minimal size of a slab in bytes
+static const int SLAB_SIZE = 16 * 1024;
+
+
+/**
+ * @class AgePool
+ * Slab allocator for the age arrays of the CAT2 ACS (@ref AgeArray).
+ * All chunks of a pool have the same size: they are cut in big slabs
+ * and recycled through a free list instead of going back to the system heap.
+ *
+ * A pool is reference-counted: it is locked by its creator and by
+ * each allocated array and released when the last of them unlocks it.
+ * This way, the ACS stored as results of the analysis can outlive
+ * the problem that created the pool.
+ *
+ * The reference counter is atomic and the free list is protected by a mutex
+ * so that the stored ACS may be copied and modified by concurrent consumers.
+ *
+ * @ingroup cache
+ */
+
+/**
+ * Build a pool for arrays of the given size. The pool is initially locked once.
+ * @param size	Number of ages in the arrays.
+ */
+AgePool::AgePool(int size): _size(size), _chunk(AgeArray::storage(size)), _refs(1), _free(nullptr) {
+}
+
+/**
+ */
+AgePool::~AgePool(void) {
+	for(auto s: _slabs)
+		delete [] s;
+}
+
+/**
+ * @fn int AgePool::size(void) const;
+ * Get the number of ages of the arrays allocated in this pool.
+ * @return	Array size.
+ */
+
+/**
+ * @fn void AgePool::lock(void);
+ * Lock the pool, preventing it to be freed.
+ */
+
+/**
+ * @fn void AgePool::unlock(void);
+ * Unlock the pool that is freed when it is no more locked.
+ */
+
+/**
+ * Allocate a chunk from the pool.
+ * @return	Allocated chunk.
+ */
+void *AgePool::allocate(void) {
+	std::lock_guard<std::mutex> guard(_mutex);
+	if(_free == nullptr) {
+		int n = SLAB_SIZE / _chunk;
+		if(n < 16)
+			n = 16;
+		char *s = new char[n * _chunk];
+		_slabs.add(s);
+		for(int i = n - 1; i >= 0; i--) {
+			*reinterpret_cast<void **>(s + i * _chunk) = _free;
+			_free = s + i * _chunk;
+		}
+	}
+	void *p = _free;
+	_free = *static_cast<void **>(p);
+	lock();
+	return p;
+}
+
+/**
+ * Give back a chunk to the pool.
+ * @param p		Released chunk.
+ */
+void AgePool::release(void *p) {
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+		*static_cast<void **>(p) = _free;
+		_free = p;
+	}
+	unlock();
+}
+
+
+/**
+ * @class AgeArray
+ * Compact array of cache block ages used by the CAT2 ACS (@ref MUSTProblem,
+ * @ref PERSProblem and @ref MAYProblem). Ages are stored as 8-bit integers
+ * (-1 represents a block not in the cache) and copies share the same storage
+ * until one of them is modified (copy-on-write). As most abstract states
+ * of an analysis are copies of their predecessor state, this avoids both
+ * the copy and the allocation.
+ *
+ * The storage is taken from an @ref AgePool if one is given, from the heap else.
+ * Its reference counter is atomic: arrays sharing a storage may be copied,
+ * modified or destroyed from different threads, but a single AgeArray object
+ * must not be used concurrently.
+ *
+ * @ingroup cache
+ */
+
+/**
+ * Build an array.
+ * @param size	Number of ages.
+ * @param init	Initial value of the ages.
+ * @param pool	Pool to allocate from (null for the heap).
+ */
+AgeArray::AgeArray(int size, int init, AgePool *pool): _b(make(size, pool)) {
+	::memset(ages(_b), init, size);
+}
+
+/**
+ * @fn int AgeArray::count(void) const;
+ * Get the number of ages.
+ * @return	Array size.
+ */
+
+/**
+ * @fn AgePool *AgeArray::pool(void) const;
+ * Get the pool the storage of the array comes from.
+ * @return	Array pool (null for the heap).
+ */
+
+/**
+ * @fn int AgeArray::operator[](int i) const;
+ * Get an age.
+ * @param i		Age index.
+ * @return		Age at index i.
+ */
+
+/**
+ * @fn bool AgeArray::shares(const AgeArray& a) const;
+ * Test if both arrays share the same storage (and are therefore equal).
+ * @param a		Array to test with.
+ * @return		True if they share the storage, false else.
+ */
+
+/**
+ * @fn age_t *AgeArray::write(void);
+ * Get a writable access to the ages, copying the storage if it is shared.
+ * @return	Pointer to the ages.
+ */
+
+/**
+ * @fn void AgeArray::set(int i, int a);
+ * Set an age. The storage is only copied if the age actually changes.
+ * @param i		Age index.
+ * @param a		New age.
+ */
+
+/**
+ * Test if two arrays contains the same ages.
+ * @param a		Array to compare with.
+ * @return		True if they are equal, false else.
+ */
+bool AgeArray::equals(const AgeArray& a) const {
+	ASSERT(_b->size == a._b->size);
+	return _b == a._b || ::memcmp(ages(_b), ages(a._b), _b->size) == 0;
+}
+
+/**
+ * Set all ages to the same value.
+ * @param a		Set value.
+ */
+void AgeArray::fill(int a) {
+	if(_b->refs > 1) {
+		buf_t *b = _b;
+		_b = make(b->size, b->pool);
+		drop(b);
+	}
+	::memset(ages(_b), a, _b->size);
+}
+
+// size in bytes of a storage (rounded to keep pool chunks aligned)
+int AgeArray::storage(int size) {
+	return (sizeof(buf_t) + size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+}
+
+// allocate a storage
+AgeArray::buf_t *AgeArray::make(int size, AgePool *pool) {
+	buf_t *b;
+	if(pool == nullptr)
+		b = static_cast<buf_t *>(::operator new(sizeof(buf_t) + size));
+	else {
+		ASSERT(pool->size() == size);
+		b = static_cast<buf_t *>(pool->allocate());
+	}
+	new(&b->refs) std::atomic<int>(1);
+	b->size = size;
+	b->pool = pool;
+	return b;
+}
+
+// release a storage
+void AgeArray::free(buf_t *b) {
+	if(b->pool == nullptr)
+		::operator delete(b);
+	else
+		b->pool->release(b);
+}
+
+// copy the shared storage to get a private one
+void AgeArray::detach(void) {
+	buf_t *b = make(_b->size, _b->pool);
+	::memcpy(ages(b), ages(_b), _b->size);
+	drop(_b);
+	_b = b;
+}
+
+} }	// otawa::cache
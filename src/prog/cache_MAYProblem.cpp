@@ -52,20 +52,21 @@ namespace otawa {
 
 	
 MAYProblem::MAYProblem(const int _size, LBlockSet *_lbset, WorkSpace *_fw, const hard::Cache *_cache, const int _A) 
-:	lbset(_lbset),
+:	_pool(new cache::AgePool(_size)),
+	lbset(_lbset),
 	fw(_fw),
 	line(lbset->line()),
 	cache(_cache),
-	bot(_size, _A),
-	_top(_size, 0),
-	ent(_size, _A),
-	callstate(_size, _A)
+	bot(_size, _A, _pool),
+	_top(_size, 0, _pool),
+	ent(_size, _A, _pool),
+	callstate(_size, _A, _pool)
 {
 		ent.empty();
 }
 	
 MAYProblem::~MAYProblem() {
-	
+	_pool->unlock();
 }
 const MAYProblem::Domain& MAYProblem::bottom(void) const {
 		return bot;
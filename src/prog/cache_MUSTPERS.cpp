@@ -89,9 +89,9 @@ namespace otawa {
 MUSTPERS::MUSTPERS(const int _size, LBlockSet *_lbset, WorkSpace *_fw, const hard::Cache *_cache, const int _A) 
 :	mustProb(_size, _lbset, _fw, _cache, _A),
 	persProb(_size, _lbset, _fw, _cache, _A),
-	bot(_size, _A),
-	_top(_size, _A),
-	ent(_size, _A),
+	bot(_size, _A, mustProb.pool()),
+	_top(_size, _A, mustProb.pool()),
+	ent(_size, _A, mustProb.pool()),
 	line(_lbset->line())
 {
 		
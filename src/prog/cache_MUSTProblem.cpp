@@ -35,20 +35,21 @@ namespace otawa {
 
 	
 MUSTProblem::MUSTProblem(const int _size, LBlockSet *_lbset, WorkSpace *_fw, const hard::Cache *_cache, const int _A) 
-:	lbset(_lbset),
+:	_pool(new cache::AgePool(_size)),
+	lbset(_lbset),
 	fw(_fw),
 	line(lbset->line()),
 	cache(_cache), 
-	bot(_size, _A),
-	_top(_size, _A),
-	ent(_size, _A),
-	callstate(_size, _A)
+	bot(_size, _A, _pool),
+	_top(_size, _A, _pool),
+	ent(_size, _A, _pool),
+	callstate(_size, _A, _pool)
 {
 		ent.empty();	
 }
 	
 MUSTProblem::~MUSTProblem() {
-	
+	_pool->unlock();
 }
 const MUSTProblem::Domain& MUSTProblem::bottom(void) const {
 		return bot;
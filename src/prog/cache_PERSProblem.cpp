@@ -35,12 +35,13 @@ namespace otawa {
 
 	
 PERSProblem::PERSProblem(const int _size, LBlockSet *_lbset, WorkSpace *_fw, const hard::Cache *_cache, const int _A) 
-:	callstate(_size, _A),
+:	_pool(new cache::AgePool(_size)),
+	callstate(_size, _A, _pool),
 	lbset(_lbset),
 	fw(_fw),
 	cache(_cache),
-	bot(_size, _A),
-	ent(_size, _A),
+	bot(_size, _A, _pool),
+	ent(_size, _A, _pool),
 	line(lbset->line())
 {
 		bot.setToBottom();
@@ -53,7 +54,7 @@ PERSProblem::PERSProblem(const int _size, LBlockSet *_lbset, WorkSpace *_fw, con
 }
 	
 PERSProblem::~PERSProblem() {
-
+	_pool->unlock();
 }
 const PERSProblem::Domain& PERSProblem::bottom(void) const {
 		return bot;
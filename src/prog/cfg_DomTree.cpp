@@ -0,0 +1,272 @@
+/*
+ *	DomTree class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2020, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <otawa/cfg/DomTree.h>
+
+namespace otawa {
+
+/**
+ * @class DomTree
+ * Dominator tree of a CFG. The immediate dominators are computed with the
+ * algorithm of Cooper, Harvey and Kennedy:
+ *
+ * K. D. Cooper, T. J. Harvey, K. Kennedy. A Simple, Fast Dominance Algorithm.
+ * Software Practice & Experience, 4:1-10, 2001.
+ *
+ * The tree is then numbered in pre-order and post-order so that
+ * the dominance test is performed in constant time:
+ * b1 dom b2 ⟺ pre(b1) ≤ pre(b2) ∧ post(b2) ≤ post(b1).
+ *
+ * The memory used is linear in the number of blocks. A block that cannot be
+ * reached from the root (entry for dominance, exit for post-dominance)
+ * has no immediate dominator and only dominates (and is dominated by) itself.
+ *
+ * @ingroup cfg
+ */
+
+/**
+ * Build the dominator tree.
+ * @param cfg	CFG to build the tree for.
+ * @param post	If true, build the post-dominator tree (rooted at the exit block).
+ */
+DomTree::DomTree(CFG *cfg, bool post)
+:	_cfg(cfg),
+	_post_dom(post),
+	_root(post ? cfg->exit() : cfg->entry()),
+	_idom(cfg->count()),
+	_pre(cfg->count()),
+	_post(cfg->count()),
+	_depth(cfg->count())
+{
+	int n = cfg->count();
+	_idom.fill(nullptr);
+	_pre.fill(-1);
+	_post.fill(-1);
+	_depth.fill(-1);
+
+	// build the successor and predecessor arrays (of the reversed graph for post-dominance)
+	AllocArray<Block *> blocks(n);
+	AllocArray<int> soff(n + 1), poff(n + 1);
+	soff.fill(0);
+	poff.fill(0);
+	for(CFG::BlockIter v(cfg->blocks()); v(); v++) {
+		blocks[v->index()] = *v;
+		soff[v->index() + 1] = post ? v->countIns() : v->countOuts();
+		poff[v->index() + 1] = post ? v->countOuts() : v->countIns();
+	}
+	for(int i = 0; i < n; i++) {
+		soff[i + 1] += soff[i];
+		poff[i + 1] += poff[i];
+	}
+	AllocArray<int> succs(soff[n]), preds(poff[n]);
+	for(int i = 0; i < n; i++) {
+		int s = soff[i], p = poff[i];
+		for(Block::EdgeIter e(blocks[i]->outs()); e(); e++)
+			if(post)
+				preds[p++] = e->sink()->index();
+			else
+				succs[s++] = e->sink()->index();
+		for(Block::EdgeIter e(blocks[i]->ins()); e(); e++)
+			if(post)
+				succs[s++] = e->source()->index();
+			else
+				preds[p++] = e->source()->index();
+	}
+
+	// compute the post-order (iterative DFS)
+	int r = _root->index();
+	AllocArray<int> po(n), next(n);
+	po.fill(-1);
+	next.fill(-1);
+	Vector<int> order, stack;
+	stack.push(r);
+	next[r] = soff[r];
+	while(stack) {
+		int v = stack.top();
+		if(next[v] < soff[v + 1]) {
+			int w = succs[next[v]++];
+			if(next[w] < 0) {
+				next[w] = soff[w];
+				stack.push(w);
+			}
+		}
+		else {
+			stack.pop();
+			po[v] = order.length();
+			order.add(v);
+		}
+	}
+
+	// compute the immediate dominators in reverse post-order
+	AllocArray<int> idom(n);
+	idom.fill(-1);
+	idom[r] = r;
+	bool changed = true;
+	while(changed) {
+		changed = false;
+		for(int i = order.length() - 2; i >= 0; i--) {
+			int v = order[i];
+			int d = -1;
+			for(int j = poff[v]; j < poff[v + 1]; j++) {
+				int p = preds[j];
+				if(idom[p] < 0)
+					continue;
+				if(d < 0)
+					d = p;
+				else {
+					int f1 = p, f2 = d;
+					while(f1 != f2) {
+						while(po[f1] < po[f2])
+							f1 = idom[f1];
+						while(po[f2] < po[f1])
+							f2 = idom[f2];
+					}
+					d = f1;
+				}
+			}
+			if(d != idom[v]) {
+				idom[v] = d;
+				changed = true;
+			}
+		}
+	}
+
+	// build the tree
+	AllocArray<int> coff(n + 1), child(n);
+	coff.fill(0);
+	for(int i = 0; i < order.length(); i++) {
+		int v = order[i];
+		if(v != r) {
+			_idom[v] = blocks[idom[v]];
+			coff[idom[v] + 1]++;
+		}
+	}
+	for(int i = 0; i < n; i++)
+		coff[i + 1] += coff[i];
+	AllocArray<int> cnext(n + 1);
+	for(int i = 0; i <= n; i++)
+		cnext[i] = coff[i];
+	for(int i = order.length() - 1; i >= 0; i--) {
+		int v = order[i];
+		if(v != r)
+			child[cnext[idom[v]]++] = v;
+	}
+
+	// number the tree in pre-order and post-order
+	int pre_cnt = 0, post_cnt = 0;
+	stack.push(r);
+	_pre[r] = pre_cnt++;
+	_depth[r] = 0;
+	for(int i = 0; i <= n; i++)
+		cnext[i] = coff[i];
+	while(stack) {
+		int v = stack.top();
+		if(cnext[v] < coff[v + 1]) {
+			int w = child[cnext[v]++];
+			_pre[w] = pre_cnt++;
+			_depth[w] = _depth[v] + 1;
+			stack.push(w);
+		}
+		else {
+			stack.pop();
+			_post[v] = post_cnt++;
+		}
+	}
+}
+
+/**
+ * @fn CFG *DomTree::cfg(void) const;
+ * Get the CFG of the tree.
+ * @return	Tree CFG.
+ */
+
+/**
+ * @fn bool DomTree::isPost(void) const;
+ * Test if the tree is a post-dominance tree.
+ * @return	True if it is a post-dominance tree, false else.
+ */
+
+/**
+ * @fn Block *DomTree::root(void) const;
+ * Get the root of the tree, that is, the entry block for dominance
+ * and the exit block for post-dominance.
+ * @return	Root block.
+ */
+
+/**
+ * @fn bool DomTree::isReachable(Block *b) const;
+ * Test if the block is reachable from the root of the tree.
+ * @param b		Tested block.
+ * @return		True if b is reachable, false else.
+ */
+
+/**
+ * @fn Block *DomTree::idom(Block *b) const;
+ * Get the immediate dominator (or post-dominator) of a block.
+ * @param b		Block to look for.
+ * @return		Immediate dominator or null for the root or an unreachable block.
+ */
+
+/**
+ * @fn bool DomTree::dom(Block *b1, Block *b2) const;
+ * Test in constant time if b1 dominates (or post-dominates) b2.
+ * Both blocks must belong to the CFG of the tree.
+ * @param b1	Dominator block.
+ * @param b2	Dominated block.
+ * @return		True if b1 dominates b2, false else.
+ */
+
+/**
+ * @fn int DomTree::depth(Block *b) const;
+ * Get the depth of a block in the tree.
+ * @param b		Looked block.
+ * @return		Depth (0 for the root) or -1 if the block is unreachable.
+ */
+
+
+/**
+ * Dominator tree hooked to a CFG.
+ *
+ * @par Hooks
+ * @li @ref CFG
+ *
+ * @par Features
+ * @li @ref DOMINANCE_FEATURE
+ *
+ * @ingroup cfg
+ */
+p::id<DomTree *> DOM_TREE("otawa::DOM_TREE", nullptr);
+
+/**
+ * Post-dominator tree hooked to a CFG.
+ *
+ * @par Hooks
+ * @li @ref CFG
+ *
+ * @par Features
+ * @li @ref POSTDOMINANCE_FEATURE
+ *
+ * @ingroup cfg
+ */
+p::id<DomTree *> POSTDOM_TREE("otawa::POSTDOM_TREE", nullptr);
+
+}	// otawa
@@ -29,6 +29,7 @@
 #include <otawa/dfa/IterativeDFA.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/proc/BBProcessor.h>
+#include <otawa/proc/ConcurrentCFGProcessor.h>
 
 using namespace elm;
 using namespace otawa;
@@ -85,15 +86,15 @@ private:
  * @par Statistics
  * none
  */
-class LoopInfoBuilder: public CFGProcessor {
+class LoopInfoBuilder: public ConcurrentCFGProcessor {
 public:
 	static p::declare reg;
 	LoopInfoBuilder();
 protected:
+	void setup(WorkSpace *ws) override;
 	void processCFG(otawa::WorkSpace*, otawa::CFG*) override;
 private:
 	void buildLoopExitList(otawa::CFG* cfg);
-	bool fst;
 };
 
 
@@ -326,7 +327,14 @@ p::declare LoopInfoBuilder::reg =
 
 /* Constructors/Methods for LoopInfoBuilder */
 
-LoopInfoBuilder::LoopInfoBuilder(): CFGProcessor(reg), fst(true) {
+LoopInfoBuilder::LoopInfoBuilder(): ConcurrentCFGProcessor(reg) {
+}
+
+
+/**
+ */
+void LoopInfoBuilder::setup(WorkSpace *ws) {
+	addCleaner(LOOP_INFO_FEATURE, new LoopInfoCleaner(ws));
 }
 
 
@@ -404,11 +412,6 @@ void LoopInfoBuilder::processCFG(otawa::WorkSpace* fw, otawa::CFG* cfg) {
 
 	// build loop exit lists
 	buildLoopExitList(cfg);
-
-	if(fst) { // only add the cleaner for the first time
-		addCleaner(LOOP_INFO_FEATURE, new LoopInfoCleaner(fw));
-		fst = false;
-	}
 }
 
 }	// otawa
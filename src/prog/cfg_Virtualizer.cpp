@@ -81,6 +81,187 @@ Identifier<bool> INLINING_POLICY("otawa::INLINING_POLICY");
 Identifier<bool> VIRTUAL_DEFAULT("otawa::VIRTUAL_DEFAULT", true);
 
 
+/**
+ * Configuration property of @ref Virtualizer: if set to true (default to false),
+ * the inlined functions are not copied at each call site. Instead, each function
+ * is built only once and shared by all its call sites while the inlining
+ * contexts are recorded as lightweight @ref VirtualContext objects hooked
+ * to the CFGs with @ref VIRTUAL_CONTEXTS. This avoids the explosion
+ * of the number of blocks for deep call trees: the resulting collection
+ * has the size of the non-inlined one.
+ *
+ * In this mode, the inlining policy (@ref NO_INLINE, @ref INLINING_POLICY)
+ * is evaluated without context and the CFGs are not marked with
+ * a @ref CONTEXT: per-context information has to be recorded on the
+ * @ref VirtualContext objects (VirtualContext::props()) or looked up
+ * with VirtualContext::path().
+ *
+ * @ref ipet::FlowFactLoader records the contextual loop bounds on the
+ * contexts and bounds each shared loop with the loosest of them.
+ * The other analyses provided with OTAWA (cache analyses, IPET, etc)
+ * do not read the @ref VirtualContext objects: for them, the shared CFG
+ * stands for all its contexts.
+ *
+ * @par Hooks
+ * @li Configuration of @ref Virtualizer code processor.
+ */
+Identifier<bool> VIRTUAL_SHARING("otawa::VIRTUAL_SHARING", false);
+
+
+/**
+ * In the sharing mode of @ref Virtualizer (@ref VIRTUAL_SHARING),
+ * first inlining context of a CFG; the other contexts are obtained
+ * with VirtualContext::next().
+ *
+ * @par Hooks
+ * @li @ref CFG
+ *
+ * @par Features
+ * @li @ref VIRTUALIZED_CFG_FEATURE
+ */
+p::id<VirtualContext *> VIRTUAL_CONTEXTS("otawa::VIRTUAL_CONTEXTS", nullptr);
+
+// marks the calls inlined in the sharing mode
+static p::id<bool> SHARED_CALL("", false);
+
+
+/**
+ * @class VirtualContext
+ * In the sharing mode of @ref Virtualizer (@ref VIRTUAL_SHARING), represents
+ * an inlining context of a CFG, that is, the string of inlined calls leading
+ * to the CFG. A pair (context, block) of the CFG stands for the block copy
+ * the usual virtualization would have created. As a property list,
+ * the context can be used to store per-context information.
+ *
+ * The contexts of a CFG are obtained from @ref VIRTUAL_CONTEXTS.
+ *
+ * @ingroup cfg
+ */
+
+/**
+ * Build a context.
+ * @param cfg		CFG of the context.
+ * @param caller	Context of the calling CFG (null for a root context).
+ * @param call		Block performing the call in the calling CFG (null for a root context).
+ */
+VirtualContext::VirtualContext(CFG *cfg, VirtualContext *caller, SynthBlock *call)
+:	_cfg(cfg),
+	_caller(caller),
+	_call(call),
+	_next(VIRTUAL_CONTEXTS(cfg)),
+	_depth(caller == nullptr ? 0 : caller->depth() + 1)
+{
+	VIRTUAL_CONTEXTS(cfg) = this;
+}
+
+/**
+ */
+VirtualContext::~VirtualContext(void) {
+	for(HashMap<Block *, PropList *>::Iter p(_props); p(); p++)
+		delete *p;
+}
+
+/**
+ * @fn CFG *VirtualContext::cfg(void) const;
+ * Get the CFG of the context.
+ * @return	Context CFG.
+ */
+
+/**
+ * @fn VirtualContext *VirtualContext::caller(void) const;
+ * Get the context of the calling CFG.
+ * @return	Caller context or null for a root context.
+ */
+
+/**
+ * @fn SynthBlock *VirtualContext::call(void) const;
+ * Get the block performing the call in the calling CFG.
+ * @return	Call block or null for a root context.
+ */
+
+/**
+ * @fn VirtualContext *VirtualContext::next(void) const;
+ * Get the next context of the same CFG.
+ * @return	Next context or null.
+ */
+
+/**
+ * @fn int VirtualContext::depth(void) const;
+ * Get the number of inlined calls leading to the context.
+ * @return	Context depth (0 for a root context).
+ */
+
+/**
+ * Test if the given CFG is part of the context (used to detect recursive calls).
+ * @param cfg	Looked CFG.
+ * @return		True if cfg is in the call string, false else.
+ */
+bool VirtualContext::isIn(CFG *cfg) const {
+	for(const VirtualContext *c = this; c != nullptr; c = c->_caller)
+		if(c->_cfg == cfg)
+			return true;
+	return false;
+}
+
+/**
+ * Build the contextual path matching the context, as used
+ * by the copying virtualization to look up contextual properties.
+ * @return	Context path.
+ */
+ContextualPath VirtualContext::path(void) const {
+	ContextualPath p;
+	if(_caller != nullptr) {
+		p = _caller->path();
+		if(_call->caller()->type() == CFG::SUBPROG)
+			p.push(ContextualStep::FUNCTION, _call->caller()->address());
+		Inst *calli = _call->callInst();
+		if(calli != nullptr)
+			p.push(ContextualStep::CALL, calli->address());
+	}
+	return p;
+}
+
+/**
+ * Get the properties of a block of the CFG in this context,
+ * creating them if needed. This is where the contextual information
+ * (like the loop bounds of @ref ipet::FlowFactLoader) is recorded.
+ * @param v		Block of the context CFG.
+ * @return		Block properties in this context.
+ */
+PropList& VirtualContext::props(Block *v) {
+	ASSERT(v->cfg() == _cfg);
+	PropList *p = _props.get(v, nullptr);
+	if(p == nullptr) {
+		p = new PropList();
+		_props.put(v, p);
+	}
+	return *p;
+}
+
+/**
+ * Get the properties of a block of the CFG in this context.
+ * @param v		Block of the context CFG.
+ * @return		Block properties in this context (empty if there is none).
+ */
+const PropList& VirtualContext::propsOf(Block *v) const {
+	PropList *p = _props.get(v, nullptr);
+	if(p == nullptr)
+		return PropList::EMPTY;
+	else
+		return *p;
+}
+
+/**
+ */
+io::Output& operator<<(io::Output& out, const VirtualContext *ctx) {
+	if(ctx->caller() == nullptr)
+		out << ctx->cfg()->label();
+	else
+		out << ctx->caller() << " > " << ctx->cfg()->label() << "@" << ctx->call()->address();
+	return out;
+}
+
+
 
 /**
  * This features only show that the CFG has been virtualized. This may implies
@@ -120,6 +301,7 @@ Identifier<bool> RECURSIVE_LOOP("otawa::RECURSIVE_LOOP", false);
  *
  * @par Configuration
  * @li @ref VIRTUAL_DEFAULT
+ * @li @ref VIRTUAL_SHARING
  *
  * @par Required features
  * @li @ref FLOW_FACTS_FEATURE
@@ -139,7 +321,7 @@ Identifier<bool> RECURSIVE_LOOP("otawa::RECURSIVE_LOOP", false);
 /**
  */
 Virtualizer::Virtualizer(void)
-	: CFGProvider(reg), virtualize(false), entry(nullptr)
+	: CFGProvider(reg), virtualize(false), sharing(false), entry(nullptr)
 	{ }
 
 // Registration
@@ -172,6 +354,7 @@ void Virtualizer::processWorkSpace(otawa::WorkSpace *fw) {
 void Virtualizer::configure(const PropList &props) {
 	entry = ENTRY_CFG(props);
 	virtualize = VIRTUAL_DEFAULT(props);
+	sharing = VIRTUAL_SHARING(props);
 	CFGProvider::configure(props);
 }
 
@@ -263,6 +446,15 @@ void Virtualizer::make(struct call_t *stack, CFG *cfg, CFGMaker& maker, elm::Opt
 				maker.add(nsb);
 			else if(isInlined(cfg, local_inlining, path)) {
 
+				// sharing mode: only link to the callee and record the call
+				if(sharing) {
+					if(!map.hasKey(sb->callee()))
+						todo.push(sb->callee());
+					maker.call(nsb, makerOf(sb->callee()));
+					SHARED_CALL(nsb) = true;
+					continue;
+				}
+
 				// recursive call case
 				bool rec = false;
 				for(struct call_t *c = &call; c; c = c->back)
@@ -369,6 +561,56 @@ void Virtualizer::cleanup(WorkSpace *ws) {
 		delete *m;
 	}
 	setCollection(coll);
+	if(sharing)
+		makeContexts(coll);
+}
+
+
+/**
+ * In sharing mode, build the inlining contexts of the CFGs.
+ * @param coll	Built collection.
+ */
+void Virtualizer::makeContexts(CFGCollection *coll) {
+
+	// root contexts: entry CFG and CFGs called without inlining
+	Vector<VirtualContext *> wl;
+	for(auto g: *coll) {
+		bool root = g == coll->entry();
+		for(auto c: g->callers())
+			if(!SHARED_CALL(c))
+				root = true;
+		if(root) {
+			VirtualContext *ctx = new VirtualContext(g);
+			contexts.add(ctx);
+			wl.push(ctx);
+		}
+	}
+
+	// propagate along inlined calls
+	while(wl) {
+		VirtualContext *ctx = wl.pop();
+		for(CFG::BlockIter v = ctx->cfg()->blocks(); v(); v++)
+			if(v->isSynth() && SHARED_CALL(*v)) {
+				SynthBlock *sb = v->toSynth();
+				if(ctx->isIn(sb->callee()))
+					continue;
+				VirtualContext *nctx = new VirtualContext(sb->callee(), ctx, sb);
+				contexts.add(nctx);
+				wl.push(nctx);
+			}
+	}
+	if(logFor(LOG_PROC))
+		log << "\t" << contexts.length() << " inlining contexts over " << coll->count() << " CFGs\n";
+}
+
+
+/**
+ */
+void Virtualizer::destroy(WorkSpace *ws) {
+	for(auto c: contexts)
+		delete c;
+	contexts.clear();
+	CFGProvider::destroy(ws);
 }
 
 } /* end namespace */
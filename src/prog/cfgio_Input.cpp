@@ -33,6 +33,7 @@
 #include <otawa/prog/Process.h>
 #include <otawa/prog/TextDecoder.h>
 #include <otawa/prog/WorkSpace.h>
+#include "cfgio_binary.h"
 
 namespace otawa { namespace cfgio {
 
@@ -172,6 +173,9 @@ public:
  * @endcode
  *
  * otawa::cfgio::FROM can be used to specified the PATH of the XML file to be read (the defualt is main.xml).
+ * The file may also be in the binary format produced by otawa::cfgio::Output (@ref cfgio-binary):
+ * it is recognized by its content and mapped in memory instead of being parsed.
+ * Its line section, if any, is ignored.
  * @code
  * your_program --add-prop otawa::cfgio::FROM=PATH_TO_YOUR_XML_FILE
  * @endcode
@@ -184,7 +188,8 @@ public:
 
 /**
  * @class Input
- * Create CFGCollection from an XML file matching the DTD ${OTAWA_HOME}/share/Otawa/dtd/cfg.dtd .
+ * Create CFGCollection from an XML file matching the DTD ${OTAWA_HOME}/share/Otawa/dtd/cfg.dtd
+ * or from a binary CFG file (@ref cfgio-binary).
  * @ingroup cfgio
  */
 Input::Input(p::declare& r): Processor(r), coll(nullptr) {
@@ -209,6 +214,19 @@ void Input::configure(const PropList& props) {
  *
  */
 void Input::processWorkSpace(WorkSpace *ws) {
+	bin::Image img;
+	if(img.open(path) && img.isBinary())
+		readBinary(ws, img);
+	else
+		readXML(ws);
+}
+
+
+/**
+ * Read the CFG collection from an XML file.
+ * @param ws	Current workspace.
+ */
+void Input::readXML(WorkSpace *ws) {
 	CFGFactory factory(ws);
 
 	// open the document
@@ -235,6 +253,115 @@ void Input::processWorkSpace(WorkSpace *ws) {
 //#	endif
 }
 
+/**
+ * Read the CFG collection from a binary file.
+ * @param ws	Current workspace.
+ * @param img	Binary file image.
+ */
+void Input::readBinary(WorkSpace *ws, const bin::Image& img) {
+	using namespace bin;
+	if(!img.isValid())
+		throw ProcessorException(*this, _ << "bad binary CFG file " << path);
+	t::uint32 cfg_cnt = img.count(T_CFG_CNT), block_cnt = img.count(T_BLOCK_CNT);
+	auto check = [&](bool cond) {
+		if(!cond)
+			throw ProcessorException(*this, _ << "corrupted binary CFG file " << path);
+	};
+	check(cfg_cnt != 0);
+
+	// create the CFG makers
+	Vector<CFGMaker *> makers;
+	for(t::uint32 i = 0; i < cfg_cnt; i++)
+		makers.add(new CFGMaker(ws->findInstAt(Address(img.field(T_CFG_OFF, CFG_SIZE, i, 0))), true));
+
+	try {
+
+		// create the blocks
+		Vector<Block *> blocks(block_cnt);
+		Vector<CFGMaker *> owners(block_cnt);
+		for(t::uint32 i = 0; i < cfg_cnt; i++) {
+			CFGMaker *m = makers[i];
+			check(img.field(T_CFG_OFF, CFG_SIZE, i, 2) == t::uint32(blocks.length()));
+			t::uint32 cnt = img.field(T_CFG_OFF, CFG_SIZE, i, 3);
+			check(blocks.length() + cnt <= block_cnt);
+			for(t::uint32 j = 0; j < cnt; j++) {
+				t::uint32 b = blocks.length();
+				t::uint32 kind = img.field(T_BLOCK_OFF, BLOCK_SIZE, b, 0);
+				Address addr = img.field(T_BLOCK_OFF, BLOCK_SIZE, b, 1);
+				t::uint32 info = img.field(T_BLOCK_OFF, BLOCK_SIZE, b, 2);
+				Block *v = nullptr;
+				check(kind == ENTRY ? j == 0 : j != 0);
+				switch(kind) {
+				case ENTRY:
+					v = m->entry();
+					break;
+				case EXIT:
+					v = m->exit();
+					break;
+				case UNKNOWN:
+					v = m->unknown();
+					break;
+				case PHONY:
+					v = new PhonyBlock();
+					m->add(v);
+					break;
+				case BASIC: {
+						Vector<Inst *> is;
+						Address ea = addr + info;
+						for(auto i = ws->findInstAt(addr); i != nullptr && i->address() < ea; i = i->nextInst())
+							is.add(i);
+						check(!is.isEmpty());
+						v = new BasicBlock(is.detach());
+						m->add(v);
+					}
+					break;
+				case SYNTH: {
+						auto c = new SynthBlock();
+						if(info == NONE)
+							m->call(c, nullptr);
+						else {
+							check(info < cfg_cnt);
+							m->call(c, *makers[info]);
+						}
+						v = c;
+					}
+					break;
+				default:
+					check(false);
+					break;
+				}
+				check(v->index() == int(j));
+				blocks.add(v);
+				owners.add(m);
+			}
+		}
+		check(t::uint32(blocks.length()) == block_cnt);
+
+		// create the edges
+		for(t::uint32 i = 0; i < img.count(T_EDGE_CNT); i++) {
+			t::uint32 src = img.field(T_EDGE_OFF, EDGE_SIZE, i, 0);
+			t::uint32 snk = img.field(T_EDGE_OFF, EDGE_SIZE, i, 1);
+			check(src < block_cnt && snk < block_cnt && owners[src] == owners[snk]);
+			owners[src]->add(blocks[src], blocks[snk], new Edge(img.field(T_EDGE_OFF, EDGE_SIZE, i, 2)));
+		}
+	}
+	catch(ProcessorException& e) {
+		for(auto m: makers)
+			delete m;
+		throw;
+	}
+
+	// build the collection
+	coll = new CFGCollection();
+	for(auto m: makers) {
+		coll->add(m->build());
+		delete m;
+	}
+	if(logFor(LOG_PROC))
+		log << "\tread " << cfg_cnt << " CFGs and " << block_cnt << " blocks from binary file " << path << io::endl;
+}
+
+
 /**
  *
  */
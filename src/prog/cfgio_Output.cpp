@@ -26,6 +26,7 @@
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/prog/Process.h>
 #include <otawa/prop/DynIdentifier.h>
+#include "cfgio_binary.h"
 
 
 namespace otawa { namespace cfgio {
@@ -68,6 +69,15 @@ p::id<Path> OUTPUT("otawa::cfgio::OUTPUT");
  */
 p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
 
+
+/**
+ * Used as a configuration of otawa::cfgio::Output to select the binary
+ * format instead of XML (see @ref cfgio-binary). The binary format is also
+ * selected when the path given by @ref otawa::cfgio::OUTPUT has extension ".cfgb".
+ * @ingroup cfgio
+ */
+p::id<bool> BINARY("otawa::cfgio::BINARY", false);
+
 /**
  * @defgroup cfgio	CFG Input / Output
  *
@@ -80,6 +90,37 @@ p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
  * @code
  * 	otawa-config --libs --rpath cfgio
  * @endcode
+ *
+ * @section cfgio-binary Binary Format
+ *
+ * For big programs, the XML documents are slow to produce and to read back.
+ * The binary format (selected with @ref otawa::cfgio::BINARY or an output
+ * file with extension ".cfgb") is written in a single stream pass and
+ * read back by mapping the file in memory, without any parsing. It records
+ * the CFGs, their blocks and edges, the synthetic call links and, if
+ * @ref otawa::cfgio::LINE_INFO is set, the source line information.
+ * Properties and instructions are not recorded: the instructions are rebuilt
+ * from the block address ranges. otawa::cfgio::Input recognizes the format
+ * by its content whatever the file name.
+ *
+ * The file is made of little-endian 32-bit words:
+ * @li header -- magic "OTAWACFG", version, flags (1 for line information),
+ * @li CFGs -- address, label (string offset), first block number, block count,
+ * @li blocks -- kind (entry, exit, unknown, phony, basic, synthetic), address,
+ * size (basic block) or callee CFG number (synthetic block, 0xffffffff if unknown),
+ * @li edges -- source block number, sink block number, edge flags,
+ * @li lines -- block number, address of the first instruction of the line,
+ * file (string offset), line; this section is informative, for external tools:
+ * otawa::cfgio::Input ignores it (as it ignores the line information of the
+ * XML format) since the lines are available from the debugging information
+ * of the program,
+ * @li strings -- null-terminated strings padded to a word,
+ * @li trailer -- count and offset of each section, size and offset of the strings,
+ * and again the magic.
+ *
+ * Blocks are numbered in the whole collection (as Block::id()) and the blocks
+ * of a CFG are stored in sequence, in the order of their index. As the section
+ * offsets are stored at the end, the file can be produced without buffering.
  */
 
 /**
@@ -90,12 +131,13 @@ p::id<bool> LINE_INFO("otawa::cfgio::LINE_INFO", false);
  * @li @ref otawa::cfgio::INCLUDE -- include the identifier whose name is given in the output.
  * @li @ref otawa::cfgio::OUTPUT -- path to output file to (if not defined, output to standard output).
  * @li @ref otawa::cfgio::LINE_INFO -- emit source line information on output.
+ * @li @ref otawa::cfgio::BINARY -- use the binary format (@ref cfgio-binary).
  * @ingroup cfgio
  */
 
 /**
  */
-Output::Output(void): BBProcessor(reg), root(0), cfg_node(0), last_bb(0), all(false), no_insts(false), line_info(false) {
+Output::Output(void): BBProcessor(reg), root(0), cfg_node(0), last_bb(0), all(false), no_insts(false), line_info(false), binary(false) {
 }
 
 
@@ -251,6 +293,7 @@ void Output::configure(const PropList& props) {
 	path = cfgio::OUTPUT(props);
 	no_insts = NO_INSTS(props);
 	line_info = LINE_INFO(props);
+	binary = BINARY(props) || (path && path.extension() == "cfgb");
 }
 
 
@@ -264,10 +307,10 @@ void Output::processWorkSpace(WorkSpace *ws) {
 			log << "\tproperty " << id->name() << " include in the output\n";
 
 	// build the root node
-	root = new xom::Element("cfg-collection");
-
-	// normal processing
-	BBProcessor::processWorkSpace(ws);
+	if(!binary) {
+		root = new xom::Element("cfg-collection");
+		BBProcessor::processWorkSpace(ws);
+	}
 
 	// open output
 	io::OutFileStream *file = 0;
@@ -282,11 +325,17 @@ void Output::processWorkSpace(WorkSpace *ws) {
 		out = file;
 	}
 
+	// output the binary
+	if(binary)
+		writeBinary(ws, *out);
+
 	// output the XML
-	xom::Document doc(root);
-	xom::Serializer serial(*out);
-	serial.write(&doc);
-	serial.flush();
+	else {
+		xom::Document doc(root);
+		xom::Serializer serial(*out);
+		serial.write(&doc);
+		serial.flush();
+	}
 
 	// close file if needed
 	if(file)
@@ -294,6 +343,111 @@ void Output::processWorkSpace(WorkSpace *ws) {
 }
 
 
+/**
+ * Output the CFG collection in binary format.
+ * @param ws	Current workspace.
+ * @param out	Stream to output to.
+ */
+void Output::writeBinary(WorkSpace *ws, io::OutStream& out) {
+	using namespace bin;
+	const CFGCollection *coll = INVOLVED_CFGS(ws);
+	Writer w(out);
+	t::uint32 trailer[T_TOP];
+
+	// header
+	for(int i = 0; i < 8; i++)
+		w.byte(MAGIC[i]);
+	w.put(VERSION);
+	w.put(line_info ? HAS_LINES : 0);
+
+	// CFGs
+	Vector<t::uint32> first;
+	t::uint32 cnt = 0;
+	trailer[T_CFG_CNT] = coll->count();
+	trailer[T_CFG_OFF] = w.offset();
+	for(auto g: *coll) {
+		first.add(cnt);
+		w.put(g->first() == nullptr ? 0 : g->address().offset());
+		w.put(w.str(g->label()));
+		w.put(cnt);
+		w.put(g->count());
+		cnt += g->count();
+	}
+
+	// blocks
+	trailer[T_BLOCK_CNT] = cnt;
+	trailer[T_BLOCK_OFF] = w.offset();
+	cnt = 0;
+	for(auto g: *coll)
+		for(auto v: *g) {
+			if(v->isEntry())
+				{ w.put(ENTRY); w.put(0); w.put(0); }
+			else if(v->isExit())
+				{ w.put(EXIT); w.put(0); w.put(0); }
+			else if(v->isUnknown())
+				{ w.put(UNKNOWN); w.put(0); w.put(0); }
+			else if(v->isPhony())
+				{ w.put(PHONY); w.put(0); w.put(0); }
+			else if(v->isBasic()) {
+				w.put(BASIC);
+				w.put(v->toBasic()->address().offset());
+				w.put(v->toBasic()->size());
+			}
+			else {
+				CFG *callee = v->toSynth()->callee();
+				w.put(SYNTH);
+				w.put(0);
+				w.put(callee == nullptr ? NONE : t::uint32(callee->index()));
+			}
+			cnt += v->countOuts();
+		}
+
+	// edges
+	trailer[T_EDGE_CNT] = cnt;
+	trailer[T_EDGE_OFF] = w.offset();
+	for(auto g: *coll)
+		for(auto v: *g)
+			for(auto e: v->outEdges()) {
+				w.put(first[g->index()] + e->source()->index());
+				w.put(first[g->index()] + e->sink()->index());
+				w.put(e->flags());
+			}
+
+	// line information
+	cnt = 0;
+	trailer[T_LINE_OFF] = w.offset();
+	if(line_info)
+		for(auto g: *coll)
+			for(auto v: *g)
+				if(v->isBasic()) {
+					Pair<cstring, int> cur("", 0);
+					for(BasicBlock::InstIter i = v->toBasic()->insts(); i(); i++) {
+						Option<Pair<cstring, int> > line = ws->process()->getSourceLine(i->address());
+						if(line && *line != cur) {
+							cur = line;
+							w.put(first[g->index()] + v->index());
+							w.put(i->address().offset());
+							w.put(w.str(cur.fst));
+							w.put(cur.snd);
+							cnt++;
+						}
+					}
+				}
+	trailer[T_LINE_CNT] = cnt;
+
+	// strings and trailer
+	trailer[T_STR_OFF] = w.offset();
+	trailer[T_STR_SIZE] = w.putStrings();
+	for(int i = 0; i < T_TOP; i++)
+		w.put(trailer[i]);
+	for(int i = 0; i < 8; i++)
+		w.byte(MAGIC[i]);
+	w.flush();
+	if(w.failed())
+		throw ProcessorException(*this, _ << "error while writing " << (path ? path.toString() : string("output")));
+}
+
+
 /**
  * Output the properties.
  * @param parent	Parent element.
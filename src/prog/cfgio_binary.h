@@ -0,0 +1,248 @@
+/*
+ *	cfgio binary CFG format
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#ifndef OTAWA_CFGIO_BINARY_H_
+#define OTAWA_CFGIO_BINARY_H_
+
+#if defined(__unix__) || defined(__APPLE__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include <elm/data/HashMap.h>
+#include <elm/data/Vector.h>
+#include <elm/io/InFileStream.h>
+#include <elm/io/OutStream.h>
+#include <elm/sys/Path.h>
+
+namespace otawa { namespace cfgio { namespace bin {
+
+using namespace elm;
+
+// format description (see cfgio_Output.cpp)
+const t::uint8 MAGIC[8] = { 'O', 'T', 'A', 'W', 'A', 'C', 'F', 'G' };
+const t::uint32 VERSION = 1;
+const t::uint32 NONE = 0xffffffff;
+const t::uint32 HAS_LINES = 0x1;
+const int HEADER_SIZE = 16;
+
+// trailer words
+typedef enum {
+	T_CFG_CNT = 0,
+	T_CFG_OFF,
+	T_BLOCK_CNT,
+	T_BLOCK_OFF,
+	T_EDGE_CNT,
+	T_EDGE_OFF,
+	T_LINE_CNT,
+	T_LINE_OFF,
+	T_STR_SIZE,
+	T_STR_OFF,
+	T_TOP
+} trailer_t;
+const int TRAILER_SIZE = T_TOP * 4 + 8;
+
+// record sizes (in words)
+const int
+	CFG_SIZE = 4,
+	BLOCK_SIZE = 3,
+	EDGE_SIZE = 3,
+	LINE_SIZE = 4;
+
+// block kinds
+typedef enum {
+	ENTRY = 0,
+	EXIT,
+	UNKNOWN,
+	PHONY,
+	BASIC,
+	SYNTH
+} kind_t;
+
+
+// buffered writer of little-endian words
+class Writer {
+public:
+	Writer(io::OutStream& out): _out(out), _n(0), _off(0), _failed(false) { str(""); }
+	~Writer() { flush(); }
+
+	inline t::uint32 offset() const { return _off; }
+	inline bool failed() const { return _failed; }
+
+	inline void byte(t::uint8 b) {
+		if(_n == sizeof(_buf))
+			flush();
+		_buf[_n++] = b;
+		_off++;
+	}
+
+	inline void put(t::uint32 w) {
+		for(int i = 0; i < 4; i++) {
+			byte(w & 0xff);
+			w >>= 8;
+		}
+	}
+
+	t::uint32 str(const string& s) {
+		t::uint32 r = _smap.get(s, NONE);
+		if(r == NONE) {
+			r = _strs.length();
+			for(int i = 0; i < s.length(); i++)
+				_strs.add(s[i]);
+			_strs.add(0);
+			_smap.put(s, r);
+		}
+		return r;
+	}
+
+	t::uint32 putStrings() {
+		for(auto c: _strs)
+			byte(c);
+		while(_off % 4 != 0)
+			byte(0);
+		return _strs.length();
+	}
+
+	void flush() {
+		if(_n != 0 && _out.write(_buf, _n) < 0)
+			_failed = true;
+		_n = 0;
+	}
+
+private:
+	io::OutStream& _out;
+	char _buf[4096];
+	int _n;
+	t::uint32 _off;
+	bool _failed;
+	Vector<char> _strs;
+	HashMap<string, t::uint32> _smap;
+};
+
+
+// read access to a binary CFG file, mapped in memory if possible
+class Image {
+public:
+	Image(): _b(nullptr), _len(0), _mapped(false) { }
+
+	~Image() {
+#		if defined(__unix__) || defined(__APPLE__)
+			if(_mapped) {
+				munmap(const_cast<t::uint8 *>(_b), _len);
+				return;
+			}
+#		endif
+		delete [] _b;
+	}
+
+	bool open(const sys::Path& path) {
+#		if defined(__unix__) || defined(__APPLE__)
+			int fd = ::open(path.toString().toCString().chars(), O_RDONLY);
+			if(fd < 0)
+				return false;
+			struct stat st;
+			if(fstat(fd, &st) == 0 && st.st_size > 0) {
+				void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if(p != MAP_FAILED) {
+					_b = static_cast<const t::uint8 *>(p);
+					_len = st.st_size;
+					_mapped = true;
+				}
+			}
+			close(fd);
+			if(_mapped)
+				return true;
+#		endif
+		io::InFileStream in(path.toString().toCString());
+		if(!in.isReady())
+			return false;
+		Vector<t::uint8> buf;
+		char chunk[4096];
+		while(true) {
+			int r = in.read(chunk, sizeof(chunk));
+			if(r < 0)
+				return false;
+			if(r == 0)
+				break;
+			for(int i = 0; i < r; i++)
+				buf.add(chunk[i]);
+		}
+		t::uint8 *b = new t::uint8[buf.length()];
+		for(int i = 0; i < buf.length(); i++)
+			b[i] = buf[i];
+		_b = b;
+		_len = buf.length();
+		return true;
+	}
+
+	inline t::uint32 word(t::uint64 off) const {
+		return t::uint32(_b[off])
+			 | (t::uint32(_b[off + 1]) << 8)
+			 | (t::uint32(_b[off + 2]) << 16)
+			 | (t::uint32(_b[off + 3]) << 24);
+	}
+	inline t::uint32 flags() const { return word(12); }
+	inline t::uint32 trailer(trailer_t i) const { return word(_len - TRAILER_SIZE + i * 4); }
+	inline t::uint32 count(trailer_t cnt) const { return trailer(cnt); }
+	inline t::uint32 field(trailer_t off, int size, t::uint32 i, int f) const
+		{ return word(t::uint64(trailer(off)) + (t::uint64(i) * size + f) * 4); }
+	inline cstring str(t::uint32 off) const
+		{ return reinterpret_cast<const char *>(&_b[trailer(T_STR_OFF) + off]); }
+	inline bool isString(t::uint32 off) const { return off < trailer(T_STR_SIZE); }
+
+	bool isBinary() const {
+		if(_len < HEADER_SIZE + TRAILER_SIZE)
+			return false;
+		for(int i = 0; i < 8; i++)
+			if(_b[i] != MAGIC[i] || _b[_len - 8 + i] != MAGIC[i])
+				return false;
+		return true;
+	}
+
+	bool isValid() const {
+		if(!isBinary() || word(8) != VERSION)
+			return false;
+		if(!fits(T_CFG_CNT, T_CFG_OFF, CFG_SIZE)
+		|| !fits(T_BLOCK_CNT, T_BLOCK_OFF, BLOCK_SIZE)
+		|| !fits(T_EDGE_CNT, T_EDGE_OFF, EDGE_SIZE)
+		|| !fits(T_LINE_CNT, T_LINE_OFF, LINE_SIZE))
+			return false;
+		t::uint64 off = trailer(T_STR_OFF), size = trailer(T_STR_SIZE);
+		return size != 0 && off + size <= _len - TRAILER_SIZE && _b[off + size - 1] == 0;
+	}
+
+private:
+	bool fits(trailer_t cnt, trailer_t off, int size) const {
+		t::uint64 top = t::uint64(trailer(off)) + t::uint64(trailer(cnt)) * size * 4;
+		return trailer(off) % 4 == 0 && trailer(off) >= HEADER_SIZE && top <= _len - TRAILER_SIZE;
+	}
+
+	const t::uint8 *_b;
+	t::uint64 _len;
+	bool _mapped;
+};
+
+} } }	// otawa::cfgio::bin
+
+#endif /* OTAWA_CFGIO_BINARY_H_ */
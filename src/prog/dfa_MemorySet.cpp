@@ -158,6 +158,9 @@ MemorySet::t MemorySet::join(t m1, t m2) {
 	else if(m2 == empty)
 		// m2 = [] -> m2 subset of r
 		return reuse(m1);
+	else if(m1.h == m2.h)
+		// m1 = m2 (shared) -> r = m1
+		return reuse(m1);
 
 	// start building the join
 	node_t *r = empty;
@@ -320,6 +323,9 @@ bool MemorySet::equals(t m1, t m2) {
 
 	// INV: forall m in m1 \ p -> m in m2 \ q
 	while(p && q) {
+		if(p == q)
+			// shared tail -> forall m in m1 -> m in m2
+			return true;
 		if(p->area != q->area)
 			// *p <> *q
 			return false;
@@ -356,6 +362,9 @@ bool MemorySet::subset(t m1, t m2) {
 	// INV: forall a in m1 \ p -> exists b in m2 \ q /\ a subset of b /\ last(m1 \ p).top < q.addr
 	// forall a in m1 \ m1 -> exists b in m2 \ m2 /\ a subset of b /\ last(m1 \ m1).top < q.addr
 	while(p && q) {
+		if(p == q)
+			// shared tail -> forall a in p -> a in q
+			return true;
 		if(p->topAddress() < q->address())
 			// A: p.top < q.addr -> forall a in q -> a not subset of *p
 			p = p->next;
@@ -438,6 +447,8 @@ MemorySet::t MemorySet::meet(t m1, t m2) {
 	node_t *p = m1, *q = m2;
 	node_t *r = 0;
 	node_t **n = &r;
+	if(p == q)
+		return reuse(m1);
 
 #ifndef USE_OLD_MEMORY_SET_MEET
 	for(p = m1; p; p = p->next) {
@@ -87,6 +87,21 @@ namespace otawa { namespace dfa {
  */
 
 
+/**
+ * @fn void XIterativeDFA::processWorklist(void);
+ * Perform the DFA computation until reaching a fixpoint using a worklist.
+ * The graph is first decomposed in strongly connected components that are
+ * solved one after the other in topological order; inside a component, the
+ * nodes are processed in reverse post-order and a node is only re-computed
+ * when the OUT set of one of its predecessors has changed. Hence, acyclic
+ * regions are solved in one pass.
+ *
+ * The result is the same as with process() but the number of node
+ * computations is usually much smaller. The successors of the nodes are
+ * obtained by calling visitPreds() once on each node.
+ */
+
+
 /**
  * @fn void XIterativeDFA::nextPred(int pred);
  * This functions is used internally to communicate with the visitor. When
@@ -159,6 +159,19 @@ Identifier<Block*> HAI_BYPASS_TARGET("otawa::util::HAI_BYPASS_TARGET", 0);
 
 Identifier<bool> HAI_INFINITE_LOOP("otawa::util::HAI_INFINITE_LOOP", false);
 
+/**
+ * @fn HalfAbsInt::HalfAbsInt(FixPoint& fp, WorkSpace& ws, bool ordered);
+ * Build the abstract interpreter. The CFG collection (COLLECTED_CFG_FEATURE)
+ * and the loop information (LOOP_INFO_FEATURE) must be available
+ * in the workspace.
+ * @param fp		Fix point manager.
+ * @param ws		Workspace to work on.
+ * @param ordered	True (default) to schedule the blocks by CFG and loop depth,
+ * 					false to use the plain LIFO order of the previous versions
+ * 					(see WorkList).
+ * @throw otawa::Exception	If the CFG collection is not available.
+ */
+
 /**
  * @fn typename FixPoint::FixPointState *HalfAbsInt::getFixPointState(BasicBlock *bb);
  * Get the FixPointState of a loop.
@@ -174,6 +187,45 @@ Identifier<bool> HAI_INFINITE_LOOP("otawa::util::HAI_INFINITE_LOOP", false);
  * @return The number of iterations of the algorithm.
  */
 
+/**
+ * @fn int HalfAbsInt::iterations(void) const;
+ * Get the number of block processings performed by the last call to solve().
+ * @return	Number of iterations.
+ */
+
+/**
+ * @fn int HalfAbsInt::headerVisits(Block *h) const;
+ * Get the number of times the given loop header has been processed by the
+ * last call to solve(), that is, the number of iterations of the loop
+ * summed over its entries.
+ * @param h		Loop header.
+ * @return		Number of visits of the header.
+ */
+
+/**
+ * @fn const HashMap<Block *, int>& HalfAbsInt::headerVisits(void) const;
+ * Get the number of visits of each loop header processed by the last call to solve().
+ * @return	Map of loop headers to visit counts.
+ */
+
+
+/**
+ * @class WorkList
+ * Work list used by HalfAbsInt. A block is recorded only once (membership
+ * is tested with a bit vector indexed by the block identifiers).
+ * The pending blocks are stored by CFG and, inside a CFG, by loop depth:
+ * pop() returns first a block of the requested CFG (the current CFG
+ * of the analysis), the most deeply nested one first so that inner loops
+ * stabilize before the blocks of the enclosing loops are re-visited.
+ * Blocks of the same depth are returned in LIFO order.
+ *
+ * If the work list is not ordered, the blocks are returned in LIFO order
+ * whatever their CFG and depth: this is the scheduling of the previous
+ * versions of HalfAbsInt, kept for comparison.
+ *
+ * Requires LOOP_INFO_FEATURE to be computed.
+ */
+
 /**
  * @fn typename FixPoint::Domain HalfAbsInt::backEdgeUnion(BasicBlock *bb)
  * Given a loop header, returns the union of the value of its back edges.
@@ -69,6 +69,14 @@ namespace otawa { namespace dfa { namespace hai {
  * Is called by HalfAbsInt for fixpoint object initializeation.
  * @param _ai HalfAbsint object. 
  */
+
+/**
+ * @fn HalfAbsInt< WideningFixPoint > *WideningFixPoint::absInt(void) const
+ * Get the HalfAbsInt using this fixpoint. It lets the listener access
+ * the statistics of the analysis (see HalfAbsInt::iterations() and
+ * HalfAbsInt::headerVisits()).
+ * @return	HalfAbsInt object.
+ */
  
 /**
  * @fn void WideningFixPoint::fixPoint (BasicBlock *bb, bool &fixpoint, Domain &in, bool firstTime) const
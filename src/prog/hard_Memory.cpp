@@ -21,6 +21,7 @@
 
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/hard/Memory.h>
+#include <elm/data/quicksort.h>
 #include <elm/serial2/XOMUnserializer.h>
 
 using namespace elm;
@@ -384,19 +385,103 @@ const Memory Memory::null;
 const Memory Memory::full(true);
 
 
+// order of banks by base address
+class BankOrder {
+public:
+	static int compare(const Bank *b1, const Bank *b2) {
+		if(b1->address().page() != b2->address().page())
+			return b1->address().page() < b2->address().page() ? -1 : +1;
+		else if(b1->address().offset() != b2->address().offset())
+			return b1->address().offset() < b2->address().offset() ? -1 : +1;
+		else
+			return 0;
+	}
+	int doCompare(const Bank *b1, const Bank *b2) const { return compare(b1, b2); }
+};
+
+// last offset of a bank (a null size covers the whole page)
+static inline Address::offset_t lastOffset(const Bank *b)
+	{ return b->address().offset() + Address::offset_t(b->size()) - 1; }
+
+// test if the bank starts at or before the given address
+static inline bool startsBefore(const Bank *b, const Address& a) {
+	return b->address().page() < a.page()
+		|| (b->address().page() == a.page() && b->address().offset() <= a.offset());
+}
+
+
+/**
+ * Build the index of banks used by get(): banks sorted by base address.
+ * If some banks overlap, the index is left empty and get() falls back
+ * to the linear look up to keep the first-declared-bank-wins semantics.
+ */
+void Memory::buildIndex(void) {
+	_index.clear();
+	for(int i = 0; i < _banks.count(); i++)
+		_index.add(_banks[i]);
+	quicksort(_index, BankOrder());
+	for(int i = 1; i < _index.count(); i++)
+		if(_index[i - 1]->address().page() == _index[i]->address().page()
+		&& lastOffset(_index[i - 1]) >= _index[i]->address().offset()) {
+			_index.clear();
+			break;
+		}
+}
+
+
 /**
- * Get the bank matching the given address.
+ * Get the bank matching the given address. The look up is performed
+ * by binary search on the banks sorted by address except if the banks
+ * overlap.
  * @param address	Address to find bank for.
  * @return			Found bank or null.
  */
 const Bank *Memory::get(Address address) const {
-	for(int i = 0; i < _banks.count(); i++)
-		if(_banks[i]->contains(address))
-			return _banks[i];
-	return 0;
+	_lookups.fetch_add(1, std::memory_order_relaxed);
+	const Bank *r = nullptr;
+
+	// indexed look up
+	if(_index.count() == _banks.count()) {
+		int l = 0, h = _index.count();
+		while(l < h) {
+			int m = (l + h) / 2;
+			if(startsBefore(_index[m], address))
+				l = m + 1;
+			else
+				h = m;
+		}
+		if(l > 0 && _index[l - 1]->contains(address))
+			r = _index[l - 1];
+	}
+
+	// linear look up
+	else
+		for(int i = 0; i < _banks.count(); i++)
+			if(_banks[i]->contains(address)) {
+				r = _banks[i];
+				break;
+			}
+
+	if(r)
+		_hits.fetch_add(1, std::memory_order_relaxed);
+	return r;
 }
 
 
+/**
+ * @fn t::uint64 Memory::lookups(void) const;
+ * Get the number of look up performed by get().
+ * @return	Look up count.
+ */
+
+
+/**
+ * @fn t::uint64 Memory::hits(void) const;
+ * Get the number of look up of get() that found a bank.
+ * @return	Successful look up count.
+ */
+
+
 /**
  * Load a memory configuration from the given element.
  * @param element	Element to load from.
@@ -407,6 +492,7 @@ Memory *Memory::load(elm::xom::Element *element) {
 	Memory *conf = new Memory();
 	try {
 		unserializer >> *conf;
+		conf->buildIndex();
 		return conf;
 	}
 	catch(elm::Exception& exn) {
@@ -427,6 +513,7 @@ Memory *Memory::load(const elm::sys::Path& path) {
 	Memory *conf = new Memory();
 	try {
 		unserializer >> *conf;
+		conf->buildIndex();
 		return conf;
 	}
 	catch(elm::Exception& exn) {
@@ -446,12 +533,15 @@ Memory::Memory(bool full):
 	_wwrite(0),
 	_baccess(0),
 	_bread(0),
-	_bwrite(0)
+	_bwrite(0),
+	_lookups(0),
+	_hits(0)
 {
 	if(full) {
 		_banks = AllocArray<const Bank *>(1);
 		_banks[0] = &Bank::full;
 	}
+	buildIndex();
 }
 
 
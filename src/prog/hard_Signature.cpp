@@ -0,0 +1,107 @@
+/*
+ *	hard::signature() implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/checksum/Fletcher.h>
+#include <otawa/hard.h>
+#include <otawa/hard/features.h>
+#include <otawa/hard/Processor.h>
+#include <otawa/hard/Signature.h>
+#include <otawa/prog/WorkSpace.h>
+
+namespace otawa { namespace hard {
+
+static void describe(StringBuffer& buf, const PipelineUnit *unit) {
+	buf << unit->getName() << ':' << unit->getLatency() << ':' << unit->getWidth()
+		<< ':' << unit->isBranch() << ':' << unit->isMem() << ':' << unit->memStage();
+}
+
+static void describe(StringBuffer& buf, const Cache *cache) {
+	if(cache == nullptr) {
+		buf << "-;";
+		return;
+	}
+	buf << cache->blockBits() << ':' << cache->rowBits() << ':' << cache->wayBits()
+		<< ':' << int(cache->replacementPolicy()) << ':' << int(cache->writePolicy())
+		<< ':' << cache->doesWriteAllocate() << ':' << cache->missPenalty() << ';';
+}
+
+/**
+ * Compute a signature of the hardware description of the given workspace,
+ * that is, of the processor pipeline, of the memory banks and of the caches
+ * (only the provided descriptions are considered). It is used to tag the
+ * files storing results depending on the hardware so that they are not reused
+ * with another configuration.
+ * @param ws	Workspace to look in.
+ * @return		Signature of the hardware configuration.
+ * @ingroup hard
+ */
+t::uint32 signature(WorkSpace *ws) {
+	StringBuffer buf;
+
+	// processor
+	if(ws->isProvided(PROCESSOR_FEATURE)) {
+		const Processor *proc = PROCESSOR_FEATURE.get(ws);
+		buf << "P" << proc->getArch() << ':' << proc->getModel() << ':' << proc->getFrequency() << ';';
+		for(auto stage: proc->getStages()) {
+			describe(buf, stage);
+			buf << ':' << int(stage->getType()) << ':' << stage->isOrdered();
+			for(auto fu: stage->getFUs()) {
+				buf << ",";
+				describe(buf, fu);
+				buf << ':' << fu->isPipelined();
+			}
+			for(auto disp: stage->getDispatch())
+				buf << "," << io::hex(Inst::kind_t(disp->getType())) << "->" << disp->getFU()->getName();
+			buf << ';';
+		}
+		for(auto queue: proc->getQueues()) {
+			buf << queue->getName() << ':' << queue->getSize();
+			if(queue->getInput() != nullptr)
+				buf << ':' << queue->getInput()->getName();
+			if(queue->getOutput() != nullptr)
+				buf << ':' << queue->getOutput()->getName();
+			buf << ';';
+		}
+	}
+	buf << '|';
+
+	// memory
+	if(ws->isProvided(MEMORY_FEATURE))
+		for(auto bank: MEMORY_FEATURE.get(ws)->banks())
+			buf << bank->name() << ':' << bank->address() << ':' << bank->size() << ':' << int(bank->type())
+				<< ':' << bank->readLatency() << ':' << bank->writeLatency() << ':' << bank->blockBits()
+				<< ':' << bank->isCached() << ':' << bank->isWritable() << ':' << bank->portNum() << ';';
+	buf << '|';
+
+	// caches
+	if(ws->isProvided(CACHE_CONFIGURATION_FEATURE)) {
+		const CacheConfiguration *conf = CACHE_CONFIGURATION_FEATURE.get(ws);
+		describe(buf, conf->instCache());
+		describe(buf, conf->dataCache());
+	}
+
+	String s = buf.toString();
+	checksum::Fletcher sum;
+	sum.put(s.chars(), s.length());
+	return sum.sum();
+}
+
+} }	// otawa::hard
@@ -0,0 +1,335 @@
+/*
+ *	icache::SetProjector and icache::SetProjectedGraph classes implementation
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	This file is part of OTAWA
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <otawa/cfg/CompositeCFG.h>
+#include <otawa/icache/SetProjectedGraph.h>
+
+namespace otawa { namespace icache {
+
+/**
+ * @class SetProjector
+ * A set projector records, once for all the cache sets, the structure
+ * needed to build the @ref SetProjectedGraph of each set. It looks at the
+ * CFG collection as the @ref CompositeCFG does (calls are traversed,
+ * CFG boundaries are hidden) and stores:
+ * @li the blocks reached from the task entry,
+ * @li the arcs (w, e, v) such that e is a predecessor edge of v as seen
+ * by CompositeCFG and w is the source of e,
+ * @li for each arc, whether it denotes a structural event (loop entry
+ * or exit, call or return).
+ *
+ * As it is only read after construction, a set projector can be shared
+ * by the analyses of the different cache sets, even in parallel.
+ *
+ * @ingroup icache
+ */
+
+/**
+ * Build the set projector.
+ * @param coll	CFG collection of the task.
+ */
+SetProjector::SetProjector(const CFGCollection& coll)
+:	_coll(coll),
+	_blocks(coll.countBlocks()),
+	_reached(coll.countBlocks()),
+	_start(coll.countBlocks() + 1)
+{
+	int n = _blocks.count();
+	_reached.fill(false);
+	_start.fill(0);
+	for(CFGCollection::BlockIter v(&coll); v(); v++)
+		_blocks[v->id()] = *v;
+
+	// find the blocks reached from the entry (as the AI drivers do)
+	CompositeCFG g(coll);
+	Vector<Block *> todo;
+	todo.push(entry());
+	_reached[entry()->id()] = true;
+	while(todo) {
+		Block *v = todo.pop();
+		for(auto e = g.succs(v); e(); e++) {
+			Block *w = g.sinkOf(*e);
+			if(!_reached[w->id()]) {
+				_reached[w->id()] = true;
+				todo.push(w);
+			}
+		}
+	}
+
+	// count the arcs by source (entry and exit are never updated)
+	for(int i = 0; i < n; i++)
+		if(_reached[i] && _blocks[i] != entry() && _blocks[i] != exit())
+			for(auto e = g.preds(_blocks[i]); e(); e++)
+				_start[e->source()->id() + 1]++;
+	for(int i = 0; i < n; i++)
+		_start[i + 1] += _start[i];
+
+	// record the arcs
+	_arcs = AllocArray<arc_t>(_start[n]);
+	AllocArray<int> cur(_start);
+	for(int i = 0; i < n; i++)
+		if(_reached[i] && _blocks[i] != entry() && _blocks[i] != exit())
+			for(auto e = g.preds(_blocks[i]); e(); e++) {
+				arc_t& a = _arcs[cur[e->source()->id()]++];
+				a.edge = *e;
+				a.sink = _blocks[i];
+				a.structural = LOOP_EXIT(*e) != nullptr
+					|| (LOOP_HEADER(e->target()) && !BACK_EDGE(*e))
+					|| isCall(*e)
+					|| isReturn(*e);
+			}
+}
+
+/**
+ * @fn const CFGCollection& SetProjector::collection(void) const;
+ * Get the projected CFG collection.
+ * @return	CFG collection.
+ */
+
+/**
+ * @fn Block *SetProjector::entry(void) const;
+ * Get the entry block of the task.
+ * @return	Task entry block.
+ */
+
+/**
+ * @fn Block *SetProjector::exit(void) const;
+ * Get the exit block of the task.
+ * @return	Task exit block.
+ */
+
+/**
+ * @fn int SetProjector::count(void) const;
+ * Get the number of blocks of the CFG collection.
+ * @return	Block count.
+ */
+
+/**
+ * @fn bool SetProjector::isReached(Block *v) const;
+ * Test if a block is reached from the entry of the task.
+ * @param v		Tested block.
+ * @return		True if the block is reached, false else.
+ */
+
+/**
+ * Test if an edge enters a called CFG (same definition as CompositeCFG).
+ * @param e		Tested edge.
+ * @return		True if e is a call edge, false else.
+ */
+bool SetProjector::isCall(Edge *e) const {
+	return e->sink()->isCall() || (e->source()->isEntry() && e->source() != entry());
+}
+
+/**
+ * Test if an edge leaves a called CFG (same definition as CompositeCFG).
+ * @param e		Tested edge.
+ * @return		True if e is a return edge, false else.
+ */
+bool SetProjector::isReturn(Edge *e) const {
+	return e->source()->isCall() || (e->sink()->isExit() && e->sink() != exit());
+}
+
+
+/**
+ * @class SetProjectedGraph
+ * Graph of the task projected on a particular cache set. Most blocks of a
+ * task do not access a given cache set and, for them, the update of
+ * an abstract cache state of this set is the identity. This graph only keeps
+ * as vertices the relevant blocks, that is:
+ * @li the entry and the exit of the task,
+ * @li the blocks accessing the set,
+ * @li the blocks with an output edge accessing the set,
+ * @li if persistence is required, the blocks with an output edge entering
+ * or exiting a loop, calling or returning from a CFG.
+ *
+ * A link (w, e, v0, v) of the graph, with w and v relevant, represents
+ * the paths w →e v0 → ... → v only traversing irrelevant blocks:
+ * the state flowing along the link is the state of w updated by w
+ * and e (v0 being the target of e), the following
+ * irrelevant blocks and edges leaving the state unchanged. Therefore
+ * the usual update functions of the cache analyses apply to the links
+ * by considering the edge e and its target v0.
+ *
+ * To map back the results to irrelevant blocks, the predecessors of an
+ * irrelevant block v are the links (w, e, v0, v) whose paths traverse v:
+ * applying to them the update of the analysis gives the input state
+ * of v.
+ *
+ * This class implements the graph and indexed concepts of @ref ai
+ * and may be used with the analysis drivers, like SimpleAI, in place of
+ * @ref CompositeCFG.
+ *
+ * @ingroup icache
+ */
+
+/**
+ * @class SetProjectedGraph::Link
+ * Link of a set projected graph.
+ */
+
+/**
+ * @fn Block *SetProjectedGraph::Link::source(void) const;
+ * Get the relevant source block of the link.
+ * @return	Source block.
+ */
+
+/**
+ * @fn Edge *SetProjectedGraph::Link::edge(void) const;
+ * Get the original edge (as returned by CompositeCFG) the link starts with.
+ * @return	First edge of the link.
+ */
+
+/**
+ * @fn Block *SetProjectedGraph::Link::target(void) const;
+ * Get the block the original edge of the link leads to.
+ * @return	Target block.
+ */
+
+/**
+ * @fn Block *SetProjectedGraph::Link::sink(void) const;
+ * Get the block the link ends to.
+ * @return	Sink block.
+ */
+
+/**
+ * Build the projected graph.
+ * @param proj			Set projector of the task.
+ * @param cache			Analyzed cache.
+ * @param set			Projection cache set.
+ * @param persistence	If true, loop entries and exits, calls and returns are kept.
+ */
+SetProjectedGraph::SetProjectedGraph(const SetProjector& proj, const hard::Cache& cache, int set, bool persistence)
+:	_proj(proj),
+	_cache(cache),
+	_set(set),
+	_index(proj.count()),
+	_in_start(proj.count() + 1)
+{
+	int n = proj.count();
+
+	// select the relevant blocks
+	_index.fill(-1);
+	for(int i = 0; i < n; i++) {
+		Block *v = proj._blocks[i];
+		bool rel = v == proj.entry() || v == proj.exit() || accesses(ACCESSES(v));
+		for(int j = proj._start[i]; !rel && j < proj._start[i + 1]; j++)
+			rel = (persistence && proj._arcs[j].structural) || accesses(ACCESSES(proj._arcs[j].edge));
+		if(rel) {
+			_index[i] = _vertices.length();
+			_vertices.add(v);
+		}
+	}
+
+	// build the links by traversing the irrelevant blocks
+	AllocArray<int> mark(n);
+	mark.fill(-1);
+	Vector<Block *> todo;
+	for(auto w: _vertices)
+		for(int j = proj._start[w->id()]; j < proj._start[w->id() + 1]; j++) {
+			const SetProjector::arc_t& a = proj._arcs[j];
+			mark[a.sink->id()] = j;
+			todo.push(a.sink);
+			while(todo) {
+				Block *v = todo.pop();
+				Link l;
+				l._source = w;
+				l._edge = a.edge;
+				l._target = a.sink;
+				l._sink = v;
+				_links.add(l);
+				if(!isRelevant(v))
+					for(int k = proj._start[v->id()]; k < proj._start[v->id() + 1]; k++) {
+						Block *x = proj._arcs[k].sink;
+						if(mark[x->id()] != j) {
+							mark[x->id()] = j;
+							todo.push(x);
+						}
+					}
+			}
+		}
+
+	// build the predecessor and successor arrays
+	int m = _vertices.length();
+	_out_start = AllocArray<int>(m + 1);
+	_in_start.fill(0);
+	_out_start.fill(0);
+	for(const auto& l: _links) {
+		_in_start[l._sink->id() + 1]++;
+		if(isRelevant(l._sink))
+			_out_start[index(l._source) + 1]++;
+	}
+	for(int i = 0; i < n; i++)
+		_in_start[i + 1] += _in_start[i];
+	for(int i = 0; i < m; i++)
+		_out_start[i + 1] += _out_start[i];
+	_in = AllocArray<int>(_in_start[n]);
+	_out = AllocArray<int>(_out_start[m]);
+	AllocArray<int> ic(_in_start), oc(_out_start);
+	for(int i = 0; i < _links.length(); i++) {
+		const Link& l = _links[i];
+		_in[ic[l._sink->id()]++] = i;
+		if(isRelevant(l._sink))
+			_out[oc[index(l._source)]++] = i;
+	}
+}
+
+/**
+ * @fn bool SetProjectedGraph::isRelevant(vertex_t v) const;
+ * Test if a block is a vertex of the projected graph.
+ * @param v		Tested block.
+ * @return		True if v is relevant, false else.
+ */
+
+/**
+ * @fn int SetProjectedGraph::countLinks(void) const;
+ * Get the number of links between relevant blocks.
+ * @return	Link count.
+ */
+
+/**
+ * @fn Predecessor SetProjectedGraph::preds(vertex_t v) const;
+ * Get the links ending at v. If v is not relevant, get the links whose
+ * paths traverse v.
+ * @param v		Block to look predecessors for.
+ * @return		Iterator on the links.
+ */
+
+/**
+ * @fn Successor SetProjectedGraph::succs(vertex_t v) const;
+ * Get the links starting from v.
+ * @param v		Relevant block to look successors for.
+ * @return		Iterator on the links.
+ */
+
+/**
+ * Test if the given accesses concern the projection cache set.
+ * @param accs	Accesses to test.
+ * @return		True if one access concerns the set, false else.
+ */
+bool SetProjectedGraph::accesses(const Bag<Access>& accs) const {
+	for(int i = 0; i < accs.count(); i++)
+		if(accs[i].kind() != NONE && int(_cache.set(accs[i].address())) == _set)
+			return true;
+	return false;
+}
+
+} }	// otawa::icache
@@ -0,0 +1,735 @@
+/*
+ *	ilp::PresolvedSystem class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <limits>
+#include <math.h>
+#include <elm/data/quicksort.h>
+#include <elm/util/BitVector.h>
+#include <otawa/ilp/PresolvedSystem.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/proc/Monitor.h>
+
+namespace otawa { namespace ilp {
+
+static const double eps = 1e-9;
+static const double inf = std::numeric_limits<double>::infinity();
+
+static inline bool isInt(double v) { return fabs(v - round(v)) <= eps; }
+
+
+// presolving of a system
+class Presolver {
+public:
+
+	typedef Vector<Pair<int, double> > terms_t;
+
+	// variable: x = k * x_by + e if substituted, x = e if fixed
+	typedef enum {
+		KEPT,
+		FIXED,
+		SUBST
+	} state_t;
+
+	class Column {
+	public:
+		Column(Var::type_t t): lb(0), ub(t == Var::BIN ? 1 : inf),
+			integer(t != Var::FLOAT), state(KEPT), k(0), e(0), by(-1), obj(0), var(nullptr) { }
+		Vector<int> rows;
+		double lb, ub;
+		bool integer;
+		state_t state;
+		double k, e;
+		int by;
+		double obj;
+		Var *var;
+	};
+
+	class Row {
+	public:
+		Row(const string& l, Constraint::comparator_t c, double k)
+			: comp(c), cst(k), alive(true), queued(false), label(l) { }
+		terms_t terms;
+		Constraint::comparator_t comp;
+		double cst;
+		bool alive, queued;
+		string label;
+	};
+
+	// order of rows by normalized terms
+	class RowOrder {
+	public:
+		RowOrder(const Vector<terms_t *>& n): norm(n) { }
+		int doCompare(int r1, int r2) const {
+			const terms_t &t1 = *norm[r1], &t2 = *norm[r2];
+			if(t1.count() != t2.count())
+				return t1.count() - t2.count();
+			for(int i = 0; i < t1.count(); i++) {
+				if(t1[i].fst != t2[i].fst)
+					return t1[i].fst - t2[i].fst;
+				if(t1[i].snd != t2[i].snd)
+					return t1[i].snd < t2[i].snd ? -1 : 1;
+			}
+			return 0;
+		}
+	private:
+		const Vector<terms_t *>& norm;
+	};
+
+	class TermOrder {
+	public:
+		int doCompare(const Pair<int, double>& t1, const Pair<int, double>& t2) const
+			{ return t1.fst - t2.fst; }
+	};
+
+	Presolver(bool max): max(max), offset(0), failed(false), fixed(0), subst(0), removed(0) { }
+	~Presolver(void) {
+		for(auto c: cols)
+			delete c;
+		for(auto r: rows)
+			delete r;
+	}
+
+	int addVar(Var::type_t type) {
+		cols.add(new Column(type));
+		return cols.count() - 1;
+	}
+
+	int addRow(const string& label, Constraint::comparator_t comp, double cst) {
+		rows.add(new Row(label, comp, cst));
+		return rows.count() - 1;
+	}
+
+	void addTerm(int r, int x, double a) {
+		terms_t& ts = rows[r]->terms;
+		for(int i = 0; i < ts.count(); i++)
+			if(ts[i].fst == x) {
+				ts[i].snd += a;
+				return;
+			}
+		ts.add(pair(x, a));
+		cols[x]->rows.add(r);
+	}
+
+	inline void addObject(int x, double a) { cols[x]->obj += a; }
+	inline void addOffset(double a) { offset += a; }
+
+	bool run(void) {
+		for(int i = 0; i < rows.count(); i++)
+			push(i);
+		while(!failed) {
+			while(!failed && !todo.isEmpty())
+				process(todo.pop());
+			if(failed)
+				break;
+			int done = fixed + subst + removed;
+			emptyColumns();
+			duplicates();
+			if(done == fixed + subst + removed)
+				break;
+		}
+		return !failed;
+	}
+
+	// compute the values of eliminated variables (from the values of the kept ones)
+	void complete(Vector<double>& vals) {
+		for(int i = elim.count() - 1; i >= 0; i--) {
+			Column *c = cols[elim[i]];
+			if(c->state == FIXED)
+				vals[elim[i]] = c->e;
+			else
+				vals[elim[i]] = c->k * vals[c->by] + c->e;
+		}
+	}
+
+	bool max;
+	Vector<Column *> cols;
+	Vector<Row *> rows;
+	double offset;
+	bool failed;
+	string reason;
+	int fixed, subst, removed;
+
+private:
+
+	void fail(const string& msg) {
+		if(!failed) {
+			failed = true;
+			reason = msg;
+		}
+	}
+
+	inline void push(int r) {
+		if(rows[r]->alive && !rows[r]->queued) {
+			rows[r]->queued = true;
+			todo.push(r);
+		}
+	}
+
+	inline void kill(int r) {
+		rows[r]->alive = false;
+		removed++;
+	}
+
+	double removeTerm(Row *r, int x) {
+		for(int i = 0; i < r->terms.count(); i++)
+			if(r->terms[i].fst == x) {
+				double a = r->terms[i].snd;
+				r->terms[i] = r->terms.top();
+				r->terms.pop();
+				return a;
+			}
+		return 0;
+	}
+
+	void fix(int x, double v) {
+		Column *c = cols[x];
+		if(c->state != KEPT)
+			return;
+		if(v < c->lb - eps || v > c->ub + eps || (c->integer && !isInt(v))) {
+			fail(_ << "infeasible value " << v << " for " << c->var->name());
+			return;
+		}
+		if(c->integer)
+			v = round(v);
+		c->state = FIXED;
+		c->e = v;
+		fixed++;
+		elim.add(x);
+		for(auto r: c->rows)
+			if(rows[r]->alive) {
+				double a = removeTerm(rows[r], x);
+				if(a != 0) {
+					rows[r]->cst -= a * v;
+					push(r);
+				}
+			}
+		offset += c->obj * v;
+		c->obj = 0;
+	}
+
+	void substitute(int x, double k, int y, double e) {
+		Column *c = cols[x];
+		c->state = SUBST;
+		c->k = k;
+		c->e = e;
+		c->by = y;
+		subst++;
+		elim.add(x);
+		for(auto r: c->rows)
+			if(rows[r]->alive) {
+				double a = removeTerm(rows[r], x);
+				if(a != 0) {
+					rows[r]->cst -= a * e;
+					addTerm(r, y, a * k);
+					push(r);
+				}
+			}
+		cols[y]->obj += c->obj * k;
+		offset += c->obj * e;
+		c->obj = 0;
+
+		// transfer the bounds of x to y
+		if(k > 0) {
+			lower(y, (c->lb - e) / k);
+			if(c->ub != inf)
+				upper(y, (c->ub - e) / k);
+		}
+		else {
+			if(c->ub != inf)
+				lower(y, (c->ub - e) / k);
+			upper(y, (c->lb - e) / k);
+		}
+	}
+
+	void lower(int x, double v) {
+		Column *c = cols[x];
+		if(c->state != KEPT)
+			return;
+		if(c->integer)
+			v = ceil(v - eps);
+		if(v <= c->lb + eps)
+			return;
+		c->lb = v;
+		update(x);
+	}
+
+	void upper(int x, double v) {
+		Column *c = cols[x];
+		if(c->state != KEPT)
+			return;
+		if(c->integer)
+			v = floor(v + eps);
+		if(v >= c->ub - eps)
+			return;
+		c->ub = v;
+		update(x);
+	}
+
+	void update(int x) {
+		Column *c = cols[x];
+		if(c->lb > c->ub + eps)
+			fail(_ << "empty domain for " << c->var->name());
+		else if(c->ub - c->lb <= eps)
+			fix(x, c->lb);
+		else
+			for(auto r: c->rows)
+				push(r);
+	}
+
+	static bool satisfied(double v, Constraint::comparator_t comp, double k) {
+		switch(comp) {
+		case Constraint::LT:	return v < k;
+		case Constraint::LE:	return v <= k + eps;
+		case Constraint::EQ:	return fabs(v - k) <= eps;
+		case Constraint::GE:	return v >= k - eps;
+		case Constraint::GT:	return v > k;
+		default:				return true;
+		}
+	}
+
+	void process(int ri) {
+		Row *r = rows[ri];
+		r->queued = false;
+		if(!r->alive)
+			return;
+
+		// remove null terms
+		int j = 0;
+		for(int i = 0; i < r->terms.count(); i++)
+			if(fabs(r->terms[i].snd) > eps)
+				r->terms[j++] = r->terms[i];
+		r->terms.setLength(j);
+
+		// empty row
+		if(r->terms.isEmpty()) {
+			if(!satisfied(0, r->comp, r->cst))
+				fail(_ << "constraint " << r->label << " is infeasible");
+			kill(ri);
+			return;
+		}
+		if(r->comp != Constraint::LE && r->comp != Constraint::EQ && r->comp != Constraint::GE)
+			return;
+
+		// singleton row: bound or fixed value
+		if(r->terms.count() == 1) {
+			int x = r->terms[0].fst;
+			double a = r->terms[0].snd, v = r->cst / a;
+			kill(ri);
+			if(r->comp == Constraint::EQ)
+				fix(x, v);
+			else if((r->comp == Constraint::LE) == (a > 0))
+				upper(x, v);
+			else
+				lower(x, v);
+			return;
+		}
+
+		// doubleton equality: x = k * y + e
+		if(r->comp == Constraint::EQ && r->terms.count() == 2)
+			for(int i = 0; i < 2; i++) {
+				int x = r->terms[i].fst, y = r->terms[1 - i].fst;
+				double k = -r->terms[1 - i].snd / r->terms[i].snd, e = r->cst / r->terms[i].snd;
+				if(!cols[x]->integer || (cols[y]->integer && isInt(k) && isInt(e))) {
+					kill(ri);
+					substitute(x, k, y, e);
+					return;
+				}
+			}
+
+		// activity of the row
+		double amin = 0, amax = 0;
+		for(auto t: r->terms) {
+			Column *c = cols[t.fst];
+			if(t.snd > 0) {
+				amin += t.snd * c->lb;
+				amax = c->ub == inf ? inf : amax + t.snd * c->ub;
+			}
+			else {
+				amin = c->ub == inf ? -inf : amin + t.snd * c->ub;
+				amax += t.snd * c->lb;
+			}
+		}
+
+		// infeasible or redundant rows
+		if((r->comp != Constraint::GE && amin > r->cst + eps)
+		|| (r->comp != Constraint::LE && amax < r->cst - eps)) {
+			fail(_ << "constraint " << r->label << " is infeasible");
+			return;
+		}
+		if((r->comp == Constraint::LE && amax <= r->cst + eps)
+		|| (r->comp == Constraint::GE && amin >= r->cst - eps)) {
+			kill(ri);
+			return;
+		}
+
+		// forcing rows: all variables at the bound giving the extreme activity
+		bool at_min = r->comp != Constraint::GE && fabs(amin - r->cst) <= eps;
+		bool at_max = r->comp != Constraint::LE && fabs(amax - r->cst) <= eps;
+		if(at_min || at_max) {
+			kill(ri);
+			terms_t ts = r->terms;
+			for(auto t: ts)
+				fix(t.fst, (t.snd > 0) == at_min ? cols[t.fst]->lb : cols[t.fst]->ub);
+		}
+	}
+
+	// fix the variables not used in any constraint to their best bound
+	void emptyColumns(void) {
+		BitVector used(cols.count());
+		for(auto r: rows)
+			if(r->alive)
+				for(auto t: r->terms)
+					used.set(t.fst);
+		for(int i = 0; i < cols.count(); i++)
+			if(cols[i]->state == KEPT && !used.bit(i)) {
+				double d = max ? cols[i]->obj : -cols[i]->obj;
+				if(d <= 0)
+					fix(i, cols[i]->lb);
+				else if(cols[i]->ub != inf)
+					fix(i, cols[i]->ub);
+			}
+	}
+
+	// merge the rows with the same (normalized) left part
+	void duplicates(void) {
+		Vector<terms_t *> norm;
+		Vector<int> rs;
+		norm.setLength(rows.count());
+		for(int i = 0; i < rows.count(); i++) {
+			norm[i] = nullptr;
+			Row *r = rows[i];
+			if(!r->alive || r->terms.isEmpty() || r->comp == Constraint::LT || r->comp == Constraint::GT)
+				continue;
+			terms_t *ts = new terms_t(r->terms);
+			quicksort(*ts, TermOrder());
+			double a = (*ts)[0].snd;
+			for(int j = 0; j < ts->count(); j++)
+				(*ts)[j].snd /= a;
+			norm[i] = ts;
+			rs.add(i);
+		}
+		quicksort(rs, RowOrder(norm));
+
+		for(int i = 0; i < rs.count();) {
+			int j = i + 1;
+			while(j < rs.count() && RowOrder(norm).doCompare(rs[i], rs[j]) == 0)
+				j++;
+			if(j - i > 1) {
+
+				// compute the interval of the left part
+				double lo = -inf, hi = inf;
+				for(int k = i; k < j; k++) {
+					Row *r = rows[rs[k]];
+					double a = 0;
+					for(auto t: r->terms)
+						if(t.fst == (*norm[rs[k]])[0].fst)
+							a = t.snd;
+					double v = r->cst / a;
+					Constraint::comparator_t c = r->comp;
+					if(a < 0 && c != Constraint::EQ)
+						c = c == Constraint::LE ? Constraint::GE : Constraint::LE;
+					if(c != Constraint::LE)
+						lo = elm::max(lo, v);
+					if(c != Constraint::GE)
+						hi = elm::min(hi, v);
+				}
+				if(lo > hi + eps) {
+					fail(_ << "constraint " << rows[rs[i]]->label << " is infeasible");
+					break;
+				}
+
+				// rebuild the first rows
+				int k = i;
+				if(hi - lo <= eps)
+					set(rs[k++], *norm[rs[i]], Constraint::EQ, lo);
+				else {
+					if(lo != -inf)
+						set(rs[k++], *norm[rs[i]], Constraint::GE, lo);
+					if(hi != inf)
+						set(rs[k++], *norm[rs[i]], Constraint::LE, hi);
+				}
+				for(; k < j; k++)
+					kill(rs[k]);
+			}
+			i = j;
+		}
+
+		for(auto ts: norm)
+			if(ts != nullptr)
+				delete ts;
+	}
+
+	void set(int ri, const terms_t& ts, Constraint::comparator_t comp, double cst) {
+		Row *r = rows[ri];
+		r->terms = ts;
+		r->comp = comp;
+		r->cst = cst;
+		push(ri);
+	}
+
+	Vector<int> todo;
+	Vector<int> elim;
+};
+
+
+/**
+ * @class PresolvedSystem
+ * ILP system that reduces the system before passing it to the ILP plugin.
+ * The systems built by the IPET constraint builders contain many variables
+ * that are trivially related: the variable of a block with one input edge
+ * is equal to the variable of this edge, the edges that are never taken
+ * have a null variable, etc. Reducing the system speeds up the ILP solver.
+ *
+ * The presolving applies repeatedly the following reductions:
+ * @li empty constraints are checked and removed,
+ * @li constraints with only one variable are turned into bounds of the variable,
+ * @li variables whose bounds are equal are fixed and replaced by their value,
+ * @li equalities with two variables are used to replace one variable by the other
+ * (only if the integrality is kept),
+ * @li constraints always satisfied by the bounds of their variables are removed,
+ * @li constraints that can only be satisfied with all variables at their bound
+ * fix these variables,
+ * @li variables not used in any constraint are fixed to their best bound,
+ * @li constraints with the same left part are merged.
+ *
+ * The reduced system is built with the configured ILP plugin and solved.
+ * Then the values of all variables of the original system are computed back.
+ * The reduction statistics are logged at LOG_PROC level.
+ *
+ * @ingroup ilp
+ */
+
+
+/**
+ * Build a presolved system.
+ * @param manager	Manager used to get the ILP system of the plugin.
+ * @param plugin	Name of the ILP plugin.
+ * @param max		True for maximization, false for minimization.
+ */
+PresolvedSystem::PresolvedSystem(Manager *manager, const string& plugin, bool max)
+:	AbstractSystem(max),
+	_man(manager),
+	_plugin(plugin),
+	_sys(nullptr),
+	_value(0),
+	_fixed(0),
+	_subst(0),
+	_removed(0),
+	_bounds(0)
+{ }
+
+
+/**
+ */
+PresolvedSystem::~PresolvedSystem(void) {
+	clear();
+}
+
+
+/**
+ * Clear the reduced system and the solution.
+ */
+void PresolvedSystem::clear(void) {
+	_values.clear();
+	if(_sys != nullptr) {
+		delete _sys;
+		_sys = nullptr;
+	}
+	_value = 0;
+	_fixed = 0;
+	_subst = 0;
+	_removed = 0;
+	_bounds = 0;
+}
+
+
+/**
+ */
+bool PresolvedSystem::solve(WorkSpace *ws) {
+	return solve(ws, Monitor::null);
+}
+
+
+/**
+ */
+bool PresolvedSystem::solve(WorkSpace *ws, otawa::Monitor& mon) {
+	clear();
+	_msg = "";
+
+	// build the presolver system
+	Presolver p(isMaximizing());
+	HashMap<Var *, int> ids;
+	for(VarIter x(this); x(); x++)
+		if(*x) {
+			int i = p.addVar((*x)->type());
+			p.cols[i]->var = *x;
+			ids.put(*x, i);
+		}
+	int cnt = 0;
+	for(ConstIter c(this); c(); c++)
+		if(*c) {
+			int r = p.addRow((*c)->label(), (*c)->comparator(), (*c)->constant());
+			for(Constraint::TermIterator t(*c); t(); t++)
+				if((*t).fst == nullptr)
+					p.rows[r]->cst -= (*t).snd;
+				else
+					p.addTerm(r, ids.get((*t).fst, -1), (*t).snd);
+			cnt++;
+		}
+	for(ObjTermIterator t(this); t(); t++)
+		if((*t).fst == nullptr)
+			p.addOffset((*t).snd);
+		else
+			p.addObject(ids.get((*t).fst, -1), (*t).snd);
+
+	// reduce it
+	if(!p.run()) {
+		_msg = _ << "presolve: " << p.reason;
+		return false;
+	}
+	_fixed = p.fixed;
+	_subst = p.subst;
+	_removed = p.removed;
+
+	// build the reduced system
+	_sys = _man->newILPSystem(_plugin, isMaximizing());
+	if(_sys == nullptr) {
+		_msg = "no ILP solver available";
+		return false;
+	}
+	Vector<Var *> vars;
+	vars.setLength(p.cols.count());
+	for(int i = 0; i < p.cols.count(); i++) {
+		Presolver::Column *c = p.cols[i];
+		vars[i] = nullptr;
+		if(c->state != Presolver::KEPT)
+			continue;
+		vars[i] = _sys->newVar(c->var->type(), c->var->name());
+		if(c->lb > 0) {
+			_sys->newConstraint(Constraint::GE, c->lb)->addLeft(1, vars[i]);
+			_bounds++;
+		}
+		if(c->ub != std::numeric_limits<double>::infinity() && !(c->var->type() == Var::BIN && c->ub >= 1)) {
+			_sys->newConstraint(Constraint::LE, c->ub)->addLeft(1, vars[i]);
+			_bounds++;
+		}
+		if(c->obj != 0)
+			_sys->addObjectFunction(c->obj, vars[i]);
+	}
+	for(auto r: p.rows)
+		if(r->alive) {
+			Constraint *c = _sys->newConstraint(r->label, r->comp, r->cst);
+			for(auto t: r->terms)
+				c->addLeft(t.snd, vars[t.fst]);
+		}
+	if(mon.logFor(Monitor::LOG_PROC))
+		mon.log << "\tpresolve: " << _sys->countVars() << " variables (" << ids.count() << " before, "
+				<< _fixed << " fixed, " << _subst << " substituted), "
+				<< _sys->countConstraints() << " constraints (" << cnt << " before, "
+				<< _removed << " removed, " << _bounds << " bounds)\n";
+
+	// solve it
+	if(_sys->countVars() != 0 && !_sys->solve(ws, mon)) {
+		_msg = _sys->lastErrorMessage();
+		return false;
+	}
+
+	// compute back the values of the variables
+	Vector<double> vals;
+	vals.setLength(p.cols.count());
+	for(int i = 0; i < p.cols.count(); i++)
+		vals[i] = vars[i] == nullptr ? 0 : _sys->valueOf(vars[i]);
+	p.complete(vals);
+	_value = p.offset;
+	for(int i = 0; i < p.cols.count(); i++) {
+		_values.put(p.cols[i]->var, vals[i]);
+		_value += p.cols[i]->obj * vals[i];
+	}
+	return true;
+}
+
+
+/**
+ */
+double PresolvedSystem::valueOf(Var *var) {
+	return _values.get(var, 0);
+}
+
+
+/**
+ */
+double PresolvedSystem::value(void) {
+	return _value;
+}
+
+
+/**
+ */
+string PresolvedSystem::lastErrorMessage(void) {
+	return _msg;
+}
+
+
+/**
+ */
+ILPPlugin *PresolvedSystem::plugin(void) {
+	if(_sys != nullptr)
+		return _sys->plugin();
+	else
+		return nullptr;
+}
+
+
+/**
+ * @fn System *PresolvedSystem::reduced(void) const;
+ * Get the reduced system passed to the ILP plugin by the last solve().
+ * @return	Reduced system or null.
+ */
+
+
+/**
+ * @fn int PresolvedSystem::countFixed(void) const;
+ * Get the number of variables fixed to a constant by the last presolve.
+ * @return	Fixed variable count.
+ */
+
+
+/**
+ * @fn int PresolvedSystem::countSubstituted(void) const;
+ * Get the number of variables replaced by another variable by the last presolve.
+ * @return	Substituted variable count.
+ */
+
+
+/**
+ * @fn int PresolvedSystem::countRemoved(void) const;
+ * Get the number of constraints removed by the last presolve.
+ * @return	Removed constraint count.
+ */
+
+
+/**
+ * @fn int PresolvedSystem::countBounds(void) const;
+ * Get the number of variable bound constraints added by the last presolve.
+ * @return	Bound constraint count.
+ */
+
+} }	// otawa::ilp
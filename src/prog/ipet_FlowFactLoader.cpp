@@ -24,6 +24,7 @@
 #include <otawa/cfg.h>
 #include <otawa/cfg/Dominance.h>
 #include <otawa/cfg/Loop.h>
+#include <otawa/cfg/Virtualizer.h>
 #include <otawa/flowfact/features.h>
 #include <otawa/flowfact/conflict.h>  
 #include <otawa/ipet/FlowFactLoader.h>
@@ -71,7 +72,8 @@ FlowFactLoader::FlowFactLoader(p::declare& r)
  	total(0),
  	min(0),
  	isIntoConstraint(false),
-	dom(nullptr)
+	dom(nullptr),
+	vctx(nullptr)
 {
 }
 
@@ -206,7 +208,9 @@ void FlowFactLoader::transferConflict(Inst *source, otawa::Block *b, const Conte
  */
 bool FlowFactLoader::transfer(Inst *source, Block *bb, const ContextualPath& path) {
 	bool all = true;
-	transferConflict( source,  bb,   path, true); 
+	PropList& props = vctx == nullptr ? *bb : vctx->props(bb);
+	if(vctx == nullptr)
+		transferConflict( source,  bb,   path, true); 
 
 	// look for MAX_ITERATION
 	if(max < 0) {
@@ -214,7 +218,7 @@ bool FlowFactLoader::transfer(Inst *source, Block *bb, const ContextualPath& pat
 		if(max < 0)
 			all = false;
 		else {
-			MAX_ITERATION(bb) = max;
+			MAX_ITERATION(props) = max;
 			if(total < 0)
 				found_loop++;
 			if(logFor(LOG_BB))
@@ -228,7 +232,7 @@ bool FlowFactLoader::transfer(Inst *source, Block *bb, const ContextualPath& pat
 		if(min < 0)
 			all = false;
 		else {
-			MIN_ITERATION(bb) = min;
+			MIN_ITERATION(props) = min;
 			if(logFor(LOG_BB))
 				log << "\t\t\tMIN_ITERATION(" << path << ":" << bb << ") = " << min << io::endl;
 		}
@@ -240,7 +244,7 @@ bool FlowFactLoader::transfer(Inst *source, Block *bb, const ContextualPath& pat
 		if(total < 0)
 			all = false;
 		else {
-			TOTAL_ITERATION(bb) = total;
+			TOTAL_ITERATION(props) = total;
 			if(max < 0)
 				found_loop++;
 			if(logFor(LOG_BB))
@@ -333,6 +337,8 @@ void FlowFactLoader::processBB(WorkSpace *ws, CFG *cfg, Block *b, const Contextu
 	if(logFor(LOG_BB))
 		log << "\t\tlooking bound for loop headed by " << b << io::endl;
 	scan(b, b, path);
+	if(VIRTUAL_CONTEXTS(cfg) != nullptr)
+		scanContexts(cfg, b, path);
 
 	// warning for missing loops
 	// TODO
@@ -395,6 +401,67 @@ bool FlowFactLoader::scan(Block *v, Block *t, const ContextualPath& path) {
 }
 
 
+/**
+ * In the sharing mode of the @ref Virtualizer, look for the bounds of a loop
+ * in each inlining context of its CFG and record them on the contexts
+ * (VirtualContext::props()). The shared header is then bounded by the loosest
+ * of them and is left unbounded if one context has no bound.
+ * @param cfg	Shared CFG.
+ * @param h		Loop header.
+ * @param path	Context path of the header in the CFG.
+ */
+void FlowFactLoader::scanContexts(CFG *cfg, Block *h, const ContextualPath& path) {
+	ContextualPath base = *CONTEXT(cfg);
+	int found = found_loop, line = line_loop;
+
+	// look for the bounds in each context
+	for(VirtualContext *ctx = VIRTUAL_CONTEXTS(cfg); ctx != nullptr; ctx = ctx->next()) {
+		ContextualPath cpath = ctx->path();
+		for(int i = base.count(); i < path.count(); i++)
+			cpath.push(path[i]);
+		max = -1;
+		total = -1;
+		min = -1;
+		vctx = ctx;
+		scan(h, h, cpath);
+		vctx = nullptr;
+	}
+	found_loop = found;
+	line_loop = line;
+
+	// merge them on the shared header
+	max = 0;
+	total = 0;
+	min = -1;
+	for(VirtualContext *ctx = VIRTUAL_CONTEXTS(cfg); ctx != nullptr; ctx = ctx->next()) {
+		const PropList& props = ctx->propsOf(h);
+		int cmax = MAX_ITERATION(props), ctotal = TOTAL_ITERATION(props), cmin = MIN_ITERATION(props);
+		if(max >= 0)
+			max = cmax < 0 ? -1 : (cmax > max ? cmax : max);
+		if(total >= 0)
+			total = ctotal < 0 ? -1 : total + ctotal;
+		if(ctx == VIRTUAL_CONTEXTS(cfg))
+			min = cmin;
+		else if(min >= 0)
+			min = cmin < 0 ? -1 : (cmin < min ? cmin : min);
+	}
+	if(max >= 0)
+		MAX_ITERATION(h) = max;
+	else
+		MAX_ITERATION(h).remove();
+	if(total >= 0)
+		TOTAL_ITERATION(h) = total;
+	else
+		TOTAL_ITERATION(h).remove();
+	if(min >= 0)
+		MIN_ITERATION(h) = min;
+	else
+		MIN_ITERATION(h).remove();
+	if(logFor(LOG_BB))
+		log << "\t\t\tshared bounds of " << h << ": max = " << max << ", total = " << total << ", min = " << min << io::endl;
+}
+
+
 /**
  * This feature ensures that flow facts information (at less the loop bounds)
  * has been put on the CFG of the current task.
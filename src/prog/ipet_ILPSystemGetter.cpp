@@ -21,9 +21,11 @@
  */
 
 #include <elm/assert.h>
+#include <otawa/ilp/PresolvedSystem.h>
 #include <otawa/ilp/System.h>
 #include <otawa/ipet/features.h>
 #include <otawa/ipet/ILPSystemGetter.h>
+#include <otawa/ipet/NetworkSystem.h>
 #include <otawa/prog/Manager.h>
 #include <otawa/prog/Process.h>
 #include <otawa/prop/DeletableProperty.h>
@@ -40,6 +42,8 @@ namespace otawa { namespace ipet {
  *
  * @par Configuration
  * @li @ref ILP_PLUGIN_NAME
+ * @li @ref NETWORK_SOLVER
+ * @li @ref PRESOLVE
  */
 
 
@@ -52,7 +56,7 @@ p::declare ILPSystemGetter::reg = p::init("otawa::ipet::ILPSystemGetter", Versio
 /**
  * Build the processor.
  */
-ILPSystemGetter::ILPSystemGetter(void): Processor(reg), max(true) {
+ILPSystemGetter::ILPSystemGetter(void): Processor(reg), max(true), network(false), presolve(false) {
 }
 
 
@@ -60,9 +64,21 @@ ILPSystemGetter::ILPSystemGetter(void): Processor(reg), max(true) {
  */
 void ILPSystemGetter::processWorkSpace(WorkSpace *ws) {
 	ASSERT(ws);
-	ilp::System *sys = ws->process()->manager()->newILPSystem(plugin_name, max);
+	ilp::System *sys;
+	if(network)
+		sys = new NetworkSystem(ws->process()->manager(), plugin_name, max, presolve);
+	else if(presolve)
+		sys = new ilp::PresolvedSystem(ws->process()->manager(), plugin_name, max);
+	else
+		sys = ws->process()->manager()->newILPSystem(plugin_name, max);
 	if(logFor(LOG_DEPS)) {
-		log << "\tmaking an ILP system from \""
+		if(network)
+			log << "\tmaking a network system with fallback to ";
+		else if(presolve)
+			log << "\tmaking a presolved ILP system from ";
+		else
+			log << "\tmaking an ILP system from ";
+		log << "\""
 			<< (plugin_name ? plugin_name : "default")
 			<< "\" plugin\n";
 		if(max)
@@ -82,6 +98,8 @@ void ILPSystemGetter::configure(const PropList &props) {
 	plugin_name = ILP_PLUGIN_NAME(props);
 	Processor::configure(props);
 	max = MAXIMIZE(props);
+	network = NETWORK_SOLVER(props);
+	presolve = PRESOLVE(props);
 }
 
 
@@ -143,4 +161,16 @@ p::feature ILP_SYSTEM_FEATURE("otawa::ipet::ILP_SYSTEM_FEATURE", new Maker<ILPSy
  */
 p::id<bool> MAXIMIZE("otawa::ipet::MAXIMIZE", true);
 
+/**
+ * This property is used to configure @ref ILP_SYSTEM_FEATURE. If set to true,
+ * the ILP system is reduced before being passed to the ILP plugin
+ * (see @ref ilp::PresolvedSystem). Default is false.
+ *
+ * @par Features
+ *	* @ref ILP_SYSTEM_FEATURE
+ *
+ * @ingroup ipet
+ */
+p::id<bool> PRESOLVE("otawa::ipet::PRESOLVE", false);
+
 } } // otawa::ipet
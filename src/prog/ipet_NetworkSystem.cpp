@@ -0,0 +1,749 @@
+/*
+ *	NetworkSystem class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/quicksort.h>
+#include <elm/util/BitVector.h>
+#include <otawa/cfg/features.h>
+#include <otawa/ilp/PresolvedSystem.h>
+#include <otawa/ipet/features.h>
+#include <otawa/ipet/NetworkSystem.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/prog/WorkSpace.h>
+
+namespace otawa { namespace ipet {
+
+// loop body (or whole CFG) handled by the network solver
+class Region {
+public:
+	Region(Block *h): start(h), parent(nullptr), max(-1), min(0), iter(-1), back(nullptr) { }
+	Block *start;
+	Region *parent;
+	BitVector body;
+	int max, min;
+	Vector<Edge *> backs;
+	double iter;
+	Edge *back;
+	Vector<Pair<Edge *, double> > exits;
+	inline int size(void) const { return body.countBits(); }
+};
+
+class RegionSize {
+public:
+	static int compare(Region *r1, Region *r2) { return r1->size() - r2->size(); }
+	int doCompare(Region *r1, Region *r2) const { return compare(r1, r2); }
+};
+
+
+// network of a CFG
+class Graph {
+public:
+	Graph(CFG *g): cfg(g), top(nullptr), cost(-1), mult(0), state(0) { }
+	~Graph(void) { for(auto r: loops) delete r; delete top; }
+	CFG *cfg;
+	Vector<Region *> loops;
+	Region *top;
+	Vector<Region *> inner;
+	Vector<double> in;
+	Vector<Edge *> best;
+	Vector<double> bcount;
+	HashMap<Edge *, double> ecount;
+	double cost, mult;
+	int state;
+};
+
+
+// network solver
+class Network {
+public:
+
+	Network(WorkSpace *ws): coll(INVOLVED_CFGS(ws)), value(0) { }
+	~Network(void) {
+		for(auto g: graphs)
+			delete g;
+		for(HashMap<Block *, Region *>::Iter l(loops); l(); l++)
+			delete *l;
+	}
+
+	bool make(void) {
+		if(coll == nullptr)
+			return fail("no CFG collection");
+		in_ok = BitVector(coll->countBlocks());
+		out_ok = BitVector(coll->countBlocks());
+		call_ok = BitVector(coll->count());
+		for(auto g: *coll) {
+			graphs.add(new Graph(g));
+			for(auto v: *g) {
+				ilp::Var *x = VAR(v);
+				if(x == nullptr)
+					return fail(_ << "no variable for " << v);
+				blocks.put(x, v);
+				for(Block::EdgeIter e = v->outs(); e(); e++) {
+					ilp::Var *y = VAR(*e);
+					if(y == nullptr)
+						return fail(_ << "no variable for " << *e);
+					edges.put(y, *e);
+				}
+			}
+		}
+		return true;
+	}
+
+	bool object(ilp::Var *x, double c) {
+		if(x == nullptr)
+			value += c;
+		else if(c < 0)
+			return fail(_ << "negative objective coefficient for " << x->name());
+		else if(blocks.hasKey(x))
+			bweight.put(blocks.get(x, nullptr), bweight.get(blocks.get(x, nullptr), 0) + c);
+		else if(edges.hasKey(x))
+			eweight.put(edges.get(x, nullptr), eweight.get(edges.get(x, nullptr), 0) + c);
+		else
+			return fail(_ << "objective variable " << x->name() << " is not structural");
+		return true;
+	}
+
+	bool constraint(ilp::Constraint *c) {
+
+		// collect terms
+		Vector<Pair<Block *, double> > bs;
+		Vector<Pair<Edge *, double> > es;
+		for(ilp::Constraint::TermIterator t(c); t(); t++) {
+			if((*t).snd == 0)
+				continue;
+			if(blocks.hasKey((*t).fst))
+				bs.add(pair(blocks.get((*t).fst, nullptr), (*t).snd));
+			else if(edges.hasKey((*t).fst))
+				es.add(pair(edges.get((*t).fst, nullptr), (*t).snd));
+			else
+				return unsupported(c);
+		}
+
+		// structural, entry and call constraints
+		if(c->comparator() == ilp::Constraint::EQ) {
+			if(bs.count() == 1 && es.isEmpty() && c->constant() == bs[0].snd
+			&& bs[0].fst == coll->entry()->entry()) {
+				entry_ok = true;
+				return true;
+			}
+			if(bs.count() == 1 && c->constant() == 0) {
+				Block *v = bs[0].fst;
+				double a = bs[0].snd;
+				bool ins = es.count() == v->countIns(), outs = es.count() == v->countOuts();
+				for(auto e: es) {
+					ins = ins && e.fst->sink() == v && e.snd == -a;
+					outs = outs && e.fst->source() == v && e.snd == -a;
+				}
+				if(ins)
+					in_ok.set(v->id());
+				if(outs)
+					out_ok.set(v->id());
+				if(es.isEmpty() && v->isEntry() && v->cfg()->callers().isEmpty())
+					call_ok.set(v->cfg()->index());
+				if(ins || outs)
+					return true;
+			}
+			if(es.isEmpty() && c->constant() == 0) {
+				int i = 0;
+				while(i < bs.count() && !bs[i].fst->isEntry())
+					i++;
+				if(i < bs.count()) {
+					CFG *g = bs[i].fst->cfg();
+					double a = bs[i].snd;
+					bool ok = bs.count() == g->callers().count() + 1;
+					for(int j = 0; ok && j < bs.count(); j++)
+						if(j != i)
+							ok = bs[j].snd == -a && bs[j].fst->isCall() && bs[j].fst->toSynth()->callee() == g;
+					if(ok) {
+						call_ok.set(g->index());
+						return true;
+					}
+				}
+			}
+		}
+
+		// loop bounds: sum back - N sum entry <= 0 (max) or >= 0 (min)
+		else if((c->comparator() == ilp::Constraint::LE || c->comparator() == ilp::Constraint::GE)
+		&& bs.isEmpty() && !es.isEmpty() && c->constant() == 0) {
+			Block *h = es[0].fst->sink();
+			double a = 0, b = 0;
+			for(auto e: es) {
+				if(e.fst->sink() != h)
+					return unsupported(c);
+				double &r = e.snd > 0 ? a : b;
+				if(r != 0 && r != e.snd)
+					return unsupported(c);
+				r = e.snd;
+			}
+			int n = 0;
+			if(b != 0) {
+				if(a == 0 || -b / a != int(-b / a))
+					return unsupported(c);
+				n = int(-b / a);
+			}
+			Region *l = loops.get(h, nullptr);
+			if(l == nullptr) {
+				l = new Region(h);
+				loops.put(h, l);
+				for(auto e: es)
+					if(e.snd > 0)
+						l->backs.add(e.fst);
+			}
+			else
+				for(auto e: es)
+					if(e.snd > 0 && !l->backs.contains(e.fst))
+						return unsupported(c);
+			if(c->comparator() == ilp::Constraint::LE)
+				l->max = l->max < 0 ? n : elm::min(l->max, n);
+			else
+				l->min = elm::max(l->min, n);
+			return true;
+		}
+
+		return unsupported(c);
+	}
+
+	bool solve(void) {
+
+		// check the system is complete
+		if(!entry_ok)
+			return fail("no program entry constraint");
+		for(auto g: *coll) {
+			if(g != coll->entry() && !call_ok.bit(g->index()))
+				return fail(_ << "no call constraint for " << g);
+			for(auto v: *g)
+				if((!v->isEntry() && !in_ok.bit(v->id())) || (!v->isExit() && !out_ok.bit(v->id())))
+					return fail(_ << "no structural constraint for " << v);
+		}
+		for(HashMap<Block *, Region *>::Iter l(loops); l(); l++) {
+			Region *r = *l;
+			if(r->max < 0)
+				return fail(_ << "no maximum bound for loop " << r->start);
+			if(r->min > r->max)
+				return fail(_ << "infeasible bounds for loop " << r->start);
+		}
+
+		// compute the CFG costs from the callees to the callers
+		for(auto g: graphs) {
+			g->inner.setLength(g->cfg->count());
+			for(int i = 0; i < g->inner.count(); i++)
+				g->inner[i] = nullptr;
+		}
+		Vector<Graph *> order;
+		if(!visit(graphs[coll->entry()->index()], order))
+			return false;
+
+		// compute the multiplicity of CFGs from the callers to the callees
+		graphs[coll->entry()->index()]->mult = 1;
+		for(int i = order.count() - 1; i >= 0; i--) {
+			Graph *g = order[i];
+			for(auto v: *g->cfg)
+				if(v->isCall() && v->toSynth()->callee() != nullptr)
+					graphs[v->toSynth()->callee()->index()]->mult += g->mult * g->bcount[v->index()];
+		}
+		value += graphs[coll->entry()->index()]->cost;
+		return true;
+	}
+
+	void values(HashMap<ilp::Var *, double>& vals) {
+		for(auto g: graphs)
+			if(g->state == 2)
+				for(auto v: *g->cfg) {
+					vals.put(VAR(v), g->mult * g->bcount[v->index()]);
+					for(Block::EdgeIter e = v->outs(); e(); e++)
+						vals.put(VAR(*e), g->mult * g->ecount.get(*e, 0));
+				}
+	}
+
+	inline double result(void) const { return value; }
+	inline const string& reason(void) const { return _reason; }
+
+private:
+
+	bool fail(const string& msg) { _reason = msg; return false; }
+	bool unsupported(ilp::Constraint *c)
+		{ return fail(_ << "unsupported constraint \"" << c->label() << "\""); }
+
+	// depth-first traversal of the call graph
+	bool visit(Graph *g, Vector<Graph *>& order) {
+		if(g->state == 1)
+			return fail(_ << "recursive call to " << g->cfg);
+		if(g->state == 2)
+			return true;
+		g->state = 1;
+		for(auto v: *g->cfg)
+			if(v->isCall() && v->toSynth()->callee() != nullptr)
+				if(!visit(graphs[v->toSynth()->callee()->index()], order))
+					return false;
+		if(!build(g) || !compute(g))
+			return false;
+		g->state = 2;
+		order.add(g);
+		return true;
+	}
+
+	// build the loop tree of a CFG
+	bool build(Graph *g) {
+		int n = g->cfg->count();
+
+		// build the loop bodies
+		for(auto h: *g->cfg) {
+			Region *l = loops.get(h, nullptr);
+			if(l == nullptr)
+				continue;
+			loops.remove(h);
+			g->loops.add(l);
+			l->body = BitVector(n);
+			l->body.set(h->index());
+			Vector<Block *> todo;
+			for(Block::EdgeIter e = h->ins(); e(); e++)
+				if(l->backs.contains(*e))
+					todo.push(e->source());
+			if(todo.count() != l->backs.count())
+				return fail(_ << "bad back edges for loop " << h);
+			while(!todo.isEmpty()) {
+				Block *v = todo.pop();
+				if(l->body.bit(v->index()))
+					continue;
+				l->body.set(v->index());
+				for(Block::EdgeIter e = v->ins(); e(); e++)
+					todo.push(e->source());
+			}
+			for(auto v: *g->cfg)
+				if(l->body.bit(v->index())) {
+					if(v->isEntry() || v->isExit())
+						return fail(_ << "CFG entry or exit in loop " << h);
+					for(Block::EdgeIter e = v->ins(); e(); e++) {
+						bool inside = l->body.bit(e->source()->index());
+						if(v == h ? inside != l->backs.contains(*e) : !inside)
+							return fail(_ << "irreducible loop at " << h);
+					}
+				}
+		}
+
+		// build the loop tree
+		quicksort(g->loops, RegionSize());
+		g->top = new Region(g->cfg->entry());
+		g->top->body = BitVector(n);
+		g->top->body.set();
+		for(int i = 0; i < g->loops.count(); i++) {
+			Region *l = g->loops[i];
+			for(int j = i + 1; j < g->loops.count() && !l->parent; j++)
+				if(g->loops[j]->body.bit(l->start->index())) {
+					if(!g->loops[j]->body.includes(l->body))
+						return fail(_ << "overlapping loops at " << l->start);
+					l->parent = g->loops[j];
+				}
+			if(!l->parent)
+				l->parent = g->top;
+			for(auto v: *g->cfg)
+				if(l->body.bit(v->index()) && !g->inner[v->index()])
+					g->inner[v->index()] = l;
+		}
+		for(int i = 0; i < n; i++)
+			if(!g->inner[i])
+				g->inner[i] = g->top;
+		return true;
+	}
+
+	// get the child region of r containing v (null if v is directly in r)
+	inline Region *child(Graph *g, Region *r, Block *v) {
+		Region *c = g->inner[v->index()];
+		if(c == r)
+			return nullptr;
+		while(c->parent != r)
+			c = c->parent;
+		return c;
+	}
+
+	// get the representative of v in region r
+	inline Block *rep(Graph *g, Region *r, Block *v) {
+		Region *c = child(g, r, v);
+		return c == nullptr ? v : c->start;
+	}
+
+	// weight of a block
+	inline double weight(Block *v) {
+		double w = bweight.get(v, 0);
+		if(v->isCall() && v->toSynth()->callee() != nullptr)
+			w += graphs[v->toSynth()->callee()->index()]->cost;
+		return w;
+	}
+
+	// compute the longest paths of a CFG and its counts
+	bool compute(Graph *g) {
+		int n = g->cfg->count();
+		g->in.setLength(n);
+		g->best.setLength(n);
+		g->bcount.setLength(n);
+		for(int i = 0; i < n; i++) {
+			g->in[i] = -1;
+			g->best[i] = nullptr;
+			g->bcount[i] = 0;
+		}
+		for(auto l: g->loops)
+			if(!longest(g, l))
+				return false;
+		if(!longest(g, g->top))
+			return false;
+		Block *x = g->cfg->exit();
+		if(x == nullptr || g->in[x->index()] < 0)
+			return fail(_ << "exit of " << g->cfg << " is not reachable");
+		g->cost = g->in[x->index()] + weight(x);
+		g->bcount[x->index()] += 1;
+		if(x != g->top->start)
+			walk(g, g->top, g->best[x->index()], 1);
+		return true;
+	}
+
+	// outputs of a representative: (edge, value relative to the representative input)
+	void outputs(Graph *g, Region *r, Block *v, Vector<Pair<Edge *, double> >& outs) {
+		outs.clear();
+		Region *c = child(g, r, v);
+		if(c == nullptr)
+			for(Block::EdgeIter e = v->outs(); e(); e++)
+				outs.add(pair(*e, weight(v) + eweight.get(*e, 0)));
+		else
+			for(auto x: c->exits)
+				outs.add(pair(x.fst, x.snd < 0 ? -1 : c->max * c->iter + x.snd));
+	}
+
+	// compute the longest paths of a region (topological order on the region DAG)
+	bool longest(Graph *g, Region *r) {
+		Vector<Block *> reps;
+		HashMap<Block *, int> deg;
+		Vector<Pair<Edge *, double> > outs;
+		for(auto v: *g->cfg)
+			if(r->body.bit(v->index()) && rep(g, r, v) == v) {
+				reps.add(v);
+				deg.put(v, 0);
+				g->in[v->index()] = -1;
+				g->best[v->index()] = nullptr;
+			}
+		for(auto v: reps) {
+			outputs(g, r, v, outs);
+			for(auto o: outs) {
+				Block *w = o.fst->sink();
+				if(w != r->start && r->body.bit(w->index()))
+					deg.put(rep(g, r, w), deg.get(rep(g, r, w), 0) + 1);
+			}
+		}
+
+		// traverse in topological order
+		Vector<Block *> todo;
+		for(auto v: reps)
+			if(deg.get(v, 0) == 0)
+				todo.push(v);
+		g->in[r->start->index()] = 0;
+		int done = 0;
+		while(!todo.isEmpty()) {
+			Block *v = todo.pop();
+			done++;
+			double in = g->in[v->index()];
+			outputs(g, r, v, outs);
+			for(auto o: outs) {
+				double at = in < 0 || o.snd < 0 ? -1 : in + o.snd;
+				Block *w = o.fst->sink();
+				if(w == r->start) {
+					if(at > r->iter) {
+						r->iter = at;
+						r->back = o.fst;
+					}
+				}
+				else if(!r->body.bit(w->index()))
+					r->exits.add(pair(o.fst, at));
+				else {
+					Block *wr = rep(g, r, w);
+					if(at > g->in[wr->index()]) {
+						g->in[wr->index()] = at;
+						g->best[wr->index()] = o.fst;
+					}
+					int d = deg.get(wr, 0) - 1;
+					deg.put(wr, d);
+					if(d == 0)
+						todo.push(wr);
+				}
+			}
+		}
+		if(done != reps.count())
+			return fail(_ << "unbounded cycle in " << g->cfg);
+		if(r != g->top && r->iter < 0)
+			return fail(_ << "no iteration path for loop " << r->start);
+		return true;
+	}
+
+	// count f times the path from the start of region r to the edge e
+	void walk(Graph *g, Region *r, Edge *e, double f) {
+		while(true) {
+			Block *v = e->source();
+			Region *c = child(g, r, v);
+			if(c != nullptr) {
+				walk(g, c, e, f);
+				if(c->max > 0)
+					walk(g, c, c->back, c->max * f);
+				v = c->start;
+			}
+			else {
+				g->ecount.put(e, g->ecount.get(e, 0) + f);
+				g->bcount[v->index()] += f;
+			}
+			if(v == r->start)
+				return;
+			e = g->best[v->index()];
+		}
+	}
+
+	const CFGCollection *coll;
+	HashMap<ilp::Var *, Block *> blocks;
+	HashMap<ilp::Var *, Edge *> edges;
+	HashMap<Block *, double> bweight;
+	HashMap<Edge *, double> eweight;
+	HashMap<Block *, Region *> loops;
+	BitVector in_ok, out_ok, call_ok;
+	bool entry_ok = false;
+	Vector<Graph *> graphs;
+	double value;
+	string _reason;
+};
+
+
+/**
+ * @class NetworkSystem
+ * ILP system solving natively, without ILP solver, the systems made only
+ * of the structural constraints of the CFGs (@ref BasicConstraintsBuilder),
+ * of maximum and minimum loop bounds (@ref FlowFactConstraintBuilder)
+ * and of an objective function with non-negative coefficients on block
+ * and edge variables (@ref BasicObjectFunctionBuilder).
+ *
+ * Such a system is a max-cost flow problem that is solved by dynamic programming
+ * on the loop tree of each CFG: the loops are collapsed from the innermost
+ * to the outermost, the cost of a loop being its maximum bound times its
+ * longest iteration path plus the longest path to each of its exits.
+ * The cost of a CFG is then used as the weight of the blocks calling it.
+ * The execution counts of all variables are rebuilt from the longest paths.
+ *
+ * If the system contains any other constraint (flow facts other than
+ * loop bounds, conflicts, execution graph constraints, etc.), irreducible loops,
+ * recursive calls or unbounded loops, or if it is minimized, the system is
+ * copied in a system of the configured ILP plugin that is used to solve it.
+ *
+ * The network system is selected by configuring @ref ILPSystemGetter
+ * with @ref NETWORK_SOLVER.
+ *
+ * @ingroup ipet
+ */
+
+
+/**
+ * Build a network system.
+ * @param manager	Manager used to get the fallback ILP system.
+ * @param plugin	Name of the ILP plugin used as fallback.
+ * @param max		True for maximization, false for minimization.
+ * @param presolve	True to reduce the system before passing it to the ILP plugin
+ * 					(see @ref ilp::PresolvedSystem).
+ */
+NetworkSystem::NetworkSystem(Manager *manager, const string& plugin, bool max, bool presolve)
+:	AbstractSystem(max),
+	_man(manager),
+	_plugin(plugin),
+	_native(false),
+	_presolve(presolve),
+	_value(0),
+	_fallback(nullptr)
+{ }
+
+
+/**
+ */
+NetworkSystem::~NetworkSystem(void) {
+	clear();
+}
+
+
+/**
+ * Clear the solution.
+ */
+void NetworkSystem::clear(void) {
+	_values.clear();
+	_map.clear();
+	if(_fallback != nullptr) {
+		delete _fallback;
+		_fallback = nullptr;
+	}
+	_native = false;
+	_value = 0;
+}
+
+
+/**
+ */
+bool NetworkSystem::solve(WorkSpace *ws) {
+	return solve(ws, Monitor::null);
+}
+
+
+/**
+ */
+bool NetworkSystem::solve(WorkSpace *ws, otawa::Monitor& mon) {
+	clear();
+	string reason;
+	if(solveNative(ws, reason)) {
+		_native = true;
+		if(mon.logFor(Monitor::LOG_PROC))
+			mon.log << "\tsystem solved by the network solver\n";
+		return true;
+	}
+	if(mon.logFor(Monitor::LOG_PROC))
+		mon.log << "\tnetwork solver not applicable (" << reason << "), using ILP plugin\n";
+	return solveFallback(ws, mon);
+}
+
+
+/**
+ * Try to solve the system with the network solver.
+ * @param ws		Current workspace.
+ * @param reason	Set to the reason of failure.
+ * @return			True if the system has been solved, false else.
+ */
+bool NetworkSystem::solveNative(WorkSpace *ws, string& reason) {
+	if(!isMaximizing()) {
+		reason = "minimization";
+		return false;
+	}
+	if(ws == nullptr) {
+		reason = "no workspace";
+		return false;
+	}
+	Network net(ws);
+	bool ok = net.make();
+	for(ObjTermIterator t(this); ok && t(); t++)
+		ok = net.object((*t).fst, (*t).snd);
+	for(ConstIter c(this); ok && c(); c++)
+		if(*c)
+			ok = net.constraint(*c);
+	if(ok)
+		ok = net.solve();
+	if(!ok) {
+		reason = net.reason();
+		return false;
+	}
+	net.values(_values);
+	_value = net.result();
+	return true;
+}
+
+
+/**
+ * Solve the system by copying it to a system of the ILP plugin.
+ * @param ws	Current workspace.
+ * @param mon	Monitor to use.
+ * @return		True if the system has been solved, false else.
+ */
+bool NetworkSystem::solveFallback(WorkSpace *ws, otawa::Monitor& mon) {
+	if(_presolve)
+		_fallback = new ilp::PresolvedSystem(_man, _plugin, isMaximizing());
+	else
+		_fallback = _man->newILPSystem(_plugin, isMaximizing());
+	if(_fallback == nullptr) {
+		_msg = "no ILP solver available";
+		return false;
+	}
+	for(VarIter x(this); x(); x++)
+		if(*x)
+			_map.put(*x, _fallback->newVar((*x)->type(), (*x)->name()));
+	for(ConstIter c(this); c(); c++)
+		if(*c) {
+			ilp::Constraint *fc = _fallback->newConstraint((*c)->label(), (*c)->comparator(), (*c)->constant());
+			for(ilp::Constraint::TermIterator t(*c); t(); t++)
+				fc->add((*t).snd, _map.get((*t).fst, nullptr));
+		}
+	for(ObjTermIterator t(this); t(); t++)
+		_fallback->addObjectFunction((*t).snd, (*t).fst == nullptr ? nullptr : _map.get((*t).fst, nullptr));
+	bool ok = _fallback->solve(ws, mon);
+	if(!ok)
+		_msg = _fallback->lastErrorMessage();
+	return ok;
+}
+
+
+/**
+ */
+double NetworkSystem::valueOf(ilp::Var *var) {
+	if(_fallback != nullptr)
+		return _fallback->valueOf(_map.get(var, nullptr));
+	else
+		return _values.get(var, 0);
+}
+
+
+/**
+ */
+double NetworkSystem::value(void) {
+	if(_fallback != nullptr)
+		return _fallback->value();
+	else
+		return _value;
+}
+
+
+/**
+ */
+string NetworkSystem::lastErrorMessage(void) {
+	return _msg;
+}
+
+
+/**
+ */
+ilp::ILPPlugin *NetworkSystem::plugin(void) {
+	if(_fallback != nullptr)
+		return _fallback->plugin();
+	else
+		return nullptr;
+}
+
+
+/**
+ * @fn bool NetworkSystem::isNative(void) const;
+ * Test if the last solve() has been performed by the network solver.
+ * @return	True if natively solved, false if solved by the ILP plugin.
+ */
+
+
+/**
+ * @fn ilp::System *NetworkSystem::fallback(void) const;
+ * Get the ILP plugin system used to solve the last system if any.
+ * @return	Fallback system or null.
+ */
+
+
+/**
+ * Configure @ref ILPSystemGetter to build a @ref NetworkSystem that solves
+ * natively the IPET systems only made of structural constraints and loop
+ * bounds and falls back to the ILP plugin for the other systems.
+ *
+ * @par Features
+ *	* @ref ILP_SYSTEM_FEATURE
+ *
+ * @ingroup ipet
+ */
+p::id<bool> NETWORK_SOLVER("otawa::ipet::NETWORK_SOLVER", false);
+
+} }	// otawa::ipet
@@ -125,6 +125,7 @@ int ParExeGraph::analyze() {
 
 	clearDelays();
     initDelays();
+    recordOrder();
     propagate();
 
 //    _capacity = 0;
@@ -133,6 +134,122 @@ int ParExeGraph::analyze() {
 //    }
 //    analyzeContentions();
 
+    return computeCost();
+}
+
+
+/**
+ * Compute again the cost of the graph after some node latencies or edges have
+ * been changed and reported with invalidate(). Only the nodes downstream of
+ * the invalidated nodes are propagated again and the propagation stops as soon
+ * as the delays of a node are left unchanged. If the graph has never been
+ * analyzed or if a new edge breaks the topological order recorded by the last
+ * analyze(), a full analysis is performed.
+ *
+ * Notice that this function relies on the default propagation of delays and
+ * must not be used if propagate() is overridden.
+ *
+ * @return	Cost for the current graph.
+ */
+int ParExeGraph::reanalyze() {
+	if(_order.isEmpty() || _rank.length() != count())
+		return analyze();
+
+	int n = _resources.length();
+	Vector<int> delays(n);
+	delays.setLength(n);
+	for(int i = _first_stale; i < _order.length(); i++) {
+		if(!_stale.bit(i))
+			continue;
+		_stale.clear(i);
+		ParExeNode *node = _order[i];
+
+		// join initial delays and predecessor contributions
+		for(int r = 0; r < n; r++)
+			delays[r] = _init_delays[i * n + r];
+		for(Predecessor pred(node); pred(); pred++) {
+			int p = _rank[pred->index()];
+			if(p < 0 || p >= i)
+				return analyze();
+			int latency = 0;
+			if(pred.edge()->type() == ParExeEdge::SOLID)
+				latency = pred->latency() + pred.edge()->latency();
+			for(int r = 0; r < n; r++)
+				if(pred->delay(r) != -1 && pred->delay(r) + latency > delays[r])
+					delays[r] = pred->delay(r) + latency;
+		}
+
+		// update and wake up successors if needed
+		bool changed = false;
+		for(int r = 0; r < n; r++)
+			if(node->delay(r) != delays[r]) {
+				node->setDelay(r, delays[r]);
+				changed = true;
+			}
+		if(changed)
+			for(Successor succ(node); succ(); succ++) {
+				int s = _rank[succ->index()];
+				if(s < 0)
+					return analyze();
+				_stale.set(s);
+			}
+	}
+	_first_stale = _order.length();
+
+	return computeCost();
+}
+
+
+/**
+ * Record that the latency of the given node or the latency or the set of its
+ * input edges has changed. The node and its successors will be propagated again
+ * at the next call to reanalyze().
+ * @param node	Changed node.
+ */
+void ParExeGraph::invalidate(ParExeNode *node) {
+	if(_order.isEmpty() || node->index() >= _rank.length())
+		return;
+	int i = _rank[node->index()];
+	if(i < 0)
+		return;
+	_stale.set(i);
+	if(i < _first_stale)
+		_first_stale = i;
+	for(Successor succ(node); succ(); succ++) {
+		int s = _rank[succ->index()];
+		if(s >= 0)
+			_stale.set(s);
+	}
+}
+
+
+/**
+ * Record the topological order of the nodes and their initial delays
+ * as produced by initDelays() to support reanalyze().
+ */
+void ParExeGraph::recordOrder(void) {
+	int n = _resources.length();
+	_order.clear();
+	_rank.setLength(count());
+	for(int i = 0; i < _rank.length(); i++)
+		_rank[i] = -1;
+	_init_delays.clear();
+	for(PreorderIterator node(this); node(); node++) {
+		_rank[node->index()] = _order.length();
+		_order.add(*node);
+		for(int r = 0; r < n; r++)
+			_init_delays.add(node->delay(r));
+	}
+	_stale = BitVector(_order.length());
+	_first_stale = _order.length();
+}
+
+
+/**
+ * Compute the cost of the graph from the propagated delays.
+ * @return	Graph cost.
+ */
+int ParExeGraph::computeCost(void) {
     int wcc;
     if (_last_prologue_node)
 		wcc = cost();
@@ -1476,7 +1593,8 @@ ParExeGraph::ParExeGraph(
  	_branch_penalty(2),
  	_sequence(seq),
  	_capacity(0),
-	_explicit(false)
+	_explicit(false),
+	_first_stale(0)
 {
 	if(_ws != nullptr) {
 
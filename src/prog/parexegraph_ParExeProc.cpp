@@ -166,6 +166,15 @@ ParExeStage::ParExeStage(
 { }
 
 
+/**
+ * Destructor (also release the functional units).
+ */
+ParExeStage::~ParExeStage(void) {
+	for(int i = 0; i < _fus.length(); i++)
+		delete _fus[i];
+}
+
+
 /**
  * Add a FU to the stage.
  * @param pipelined		Is the stage pipelined?
@@ -284,6 +293,14 @@ ParExePipeline *ParExeStage::addFunctionalUnit(
  * @see peg
  */
 
+/**
+ * Destructor (also release the stages).
+ */
+ParExePipeline::~ParExePipeline() {
+	for(int i = 0; i < _stages.length(); i++)
+		delete _stages[i];
+}
+
 /**
  * @fn ParExeStage * ParExePipeline::lastStage();
  * @return Pointer to the last stage.
@@ -441,6 +458,15 @@ ParExeProc::ParExeProc(const hard::Processor *proc)
 	}
 } // end of ParExeProc()
 
+
+/**
+ * Destructor (release the queues and the stages).
+ */
+ParExeProc::~ParExeProc(void) {
+	for(int i = 0; i < _queues.length(); i++)
+		delete _queues[i];
+}
+
 /**
  * @fn ParExeProc::ParExeProc(const hard::Processor *proc);
  * Constructor.
@@ -20,8 +20,10 @@
  */
 
 #include "config.h"
-#include <elm/sys/Thread.h>
+#include <elm/data/quicksort.h>
+#include <otawa/cfg/CFG.h>
 #include <otawa/proc/ConcurrentCFGProcessor.h>
+#include <otawa/proc/TaskPool.h>
 #include <otawa/prog/WorkSpace.h>
 
 namespace otawa {
@@ -29,15 +31,22 @@ namespace otawa {
 /**
  * @class ConcurrentCFGProcessor
  * Implements a concurrent version of @ref CFGProcessor.
- * The CFG are processed in each thread and the thread calls
+ * The CFG are processed in parallel, each thread calling
  * the processCFG() method.
  *
  * OTAWA is only responsible for maintaining the property list
  * state consistent: a thread processing a CFG is only allowed
  * to modify properties of its own CFG, blocks and edges.
+ * Properties of other CFGs may be read concurrently (see @ref prop_conc)
+ * but references to them must not be kept from one CFG to another:
+ * each CFG processing ends with a quiescent point.
  * Other shared state data item must be handled by its own
  * way by the user class.
  *
+ * The CFGs are processed as tasks of the workspace @ref TaskPool, the biggest
+ * ones first. processCFG() may itself spawn tasks in the pool, for instance
+ * to process the blocks or the edges of a big CFG concurrently.
+ *
  * Notice that for readability purpose, concurrency is disabled
  * as soon as logging for CFG level is used.
  *
@@ -45,63 +54,44 @@ namespace otawa {
  */
 
 #ifdef OTAWA_CONC
-class CFGRunnable: public sys::Runnable {
+// sort CFG by decreasing size
+class CFGSize {
 public:
-	CFGRunnable(ConcurrentCFGProcessor& p): proc(p) { }
-	virtual void run(void) { proc.nextCFG(); }
-private:
-	ConcurrentCFGProcessor& proc;
+	static int compare(CFG *g1, CFG *g2) { return g2->count() - g1->count(); }
+	int doCompare(CFG *g1, CFG *g2) const { return compare(g1, g2); }
 };
 #endif
 
 /**
  */
-ConcurrentCFGProcessor::ConcurrentCFGProcessor(p::declare& r): CFGProcessor(r), mutex(0) {
+ConcurrentCFGProcessor::ConcurrentCFGProcessor(p::declare& r): CFGProcessor(r) {
 }
 
 /**
+ * The collection and the statistics are handled by CFGProcessor::processWorkSpace():
+ * only the traversal of the CFGs is made concurrent.
  */
-void ConcurrentCFGProcessor::processWorkSpace(WorkSpace *ws) {
+void ConcurrentCFGProcessor::processAll(WorkSpace *ws) {
 #	ifndef OTAWA_CONC
-		CFGProcessor::processWorkSpace(ws);
+		CFGProcessor::processAll(ws);
 #	else
 		if(logFor(LOG_CFG))
-			CFGProcessor::processWorkSpace(ws);
+			CFGProcessor::processAll(ws);
 		else {
-			mutex = sys::Mutex::make();
-			const CFGCollection *coll = INVOLVED_CFGS(ws);
-			it = CFGCollection::Iterator(coll);
-			CFGRunnable run(*this);
-			WorkSpace::runAll(run);
-			delete mutex;
-		}
-#	endif
-}
-
-/**
- * Process the next available CFG.
- */
-void ConcurrentCFGProcessor::nextCFG(void) {
-	WorkSpace *ws = workspace();
-	while(true) {
 
-		// get the next CFG
-		mutex->lock();
-		CFG *cfg = 0;
-		if(it()) {
-			cfg = *it;
-			it++;
-		}
-		mutex->unlock();
+			// biggest CFGs first to avoid a long tail
+			Vector<CFG *> cfgs;
+			for(auto g: this->cfgs())
+				cfgs.add(g);
+			quicksort(cfgs, CFGSize());
 
-		// process it
-		if(!cfg)
-			return;
-		else {
-			//cerr << string(_ << "DEBUG: in " << (void *)sys::Thread::current() << " processing " << cfg << io::endl);
-			processCFG(ws, cfg);
+			// spawn a task per CFG
+			TaskPool& pool = ws->pool();
+			for(auto g: cfgs)
+				pool.spawn([this, ws, g]() { processCFG(ws, g); });
+			pool.wait();
 		}
-	}
+#	endif
 }
 
 }	// otawa
@@ -26,6 +26,7 @@
 #include <otawa/proc/Registry.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/proc/FeatureDependency.h>
+#include <otawa/proc/Profiler.h>
 #include <otawa/proc/Progress.h>
 #include <otawa/stats/StatInfo.h>
 #include <otawa/stats/StatCollector.h>
@@ -473,15 +474,28 @@ void Processor::run(WorkSpace *ws) {
 		swatch.start();
 
 	// Launch the work
-	setup(ws);
+	Profiler *prof = PROFILER(ws);
+	if(prof != nullptr)
+		prof->enter(*this);
 	try {
-		processWorkSpace(ws);
-	}
-	catch(ProcessorException& e) {
+		setup(ws);
+		try {
+			processWorkSpace(ws);
+		}
+		catch(ProcessorException& e) {
+			cleanup(ws);
+			throw;
+		}
 		cleanup(ws);
-		throw e;
 	}
-	cleanup(ws);
+	catch(...) {
+		// any exception must leave the profiler else its stack is corrupted
+		if(prof != nullptr)
+			prof->leave(*this);
+		throw;
+	}
+	if(prof != nullptr)
+		prof->leave(*this);
 
 	// Post-processing actions
 	if(!isQuiet() && logFor(LOG_CFG))
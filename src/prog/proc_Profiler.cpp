@@ -0,0 +1,381 @@
+/*
+ *	Profiler class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <chrono>
+#include <ctime>
+#if defined(__unix__) || defined(__APPLE__)
+#	include <sys/resource.h>
+#endif
+
+#include <elm/data/HashMap.h>
+#include <elm/data/quicksort.h>
+#include <otawa/proc/AbstractFeature.h>
+#include <otawa/proc/Processor.h>
+#include <otawa/proc/Profiler.h>
+
+namespace otawa {
+
+// wall clock time in micro-seconds
+static t::uint64 wallTime(void) {
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time of the process in micro-seconds
+static t::uint64 cpuTime(void) {
+#	if defined(__unix__) || defined(__APPLE__)
+		struct rusage ru;
+		getrusage(RUSAGE_SELF, &ru);
+		return t::uint64(ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000
+			 + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+#	else
+		return t::uint64(std::clock()) * 1000000 / CLOCKS_PER_SEC;
+#	endif
+}
+
+// peak resident set size in KiB (0 if not available)
+static t::int64 peakRSS(void) {
+#	if defined(__unix__) || defined(__APPLE__)
+		struct rusage ru;
+		getrusage(RUSAGE_SELF, &ru);
+#		ifdef __APPLE__
+			return ru.ru_maxrss / 1024;
+#		else
+			return ru.ru_maxrss;
+#		endif
+#	else
+		return 0;
+#	endif
+}
+
+// output a JSON string
+static void printJSON(io::Output& out, const string& s) {
+	out << '"';
+	for(int i = 0; i < s.length(); i++)
+		switch(s[i]) {
+		case '"':	out << "\\\""; break;
+		case '\\':	out << "\\\\"; break;
+		case '\n':	out << "\\n"; break;
+		case '\t':	out << "\\t"; break;
+		default:	out << s[i]; break;
+		}
+	out << '"';
+}
+
+// output a string padded to the given width
+static void printPadded(io::Output& out, const string& s, int width) {
+	out << s;
+	for(int i = s.length(); i < width; i++)
+		out << ' ';
+}
+
+
+/**
+ * @class Profiler
+ * A profiler records, for each processor run on a workspace, the chain of
+ * features that caused it to be run, its wall-clock and CPU time, the growth
+ * of the peak resident memory and the number of properties it has created.
+ *
+ * To activate it, a profiler has to be hooked to the workspace with
+ * @ref PROFILER: then Processor::run() and WorkSpace::require() report
+ * to it. The result may be output as a table summarizing the processors
+ * sorted by self time (printSummary()) or as a trace in the Chrome trace-event
+ * format (printTrace()), that can be displayed with chrome://tracing
+ * or https://ui.perfetto.dev.
+ *
+ * From the command line, any @ref Application supports options
+ * --profile to display the summary and --profile-trace PATH to output the trace.
+ *
+ * As times are measured for the whole process, the figures of processors
+ * running concurrently are not meaningful.
+ *
+ * @ingroup proc
+ */
+
+
+/**
+ * @class Profiler::Record
+ * Profile record of one processor run.
+ */
+
+/**
+ * @var string Profiler::Record::name;
+ * Name of the processor.
+ */
+
+/**
+ * @var string Profiler::Record::chain;
+ * Chain of required features that caused the processor to be run
+ * (outermost first, separated by " > ").
+ */
+
+/**
+ * @var int Profiler::Record::depth;
+ * Nesting depth of the processor run (0 for processors run from the top level).
+ */
+
+/**
+ * @var t::uint64 Profiler::Record::start;
+ * Start date in micro-seconds from the creation of the profiler.
+ */
+
+/**
+ * @var t::uint64 Profiler::Record::wall;
+ * Wall-clock time in micro-seconds including nested processor runs.
+ */
+
+/**
+ * @var t::uint64 Profiler::Record::self;
+ * Wall-clock time in micro-seconds excluding nested processor runs.
+ */
+
+/**
+ * @var t::uint64 Profiler::Record::cpu;
+ * CPU time (user and system) in micro-seconds.
+ */
+
+/**
+ * @var t::int64 Profiler::Record::rss;
+ * Growth of the peak resident set size in KiB.
+ */
+
+/**
+ * @var t::int64 Profiler::Record::props;
+ * Number of properties created during the run.
+ */
+
+/**
+ * @var t::int64 Profiler::Record::live;
+ * Difference between the number of created and released properties during the run.
+ */
+
+
+/**
+ */
+Profiler::Profiler(void): base(wallTime()) {
+	PropList::startCounting();
+}
+
+
+/**
+ */
+Profiler::~Profiler(void) {
+	PropList::stopCounting();
+	for(auto r: recs)
+		delete r;
+}
+
+
+/**
+ * Called when a feature starts to be computed.
+ * @param feature	Required feature.
+ */
+void Profiler::start(const AbstractFeature& feature) {
+	feats.push(&feature);
+}
+
+
+/**
+ * Called when the computation of a feature is finished.
+ * @param feature	Required feature.
+ */
+void Profiler::stop(const AbstractFeature& feature) {
+	while(!feats.isEmpty() && feats.pop() != &feature)
+		continue;
+}
+
+
+/**
+ * Called when a processor starts its work.
+ * @param proc	Started processor.
+ */
+void Profiler::enter(const Processor& proc) {
+	Record *r = new Record();
+	r->name = proc.name();
+	StringBuffer buf;
+	for(int i = 0; i < feats.length(); i++) {
+		if(i != 0)
+			buf << " > ";
+		buf << feats[i]->name();
+	}
+	r->chain = buf.toString();
+	r->depth = stack.length();
+	r->wall = r->self = r->cpu = 0;
+	r->rss = r->props = r->live = 0;
+	recs.add(r);
+
+	frame_t f;
+	f.proc = &proc;
+	f.rec = r;
+	f.child = 0;
+	f.cpu = cpuTime();
+	f.rss = peakRSS();
+	f.added = PropList::countAdded();
+	f.disposed = PropList::countDisposed();
+	r->start = wallTime() - base;
+	stack.push(f);
+}
+
+
+/**
+ * Called when a processor has finished its work.
+ * @param proc	Finished processor.
+ */
+void Profiler::leave(const Processor& proc) {
+	t::uint64 now = wallTime() - base;
+	while(!stack.isEmpty()) {
+		frame_t f = stack.pop();
+		Record *r = f.rec;
+		r->wall = now - r->start;
+		r->self = r->wall - min(f.child, r->wall);
+		r->cpu = cpuTime() - f.cpu;
+		r->rss = peakRSS() - f.rss;
+		r->props = PropList::countAdded() - f.added;
+		r->live = r->props - (PropList::countDisposed() - f.disposed);
+		if(!stack.isEmpty())
+			stack.top().child += r->wall;
+		if(f.proc == &proc)
+			break;
+	}
+}
+
+
+/**
+ * Output the records in the Chrome trace-event format (JSON).
+ * @param out	Stream to output to.
+ */
+void Profiler::printTrace(io::Output& out) const {
+	out << "{\"traceEvents\": [\n";
+	bool first = true;
+	for(auto r: recs) {
+		if(!first)
+			out << ",\n";
+		first = false;
+		out << "{\"name\": ";
+		printJSON(out, r->name);
+		out << ", \"cat\": \"processor\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+			<< ", \"ts\": " << r->start
+			<< ", \"dur\": " << r->wall
+			<< ", \"args\": {\"chain\": ";
+		printJSON(out, r->chain);
+		out << ", \"self_us\": " << r->self
+			<< ", \"cpu_us\": " << r->cpu
+			<< ", \"rss_kb\": " << r->rss
+			<< ", \"props\": " << r->props
+			<< ", \"live_props\": " << r->live
+			<< "}}";
+	}
+	out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+
+// summary of the runs of a processor
+class Total {
+public:
+	Total(const string& n): name(n), count(0), wall(0), self(0), cpu(0), rss(0), props(0), live(0) { }
+	string name, chain;
+	int count;
+	t::uint64 wall, self, cpu;
+	t::int64 rss, props, live;
+};
+
+class TotalOrder {
+public:
+	inline int doCompare(const Total *t1, const Total *t2) const {
+		if(t1->self != t2->self)
+			return t1->self > t2->self ? -1 : +1;
+		else
+			return 0;
+	}
+};
+
+
+/**
+ * Output a table summarizing the processors sorted by decreasing self time.
+ * Times are given in milli-seconds, the memory in KiB.
+ * @param out	Stream to output to.
+ */
+void Profiler::printSummary(io::Output& out) const {
+
+	// aggregate the runs
+	HashMap<string, Total *> map;
+	Vector<Total *> totals;
+	t::uint64 all = 0;
+	for(auto r: recs) {
+		Total *t = map.get(r->name, nullptr);
+		if(t == nullptr) {
+			t = new Total(r->name);
+			t->chain = r->chain;
+			map.put(r->name, t);
+			totals.add(t);
+		}
+		t->count++;
+		t->wall += r->wall;
+		t->self += r->self;
+		t->cpu += r->cpu;
+		t->rss += r->rss;
+		t->props += r->props;
+		t->live += r->live;
+		all += r->self;
+	}
+	quicksort(totals, TotalOrder());
+
+	// output the table
+	int width = 9;
+	for(auto t: totals)
+		width = max(width, t->name.length());
+	printPadded(out, "processor", width);
+	out << "   runs  wall (ms)  self (ms)   self %   cpu (ms)   rss (KiB)      props      live\n";
+	for(auto t: totals) {
+		printPadded(out, t->name, width);
+		out << ' ' << io::fmt(t->count).right().width(6)
+			<< ' ' << io::fmt(t->wall / 1000).right().width(10)
+			<< ' ' << io::fmt(t->self / 1000).right().width(10)
+			<< ' ' << io::fmt(all == 0 ? 0 : t->self * 100 / all).right().width(7) << '%'
+			<< ' ' << io::fmt(t->cpu / 1000).right().width(10)
+			<< ' ' << io::fmt(t->rss).right().width(11)
+			<< ' ' << io::fmt(t->props).right().width(10)
+			<< ' ' << io::fmt(t->live).right().width(9)
+			<< io::endl;
+	}
+	printPadded(out, "total", width);
+	out << ' ' << io::fmt(recs.length()).right().width(6)
+		<< ' ' << io::fmt(all / 1000).right().width(10) << io::endl;
+
+	// output the feature chains of the slowest processors
+	out << io::endl;
+	for(int i = 0; i < totals.length() && i < 10; i++)
+		if(totals[i]->chain)
+			out << totals[i]->name << ": " << totals[i]->chain << io::endl;
+
+	for(auto t: totals)
+		delete t;
+}
+
+
+/**
+ * Profiler hooked to a workspace: when set, the processors run on the
+ * workspace record their profile in it.
+ * @ingroup proc
+ */
+p::id<Profiler *> PROFILER("otawa::PROFILER", nullptr);
+
+}	// otawa
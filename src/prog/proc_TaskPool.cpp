@@ -0,0 +1,382 @@
+/*
+ *	TaskPool class implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "config.h"
+#include <elm/sys/System.h>
+#include <elm/sys/Thread.h>
+#include <otawa/base.h>
+#include <otawa/proc/TaskPool.h>
+#include "rcu.h"
+
+namespace otawa {
+
+/**
+ * Configuration of the number of threads used by the task pool of a workspace
+ * (see @ref WorkSpace::pool()). It is looked up in the workspace property list
+ * when the pool is first used. 0, the default, means one thread per core.
+ * Without concurrency support (OTAWA_CONC), it is ignored and the tasks
+ * are executed by the thread waiting for them.
+ *
+ * @ingroup proc
+ */
+p::id<int> THREAD_COUNT("otawa::THREAD_COUNT", 0);
+
+
+// double-ended queue of tasks of a worker
+class TaskQueue {
+public:
+
+	inline void push(TaskPool::Task *task)
+		{ std::lock_guard<std::mutex> lock(mutex); tasks.push_back(task); }
+
+	inline TaskPool::Task *pop(void) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if(tasks.empty())
+			return nullptr;
+		TaskPool::Task *task = tasks.back();
+		tasks.pop_back();
+		return task;
+	}
+
+	inline TaskPool::Task *steal(void) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if(tasks.empty())
+			return nullptr;
+		TaskPool::Task *task = tasks.front();
+		tasks.pop_front();
+		return task;
+	}
+
+private:
+	std::mutex mutex;
+	std::deque<TaskPool::Task *> tasks;
+};
+
+
+// shared state of the pool
+class TaskState {
+public:
+	TaskState(void): queued(0), stop(false) { }
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::atomic<int> queued;
+	bool stop;
+	string error;
+};
+
+
+// current worker
+static thread_local TaskPool *current_pool = nullptr;
+static thread_local int current_index = -1;
+
+// count of pending tasks spawned by the current task (or thread)
+static thread_local std::atomic<int> thread_scope(0);
+static thread_local std::atomic<int> *current_scope = nullptr;
+
+// depth of nested task executions (quiescent points are only at depth 0)
+static thread_local int current_depth = 0;
+
+
+// worker thread
+class TaskWorker: public sys::Runnable {
+public:
+
+	TaskWorker(TaskPool& pool, int index): _pool(pool), _index(index)
+		{ sys::Thread::make(*this); }
+
+	void run(void) override {
+		current_pool = &_pool;
+		current_index = _index;
+		TaskState& state = *_pool.state;
+		while(true) {
+
+			// the worker only takes part in the reclamation while it executes tasks
+#			ifdef OTAWA_CONC
+				RCURunnable rcu(false);
+				RCURunnable::attach(&rcu);
+#			endif
+			while(_pool.execute(_index))
+				continue;
+#			ifdef OTAWA_CONC
+				RCURunnable::detach(&rcu);
+#			endif
+
+			// sleep until new tasks are queued
+			std::unique_lock<std::mutex> lock(state.mutex);
+			state.cond.wait(lock, [&state]() { return state.stop || state.queued > 0; });
+			if(state.stop && state.queued == 0)
+				break;
+		}
+	}
+
+private:
+	TaskPool& _pool;
+	int _index;
+};
+
+
+/**
+ * @class TaskPool
+ * Pool of threads executing tasks with work-stealing. Each thread of the pool
+ * owns a queue of tasks: the tasks spawned by a task are pushed in the queue
+ * of its thread and are executed in LIFO order by this thread while idle
+ * threads steal the oldest tasks of the other queues. This balances
+ * well workloads made of very skewed tasks, like a big CFG and many small ones.
+ *
+ * A task pool is owned by the workspace (see @ref WorkSpace::pool()) and may
+ * be used by the processors to process CFGs, blocks or edges concurrently:
+ * @code
+ *	ws->pool().forEach(*cfg, [&](Block *v) { processBB(ws, cfg, v); });
+ * @endcode
+ *
+ * A call to wait() waits for the end of the tasks spawned by the current
+ * task (or thread) and the calling thread takes part to the execution of
+ * the tasks in the meantime. A task is only considered as ended when all
+ * the tasks it has spawned are ended. Without
+ * concurrency support (OTAWA_CONC), the pool has no thread and the tasks are
+ * all executed by wait().
+ *
+ * The tasks running in the pool must respect the property access rules
+ * described in @ref prop_conc: no property reference is kept from one task
+ * to another.
+ *
+ * @ingroup proc
+ */
+
+
+/**
+ * @class TaskPool::Task
+ * A task to run in a @ref TaskPool.
+ */
+
+/**
+ */
+TaskPool::Task::~Task(void) {
+}
+
+/**
+ * @fn void TaskPool::Task::run(void);
+ * Called to perform the work of the task.
+ */
+
+
+/**
+ * Build a task pool.
+ * @param count		Number of threads (including the waiting thread),
+ * 					0 for the number of cores.
+ */
+TaskPool::TaskPool(int count): _count(count), state(new TaskState()) {
+#	ifdef OTAWA_CONC
+		if(_count <= 0)
+			_count = sys::System::coreCount();
+#	else
+		_count = 1;
+#	endif
+	for(int i = 0; i < _count; i++)
+		queues.add(new TaskQueue());
+	for(int i = 0; i < _count - 1; i++) {
+		TaskWorker *w = new TaskWorker(*this, i);
+		workers.add(w);
+		w->thread()->start();
+	}
+}
+
+
+/**
+ */
+TaskPool::~TaskPool(void) {
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->stop = true;
+	}
+	state->cond.notify_all();
+	for(auto w: workers) {
+		w->thread()->join();
+		delete w;
+	}
+	for(auto q: queues) {
+		for(Task *t = q->pop(); t; t = q->pop())
+			delete t;
+		delete q;
+	}
+	delete state;
+}
+
+
+/**
+ * @fn int TaskPool::count(void) const;
+ * Get the number of threads executing the tasks (including the thread
+ * calling wait()).
+ * @return	Thread count.
+ */
+
+
+/**
+ * Spawn a new task. If called from a task, the task is put in the queue
+ * of the current thread, else in the queue of the waiting thread.
+ * @param task	Spawned task (deleted by the pool after execution).
+ */
+void TaskPool::spawn(Task *task) {
+	int i = current_pool == this ? current_index : _count - 1;
+	if(!current_scope)
+		current_scope = &thread_scope;
+	task->_scope = current_scope;
+	(*current_scope)++;
+	queues[i]->push(task);
+	state->queued++;
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+	}
+	state->cond.notify_one();
+}
+
+
+/**
+ * @fn void TaskPool::spawn(const F& f);
+ * Spawn a task calling the given function object (usually a lambda).
+ * @param f		Function object to call.
+ */
+
+
+/**
+ * @fn void TaskPool::forEach(const C& coll, const F& f);
+ * Spawn a task calling f for each item of the given collection and wait
+ * for their end. Typical collections are CFGCollection (for a per-CFG
+ * processing), CFG (per-block processing) or Block::edges() (per-edge
+ * processing).
+ * @param coll	Collection to process.
+ * @param f		Function object called for each item.
+ */
+
+
+/**
+ * Wait for the end of the tasks spawned by the current task (or by the current
+ * thread outside of a task). The calling thread executes tasks while
+ * some are pending. If a task has thrown an exception, it is re-thrown
+ * as an otawa::Exception by the outermost wait().
+ * @throw otawa::Exception	If a task failed.
+ */
+void TaskPool::wait(void) {
+	if(!current_scope)
+		return;
+#	ifdef OTAWA_CONC
+		RCURunnable rcu(false);
+		bool attached = !RCURunnable::participant();
+		if(attached)
+			RCURunnable::attach(&rcu);
+#	endif
+	join(current_pool == this ? current_index : _count - 1);
+#	ifdef OTAWA_CONC
+		if(attached)
+			RCURunnable::detach(&rcu);
+#	endif
+
+	// outermost wait: report errors
+	if(current_pool != this && current_scope == &thread_scope) {
+		std::lock_guard<std::mutex> lock(state->mutex);
+		if(!state->error.isEmpty()) {
+			string msg = state->error;
+			state->error = "";
+			throw otawa::Exception(msg);
+		}
+	}
+}
+
+
+/**
+ * Execute tasks until the tasks of the current scope are ended.
+ * @param i		Thread index.
+ */
+void TaskPool::join(int i) {
+	while(*current_scope > 0)
+		if(!execute(i))
+			std::this_thread::yield();
+}
+
+
+/**
+ * Take a task to execute for the given thread: from its own queue first,
+ * then by stealing from the other queues.
+ * @param i		Thread index.
+ * @return		Found task or null.
+ */
+TaskPool::Task *TaskPool::take(int i) {
+	Task *task = queues[i]->pop();
+	for(int j = 1; !task && j < _count; j++)
+		task = queues[(i + j) % _count]->steal();
+	if(task)
+		state->queued--;
+	return task;
+}
+
+
+/**
+ * Execute a task for the given thread.
+ * @param i		Thread index.
+ * @return		True if a task has been executed, false else.
+ */
+bool TaskPool::execute(int i) {
+	Task *task = take(i);
+	if(!task)
+		return false;
+#	ifdef OTAWA_CONC
+		// only the pool workers take part in the reclamation: a thread executing
+		// tasks while waiting for them may still hold pointers taken before
+		bool worker = current_pool == this;
+		if(worker && !current_depth && RCURunnable::participant())
+			RCURunnable::participant()->enter();
+#	endif
+
+	// run the task in its own scope
+	std::atomic<int> *parent = current_scope;
+	std::atomic<int> scope(0);
+	current_scope = &scope;
+	current_depth++;
+	try {
+		task->run();
+	}
+	catch(elm::Exception& e) {
+		std::lock_guard<std::mutex> lock(state->mutex);
+		if(state->error.isEmpty())
+			state->error = e.message();
+	}
+	join(i);
+	current_depth--;
+	current_scope = parent;
+
+	// task end
+	std::atomic<int> *owner = task->_scope;
+	delete task;
+#	ifdef OTAWA_CONC
+		if(worker && !current_depth)
+			RCURunnable::quiesce();
+#	endif
+	(*owner)--;
+	return true;
+}
+
+}	// otawa
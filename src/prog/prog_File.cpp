@@ -42,10 +42,14 @@ namespace otawa {
 
 
 /**
- * @fn void File::addSegment(Segment *seg)
  * Add the given segment to the file.
  * @param seg	Added segment.
  */
+void File::addSegment(Segment *seg) {
+	segs.add(seg);
+	if(_proc != nullptr)
+		_proc->invalidateSegments();
+}
 
 
 /**
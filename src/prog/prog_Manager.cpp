@@ -258,6 +258,7 @@ elm::sys::Path Manager::retrieveConfig(const elm::sys::Path& path) {
  * @li @ref MEMORY_PATH
  * @li @ref PIPELINE_DEPTH,
  * @li @ref PLATFORM,
+ * @li @ref PREDECODE,
  * @li @ref PLATFORM_NAME,
  * @li @ref PROCESSOR,
  * @li @ref PROCESSOR_ELEMENT,
@@ -417,7 +418,10 @@ WorkSpace *Manager::loadBin(
 
 	// Try to load the binary
 	resetVerbosity();
-	return new WorkSpace(loader->load(this, path.asSysString(), used_props));
+	WorkSpace *ws = new WorkSpace(loader->load(this, path.asSysString(), used_props));
+	if(PREDECODE(props))
+		ws->process()->predecode(ws->pool());
+	return ws;
 }
 
 
@@ -677,6 +681,17 @@ p::id<bool> NO_SYSTEM("otawa::NO_SYSTEM", false);
 p::id<bool> NO_STACK("otawa::NO_STACK", false);
 
 
+/**
+ * If set to true, the instructions of the executable segments are decoded
+ * as soon as the binary is loaded (see Process::predecode()) instead
+ * of being decoded on demand. The segments are only decoded in parallel
+ * if the loader declares a reentrant decoder (see Process::isDecodingReentrant()),
+ * which none of the current loaders does: pre-decoding is then sequential.
+ * @ingroup prog
+ */
+p::id<bool> PREDECODE("otawa::PREDECODE", false);
+
+
 /**
  * Path to the XML configuration file used in this computation.
  * @ingroup prog
@@ -19,7 +19,9 @@
  *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <mutex>
 #include <elm/deprecated.h>
+#include <elm/data/quicksort.h>
 #include <elm/stree/SegmentBuilder.h>
 #include <elm/xom.h>
 
@@ -32,6 +34,7 @@
 #include <otawa/prog/FixedTextDecoder.h>
 #include <otawa/proc/Feature.h>
 #include <otawa/prog/File.h>
+#include <otawa/proc/TaskPool.h>
 
 using namespace elm;
 
@@ -208,7 +211,7 @@ void SimState::setReg(hard::Register *r, t::uint32 v) {
  * @param program	The program file creating this process.
  */
 Process::Process(Manager *manager, const PropList& props, File *program)
-: prog(0), man(manager), smap(0) {
+: prog(0), man(manager), smap(0), seg_index(nullptr), seg_stale(true), seg_lookups(0), seg_hits(0) {
 	addProps(props);
 	if(prog)
 		addFile(prog);
@@ -301,16 +304,178 @@ Inst *Process::findInstAt(const string& label) {
 }
 
 
+// order of segments by base address
+class SegmentOrder {
+public:
+	static int compare(const Segment *s1, const Segment *s2) {
+		if(s1->address().page() != s2->address().page())
+			return s1->address().page() < s2->address().page() ? -1 : +1;
+		else if(s1->address().offset() != s2->address().offset())
+			return s1->address().offset() < s2->address().offset() ? -1 : +1;
+		else
+			return 0;
+	}
+	int doCompare(const Segment *s1, const Segment *s2) const { return compare(s1, s2); }
+};
+
+
+// immutable index of the segments of a process sorted by address
+class SegmentIndex {
+public:
+
+	SegmentIndex(const Vector<File *>& files, SegmentIndex *previous): overlap(false), prev(previous) {
+		for(auto f: files)
+			for(auto s: f->segments())
+				if(s->size() != 0)
+					segs.add(s);
+		quicksort(segs, SegmentOrder());
+		for(int i = 1; i < segs.count() && !overlap; i++)
+			overlap = segs[i - 1]->address().page() == segs[i]->address().page()
+				&& segs[i - 1]->topAddress().offset() > segs[i]->address().offset();
+	}
+
+	~SegmentIndex(void) { delete prev; }
+
+	inline bool overlaps(void) const { return overlap; }
+
+	Segment *find(const Vector<File *>& files, const Address& a) const {
+
+		// overlapping segments: first file and segment wins
+		if(overlap) {
+			for(auto f: files)
+				for(auto s: f->segments())
+					if(s->contains(a))
+						return s;
+			return nullptr;
+		}
+
+		// binary search for the last segment starting before a
+		int l = 0, h = segs.count();
+		while(l < h) {
+			int m = (l + h) / 2;
+			const Address& sa = segs[m]->address();
+			if(sa.page() < a.page() || (sa.page() == a.page() && sa.offset() <= a.offset()))
+				l = m + 1;
+			else
+				h = m;
+		}
+		if(l > 0 && segs[l - 1]->address().page() == a.page() && segs[l - 1]->contains(a))
+			return segs[l - 1];
+		else
+			return nullptr;
+	}
+
+private:
+	bool overlap;
+	Vector<Segment *> segs;
+	SegmentIndex *prev;
+};
+
+// serialize the rebuilds of the segment indexes
+static std::mutex seg_index_mutex;
+
+
+/**
+ * Get the segment index, building it if it does not exist or if
+ * the segments of the process have changed (see invalidateSegments()).
+ * A replaced index is retired but kept alive until the process deletion
+ * as it may still be used by concurrent look ups.
+ * @return	Current segment index.
+ */
+const SegmentIndex *Process::segmentIndex(void) const {
+	SegmentIndex *idx = seg_index.load(std::memory_order_acquire);
+	if(idx != nullptr && !seg_stale.load(std::memory_order_acquire))
+		return idx;
+	std::lock_guard<std::mutex> lock(seg_index_mutex);
+	idx = seg_index.load(std::memory_order_acquire);
+	if(idx == nullptr || seg_stale.load(std::memory_order_acquire)) {
+		seg_stale.store(false, std::memory_order_release);
+		idx = new SegmentIndex(_files, idx);
+		seg_index.store(idx, std::memory_order_release);
+	}
+	return idx;
+}
+
+
+/**
+ * Called when a file or a segment is added to the process:
+ * the segment index will be rebuilt at the next look up.
+ */
+void Process::invalidateSegments(void) {
+	seg_stale.store(true, std::memory_order_release);
+}
+
+
 /**
- * Find the segment at the given address.
- * @param addr
+ * Find the segment at the given address. The look up is performed
+ * by binary search on an index of the segments sorted by address
+ * (except if some segments overlap). The index is built at the first
+ * look up and rebuilt when segments are added.
+ * @param addr	Looked address.
+ * @return		Found segment or null.
  */
 Segment *Process::findSegmentAt(Address addr) const {
-	for(auto f: files())
-		for(auto s: f->segments())
-			if(s->contains(addr))
-				return s;
-	return nullptr;
+	seg_lookups.fetch_add(1, std::memory_order_relaxed);
+	Segment *seg = segmentIndex()->find(_files, addr);
+	if(seg != nullptr)
+		seg_hits.fetch_add(1, std::memory_order_relaxed);
+	return seg;
+}
+
+
+/**
+ * @fn t::uint64 Process::segmentLookups(void) const;
+ * Get the number of segment look up performed by findSegmentAt()
+ * and findInstAt().
+ * @return	Segment look up count.
+ */
+
+
+/**
+ * @fn t::uint64 Process::segmentHits(void) const;
+ * Get the number of segment look up, performed by findSegmentAt()
+ * and findInstAt(), that found a segment.
+ * @return	Successful segment look up count.
+ */
+
+
+/**
+ * Pre-decode the instructions of all executable segments of the process
+ * (see Segment::predecode()). If the decoding is reentrant (see
+ * isDecodingReentrant()), the segments are decoded in parallel
+ * using the given task pool. Else they are decoded one after the other
+ * in the current thread.
+ * @param pool	Task pool to use.
+ */
+void Process::predecode(TaskPool& pool) {
+	int size = instSize();
+	if(isDecodingReentrant()) {
+		for(auto f: _files)
+			for(auto s: f->segments())
+				if(s->isExecutable())
+					pool.spawn([s, size, &pool]() { s->predecode(size, &pool); });
+		pool.wait();
+	}
+	else
+		for(auto f: _files)
+			for(auto s: f->segments())
+				s->predecode(size);
+}
+
+
+/**
+ * Test if the instruction decoding of the process, i.e. Segment::decode(),
+ * may be called concurrently by several threads. This enables the parallel
+ * pre-decoding of predecode(). As a default, return false: loaders
+ * with a reentrant decoder have to override it.
+ *
+ * Notice that no loader currently overrides it (the GLISS-based decoders
+ * share their decoding state) so that, for now, pre-decoding is always
+ * sequential.
+ * @return	True if the decoding is reentrant, false else.
+ */
+bool Process::isDecodingReentrant(void) const {
+	return false;
 }
 
 
@@ -386,6 +551,8 @@ void Process::addFile(File *file) {
 	if(!_files)
 		prog = file;
 	_files.add(file);
+	file->_proc = this;
+	invalidateSegments();
 }
 
 
@@ -396,6 +563,7 @@ Process::~Process(void) {
 		delete *file;
 	if(smap)
 		delete smap;
+	delete seg_index.load();
 }
 
 
@@ -405,6 +573,14 @@ Process::~Process(void) {
  * @return		Instruction at the given address or null if it cannot be found.
  */
 Inst *Process::findInstAt(address_t addr) {
+
+	// disjoint segments: only one may contain the instruction
+	if(!segmentIndex()->overlaps()) {
+		Segment *seg = findSegmentAt(addr);
+		return seg == nullptr ? nullptr : seg->findInstAt(addr);
+	}
+
+	// overlapping segments: look each file in turn
 	for(FileIter file(this); file(); file++) {
 		Inst *result = file->findInstAt(addr);
 		if(result != nullptr)
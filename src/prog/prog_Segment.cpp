@@ -22,6 +22,7 @@
 #include <elm/assert.h>
 #include <otawa/program.h>
 #include <otawa/prog/Process.h>
+#include <otawa/proc/TaskPool.h>
 
 // Configuration of the instruction map
 #define MAP_BITS	6
@@ -30,6 +31,9 @@
 #define MAP_INDEX(a) (((a) - address()) >> MAP_BITS)
 #define MAP_BASE(i)	 address_t(address() + ((i) << MAP_BITS))
 
+// number of instructions decoded by a pre-decoding task
+#define PREDECODE_CHUNK	4096
+
 namespace otawa {
 
 /**
@@ -60,7 +64,11 @@ Segment::Segment(
 	_name(name),
 	_address(address),
 	_size(size),
-	map(new ProgItem *[MAP_SIZE(size)])
+	map(new ProgItem *[MAP_SIZE(size)]),
+	_insts(nullptr),
+	_offs(nullptr),
+	_icnt(0),
+	_isize(0)
 {
 	// Removed : segment with 0 size seems to be normal
 	// ASSERTP(size, "zero size segment");
@@ -78,7 +86,16 @@ Segment::~Segment(void) {
 		_items.removeFirst();
 		delete item;
 	}
+	while(!_dropped.isEmpty()) {
+		ProgItem *item = (ProgItem *)_dropped.first();
+		_dropped.removeFirst();
+		delete item;
+	}
 	delete [] map;
+	if(_insts != nullptr)
+		delete [] _insts;
+	if(_offs != nullptr)
+		delete [] _offs;
 }
 
 
@@ -147,16 +164,28 @@ Segment::~Segment(void) {
 
 
 /**
- * Find an instruction by its address.
+ * Find an instruction by its address. If the segment has been pre-decoded
+ * (see predecode()), the instruction is first looked in the instruction table.
+ * Else, or if the address was not reached by the pre-decoding sweep,
+ * the instruction is decoded on demand: the pre-decoded instructions it
+ * overlaps (the sweep went through data or padding) are then dropped.
  * @param addr	Address to find an instruction for.
  * @return		Found instruction or null.
  */
 Inst *Segment::findInstAt(const Address& addr) {
+	if(_insts != nullptr) {
+		Inst *inst = lookup(addr);
+		if(inst != nullptr)
+			return inst;
+	}
 	ProgItem *item = findItemAt(addr);
 	if(!item) {
 		Inst *inst = decode(addr);
-		if(inst)
+		if(inst) {
+			if(_insts != nullptr)
+				dropConflicts(inst);
 			insert(inst);
+		}
 		return inst;
 	}
 	else
@@ -254,5 +283,248 @@ void Segment::insert(ProgItem *item) {
 }
 
 
+/**
+ * @fn bool Segment::isPredecoded(void) const;
+ * Test if the instructions of the segment have been pre-decoded
+ * (see predecode()).
+ * @return	True if the segment is pre-decoded, false else.
+ */
+
+
+/**
+ * Decode the instructions of the segment with a linear sweep from its start
+ * and record them in a table: findInstAt() becomes an array access
+ * for fixed-size instruction sets or a binary search in an offset table for
+ * variable-size instruction sets. The instructions that cannot be decoded
+ * are skipped and will be decoded on demand if they are needed.
+ *
+ * With fixed-size instructions, the segment is cut in chunks decoded
+ * in parallel on the given task pool: then decode() must be reentrant.
+ * With variable-size instructions, the sweep is sequential as the instruction
+ * boundaries are only known by decoding.
+ *
+ * Nothing is done for non-executable segments and segments already pre-decoded.
+ *
+ * @param inst_size		Size of instructions (0 for a variable-size instruction set).
+ * @param pool			Task pool to use (null to decode in the current thread).
+ */
+void Segment::predecode(int inst_size, TaskPool *pool) {
+	if(_insts != nullptr || !isExecutable() || _size == 0)
+		return;
+
+	// fixed-size: decode chunks in parallel in a dense table
+	if(inst_size > 0) {
+		int n = _size / inst_size;
+		Inst **insts = new Inst *[n];
+		auto sweep = [this, insts, inst_size, n](int b) {
+			int e = min(b + PREDECODE_CHUNK, n);
+			for(int i = b; i < e; i++)
+				insts[i] = decodeSafe(_address + t::uint32(i * inst_size));
+		};
+		for(int b = 0; b < n; b += PREDECODE_CHUNK)
+			if(pool != nullptr)
+				pool->spawn([sweep, b]() { sweep(b); });
+			else
+				sweep(b);
+		if(pool != nullptr)
+			pool->wait();
+		for(int i = 0; i < n; i++)
+			insts[i] = link(insts[i]);
+		_insts = insts;
+		_icnt = n;
+		_isize = inst_size;
+	}
+
+	// variable-size: sequential sweep recorded in an offset table
+	else {
+		Vector<t::uint32> offs;
+		Vector<Inst *> insts;
+		for(address_t a = address(); a < topAddress();) {
+			Inst *inst = decodeSafe(a);
+			if(inst == nullptr || inst->size() == 0) {
+				if(inst != nullptr)
+					delete static_cast<ProgItem *>(inst);
+				a = a + 1;
+				continue;
+			}
+			a = inst->topAddress();
+			inst = link(inst);
+			if(inst != nullptr) {
+				offs.add(inst->address() - address());
+				insts.add(inst);
+			}
+		}
+		_icnt = insts.count();
+		_offs = new t::uint32[_icnt];
+		_insts = new Inst *[_icnt];
+		for(int i = 0; i < _icnt; i++) {
+			_offs[i] = offs[i];
+			_insts[i] = insts[i];
+		}
+	}
+}
+
+
+/**
+ * Decode an instruction for pre-decoding, decoding errors being ignored.
+ * @param address	Instruction address.
+ * @return			Decoded instruction or null.
+ */
+Inst *Segment::decodeSafe(address_t address) {
+	try {
+		return decode(address);
+	}
+	catch(elm::Exception& e) {
+		return nullptr;
+	}
+}
+
+
+/**
+ * Link a pre-decoded instruction in the list of items. If an instruction
+ * already exists at this address, the pre-decoded one is dropped.
+ * If the instruction overlaps an existing item, it is also dropped.
+ * @param inst	Instruction to link (may be null).
+ * @return		Instruction to record in the table or null.
+ */
+Inst *Segment::link(Inst *inst) {
+	if(inst == nullptr)
+		return nullptr;
+	ProgItem *item = findItemAt(inst->address());
+	if(item != nullptr) {
+		delete static_cast<ProgItem *>(inst);
+		return item->toInst();
+	}
+	ProgItem *prev = itemBefore(itemAfter(inst->address()));
+	if(prev != nullptr && prev->topAddress() > inst->address()) {
+		delete static_cast<ProgItem *>(inst);
+		return nullptr;
+	}
+	try {
+		insert(inst);
+		return inst;
+	}
+	catch(DecodingException& e) {
+		delete static_cast<ProgItem *>(inst);
+		return nullptr;
+	}
+}
+
+
+/**
+ * Look for an instruction in the pre-decoded table.
+ * @param addr	Instruction address.
+ * @return		Found instruction or null.
+ */
+Inst *Segment::lookup(const Address& addr) const {
+	int i = lookupIndex(addr);
+	return i < 0 ? nullptr : _insts[i];
+}
+
+
+/**
+ * Look for the entry of an address in the pre-decoded table.
+ * @param addr	Instruction address.
+ * @return		Entry index or -1.
+ */
+int Segment::lookupIndex(const Address& addr) const {
+	if(address().page() != addr.page()
+	|| addr < address()
+	|| addr >= topAddress())
+		return -1;
+	t::uint32 off = addr - address();
+
+	// fixed-size instructions
+	if(_offs == nullptr) {
+		if(off % _isize != 0)
+			return -1;
+		int i = off / _isize;
+		return i < _icnt ? i : -1;
+	}
+
+	// variable-size instructions
+	int l = 0, h = _icnt;
+	while(l < h) {
+		int m = (l + h) / 2;
+		if(_offs[m] < off)
+			l = m + 1;
+		else
+			h = m;
+	}
+	return l < _icnt && _offs[l] == off ? l : -1;
+}
+
+
+/**
+ * Find the first item at or after the given address.
+ * @param addr	Looked address.
+ * @return		Found item or null.
+ */
+ProgItem *Segment::itemAfter(const Address& addr) {
+	int index = MAP_INDEX(addr);
+	while(index > 0 && !map[index])
+		index--;
+	ProgItem *cur = map[index];
+	if(cur == nullptr && !_items.isEmpty())
+		cur = (ProgItem *)_items.first();
+	while(cur != nullptr && cur->address() < addr)
+		cur = cur->next();
+	return cur;
+}
+
+
+/**
+ * Find the item before the given one.
+ * @param next	Item (null for the end of the list).
+ * @return		Previous item or null.
+ */
+ProgItem *Segment::itemBefore(ProgItem *next) {
+	if(next != nullptr)
+		return next->previous();
+	else if(_items.isEmpty())
+		return nullptr;
+	else
+		return (ProgItem *)_items.last();
+}
+
+
+/**
+ * Drop the pre-decoded instructions overlapping the given instruction
+ * decoded on demand. Only the instructions of the pre-decoding sweep
+ * are dropped: they are removed from the table and from the item list
+ * but kept alive until the segment is deleted.
+ * @param inst	Instruction to insert.
+ */
+void Segment::dropConflicts(Inst *inst) {
+	ProgItem *cur = itemAfter(inst->address());
+	ProgItem *prev = itemBefore(cur);
+	if(prev != nullptr && prev->topAddress() > inst->address())
+		unlink(prev);
+	while(cur != nullptr && cur->address() < inst->topAddress()) {
+		ProgItem *next = cur->next();
+		unlink(cur);
+		cur = next;
+	}
+}
+
+
+/**
+ * Remove a pre-decoded instruction from the item list and from the table.
+ * Items that do not come from the pre-decoding are left untouched.
+ * @param item	Item to remove.
+ */
+void Segment::unlink(ProgItem *item) {
+	int i = lookupIndex(item->address());
+	if(i < 0 || _insts[i] != item)
+		return;
+	_insts[i] = nullptr;
+	int index = MAP_INDEX(item->address());
+	if(map[index] == item) {
+		ProgItem *next = item->next();
+		map[index] = next != nullptr && MAP_INDEX(next->address()) == index ? next : nullptr;
+	}
+	item->remove();
+	_dropped.addLast(item);
+}
 
 }; // namespace otawa
@@ -0,0 +1,985 @@
+/*
+ *	SnapshotSaver and SnapshotLoader classes implementation
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/checksum/Fletcher.h>
+#include <elm/data/HashMap.h>
+#include <elm/io/InFileStream.h>
+#include <elm/io/OutFileStream.h>
+
+#include <otawa/cfg/features.h>
+#include <otawa/hard/features.h>
+#include <otawa/hard/Signature.h>
+#include <otawa/proc/ProcessorPlugin.h>
+#include <otawa/prog/File.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/Snapshot.h>
+#include <otawa/prog/TextDecoder.h>
+#include <otawa/prog/WorkSpace.h>
+
+namespace otawa {
+
+/**
+ * @defgroup snapshot	Work Space Snapshots
+ *
+ * Building the CFGs, their loops and the first analyses on top of them is
+ * often the most expensive part of a WCET computation and is exactly the same
+ * when a binary is analyzed again with a different hardware description.
+ * A snapshot records this work in a binary file that can be reloaded instead
+ * of being recomputed:
+ * @li @ref SnapshotSaver writes the current CFG collection, the loop
+ * information and the selected properties,
+ * @li @ref SnapshotLoader rebuilds them and provides
+ * @ref COLLECTED_CFG_FEATURE, the loop features and the features
+ * recorded in the snapshot. The features transforming the CFGs
+ * (like @ref REDUCED_LOOPS_FEATURE or @ref VIRTUALIZED_CFG_FEATURE)
+ * are recorded automatically when they are provided.
+ *
+ * A snapshot is keyed by the Fletcher checksum and the size of the program
+ * file: it can only be restored on the very same binary. As soon as it records
+ * analysis results (properties or features given by the user), these results
+ * may depend on the hardware: if hardware descriptions (processor, memory or
+ * caches) were loaded when the snapshot was saved, their signature
+ * (see hard::signature()) is added to the key and the snapshot is only
+ * restored when the same descriptions are loaded.
+ *
+ * The file is made of fixed-size little-endian 32-bit records addressed
+ * by offsets stored in the header. It is read in memory as a whole and the
+ * records are then accessed in place, without parsing. Its layout is:
+ * @li header -- magic "OTAWASNP", version, flags, program checksum and size,
+ * hardware signature, then the count and offset of each section,
+ * @li CFGs -- address, first block number, block count,
+ * @li blocks -- kind and flags, address, size (basic block) or callee CFG
+ * (synthetic block), enclosing loop header,
+ * @li edges -- source, sink, edge flags, back-edge flag, entered loop header,
+ * exited loop header,
+ * @li features -- names of the recorded features,
+ * @li identifiers -- names of the recorded property identifiers,
+ * @li properties -- owner kind, owner number, identifier, value,
+ * @li strings -- null-terminated strings referenced by offset.
+ *
+ * Blocks and edges are referenced by their number in the whole collection
+ * (as given by Block::id()). Properties are recorded as text: identifiers of
+ * base type (integers, times, addresses, strings, etc) are printed and restored
+ * with AbstractIdentifier::fromString(). Other identifiers can be recorded only
+ * if a @ref SnapshotSerializer has been declared for them (as the icat3 plugin
+ * does for the cache ACS). Identifiers whose values are handles on objects that
+ * do not survive the analysis (like ipet::VAR, a variable of the ILP system)
+ * cannot be recorded and are reported and ignored.
+ */
+
+namespace {
+
+const t::uint8 MAGIC[8] = { 'O', 'T', 'A', 'W', 'A', 'S', 'N', 'P' };
+const t::uint32 VERSION = 2;
+const t::uint32 NONE = 0xffffffff;
+
+// header words
+typedef enum {
+	H_VERSION = 2,
+	H_FLAGS,
+	H_SUM,
+	H_SIZE,
+	H_HARD,
+	H_CFG_CNT,
+	H_CFG_OFF,
+	H_BLOCK_CNT,
+	H_BLOCK_OFF,
+	H_EDGE_CNT,
+	H_EDGE_OFF,
+	H_FEAT_CNT,
+	H_FEAT_OFF,
+	H_ID_CNT,
+	H_ID_OFF,
+	H_PROP_CNT,
+	H_PROP_OFF,
+	H_STR_SIZE,
+	H_STR_OFF,
+	H_TOP
+} header_t;
+
+// record sizes (in words)
+const int
+	CFG_SIZE = 3,
+	BLOCK_SIZE = 4,
+	EDGE_SIZE = 6,
+	FEAT_SIZE = 1,
+	ID_SIZE = 1,
+	PROP_SIZE = 4;
+
+// header flags
+const t::uint32
+	HAS_LOOP_HEADERS = 0x1,
+	HAS_LOOP_INFO = 0x2,
+	HARD_PROC = 0x4,
+	HARD_MEM = 0x8,
+	HARD_CACHE = 0x10,
+	HARD_MASK = HARD_PROC | HARD_MEM | HARD_CACHE;
+
+// block kinds and flags
+typedef enum {
+	ENTRY = 0,
+	EXIT,
+	UNKNOWN,
+	PHONY,
+	BASIC,
+	SYNTH
+} kind_t;
+const t::uint32 BLOCK_LOOP_HEADER = 0x1;
+const t::uint32 EDGE_BACK = 0x1;
+
+// property owners
+typedef enum {
+	OWNER_WS = 0,
+	OWNER_CFG,
+	OWNER_BLOCK,
+	OWNER_EDGE
+} owner_t;
+
+
+/*
+ * Compute the checksum and the size of the program file.
+ */
+bool sumProgram(WorkSpace *ws, t::uint32& sum, t::uint32& size) {
+	io::InFileStream in(ws->process()->program()->name());
+	if(!in.isReady())
+		return false;
+	checksum::Fletcher summer;
+	char buf[4096];
+	size = 0;
+	while(true) {
+		int r = in.read(buf, sizeof(buf));
+		if(r < 0)
+			return false;
+		if(r == 0)
+			break;
+		summer.put(buf, r);
+		size += r;
+	}
+	sum = summer.sum();
+	return true;
+}
+
+
+/*
+ * Get the hardware descriptions provided by the workspace.
+ */
+t::uint32 hardFlags(WorkSpace *ws) {
+	t::uint32 flags = 0;
+	if(ws->isProvided(hard::PROCESSOR_FEATURE))
+		flags |= HARD_PROC;
+	if(ws->isProvided(hard::MEMORY_FEATURE))
+		flags |= HARD_MEM;
+	if(ws->isProvided(hard::CACHE_CONFIGURATION_FEATURE))
+		flags |= HARD_CACHE;
+	return flags;
+}
+
+
+/*
+ * Get the serializers of the identifiers.
+ */
+HashMap<const AbstractIdentifier *, const SnapshotSerializer *>& serializers() {
+	static HashMap<const AbstractIdentifier *, const SnapshotSerializer *> map;
+	return map;
+}
+
+
+/*
+ * Read the whole snapshot file.
+ */
+bool readImage(const sys::Path& path, Vector<t::uint8>& buf) {
+	buf.setLength(0);
+	io::InFileStream in(path.toString().toCString());
+	if(!in.isReady())
+		return false;
+	char chunk[4096];
+	while(true) {
+		int r = in.read(chunk, sizeof(chunk));
+		if(r < 0)
+			return false;
+		if(r == 0)
+			return true;
+		for(int i = 0; i < r; i++)
+			buf.add(chunk[i]);
+	}
+}
+
+
+/*
+ * Read access to a snapshot image.
+ */
+class Image {
+public:
+	Image(const Vector<t::uint8>& buf): b(buf) { }
+
+	inline t::uint32 word(t::uint32 off) const {
+		return t::uint32(b[off])
+			 | (t::uint32(b[off + 1]) << 8)
+			 | (t::uint32(b[off + 2]) << 16)
+			 | (t::uint32(b[off + 3]) << 24);
+	}
+	inline t::uint32 header(int i) const { return word(i * 4); }
+	inline t::uint32 count(header_t h) const { return header(h); }
+	inline t::uint32 field(header_t off, int size, t::uint32 i, int f) const
+		{ return word(header(off) + (i * size + f) * 4); }
+	inline cstring str(t::uint32 off) const
+		{ return reinterpret_cast<const char *>(&b[header(H_STR_OFF) + off]); }
+
+	bool isValid() const {
+		t::uint32 len = b.length();
+		if(len < H_TOP * 4)
+			return false;
+		for(int i = 0; i < 8; i++)
+			if(b[i] != MAGIC[i])
+				return false;
+		if(header(H_VERSION) != VERSION)
+			return false;
+		if(!fits(H_CFG_CNT, H_CFG_OFF, CFG_SIZE)
+		|| !fits(H_BLOCK_CNT, H_BLOCK_OFF, BLOCK_SIZE)
+		|| !fits(H_EDGE_CNT, H_EDGE_OFF, EDGE_SIZE)
+		|| !fits(H_FEAT_CNT, H_FEAT_OFF, FEAT_SIZE)
+		|| !fits(H_ID_CNT, H_ID_OFF, ID_SIZE)
+		|| !fits(H_PROP_CNT, H_PROP_OFF, PROP_SIZE))
+			return false;
+		t::uint64 off = header(H_STR_OFF), size = header(H_STR_SIZE);
+		return size != 0 && off + size <= len && b[off + size - 1] == 0;
+	}
+
+	inline bool isString(t::uint32 off) const { return off < header(H_STR_SIZE); }
+
+	bool matches(WorkSpace *ws) const {
+		t::uint32 sum, size;
+		if(!sumProgram(ws, sum, size))
+			return false;
+		if(sum != header(H_SUM) || size != header(H_SIZE))
+			return false;
+		t::uint32 hflags = header(H_FLAGS) & HARD_MASK;
+		return hflags == 0 || (hardFlags(ws) == hflags && hard::signature(ws) == header(H_HARD));
+	}
+
+private:
+	bool fits(header_t cnt, header_t off, int size) const {
+		t::uint64 top = t::uint64(header(off)) + t::uint64(header(cnt)) * size * 4;
+		return header(off) % 4 == 0 && top <= t::uint64(b.length());
+	}
+
+	const Vector<t::uint8>& b;
+};
+
+
+/*
+ * Build a snapshot image.
+ */
+class Writer {
+public:
+	Writer() {
+		for(int i = 0; i < H_TOP; i++)
+			put(0);
+		for(int i = 0; i < 8; i++)
+			b[i] = MAGIC[i];
+		set(H_VERSION, VERSION);
+		str("");
+	}
+
+	inline t::uint32 offset() const { return b.length(); }
+
+	inline void put(t::uint32 w) {
+		for(int i = 0; i < 4; i++) {
+			b.add(w & 0xff);
+			w >>= 8;
+		}
+	}
+
+	inline void set(header_t h, t::uint32 w) {
+		for(int i = 0; i < 4; i++) {
+			b[h * 4 + i] = w & 0xff;
+			w >>= 8;
+		}
+	}
+
+	inline void begin(header_t cnt, header_t off, t::uint32 count)
+		{ set(cnt, count); set(off, offset()); }
+
+	t::uint32 str(const string& s) {
+		t::uint32 r = smap.get(s, NONE);
+		if(r == NONE) {
+			r = strs.length();
+			for(int i = 0; i < s.length(); i++)
+				strs.add(s[i]);
+			strs.add(0);
+			smap.put(s, r);
+		}
+		return r;
+	}
+
+	const Vector<t::uint8>& close() {
+		set(H_STR_SIZE, strs.length());
+		set(H_STR_OFF, offset());
+		for(int i = 0; i < strs.length(); i++)
+			b.add(strs[i]);
+		return b;
+	}
+
+private:
+	Vector<t::uint8> b, strs;
+	HashMap<string, t::uint32> smap;
+};
+
+inline t::uint32 blockRef(Block *v) { return v == nullptr ? NONE : t::uint32(v->id()); }
+
+}	// anonymous namespace
+
+
+/**
+ * @class SnapshotSerializer
+ * A snapshot serializer allows recording in a snapshot the properties of an
+ * identifier that is not of base type. The serializer is declared for its
+ * identifier at construction time (typically as a static object of the plugin
+ * defining the identifier) and withdrawn at destruction.
+ *
+ * The value is saved as text that has to be read back by load().
+ *
+ * @ingroup snapshot
+ */
+
+/**
+ * Build and declare a serializer.
+ * @param id	Identifier the serializer applies to.
+ */
+SnapshotSerializer::SnapshotSerializer(const AbstractIdentifier& id): _id(id) {
+	serializers().put(&id, this);
+}
+
+/**
+ */
+SnapshotSerializer::~SnapshotSerializer() {
+	serializers().remove(&_id);
+}
+
+/**
+ * @fn const AbstractIdentifier& SnapshotSerializer::identifier() const;
+ * Get the identifier of the serializer.
+ * @return	Serialized identifier.
+ */
+
+/**
+ * @fn void SnapshotSerializer::save(io::Output& out, const Property *prop) const;
+ * Save the value of a property.
+ * @param out	Output to write to.
+ * @param prop	Saved property.
+ */
+
+/**
+ * @fn bool SnapshotSerializer::load(cstring text, PropList& props) const;
+ * Read a value saved by save() and add it as a property to the given list.
+ * @param text		Saved text.
+ * @param props		Property list to add the property to.
+ * @return			False if the text is badly formatted, true else.
+ */
+
+/**
+ * Find the serializer of an identifier.
+ * @param id	Looked identifier.
+ * @return		Found serializer or null.
+ */
+const SnapshotSerializer *SnapshotSerializer::find(const AbstractIdentifier *id) {
+	return serializers().get(id, nullptr);
+}
+
+
+/**
+ * @class SnapshotSaver
+ * Save the current CFG collection, the loop information (if any) and
+ * the selected properties to a snapshot file (see @ref snapshot).
+ *
+ * @par Configuration
+ * @li @ref SNAPSHOT_PATH -- path of the snapshot file (required),
+ * @li @ref SNAPSHOT_INCLUDE -- name of an identifier to record (several allowed),
+ * @li @ref SNAPSHOT_PROVIDE -- name of a feature to record (several allowed).
+ *
+ * @par Required features
+ * @li @ref COLLECTED_CFG_FEATURE
+ *
+ * @ingroup snapshot
+ */
+
+p::declare SnapshotSaver::reg = p::init("otawa::SnapshotSaver", Version(1, 0, 0))
+	.maker<SnapshotSaver>()
+	.require(COLLECTED_CFG_FEATURE);
+
+
+/**
+ */
+SnapshotSaver::SnapshotSaver(p::declare& r): Processor(r) {
+}
+
+
+/**
+ */
+void SnapshotSaver::configure(const PropList& props) {
+	Processor::configure(props);
+	path = SNAPSHOT_PATH(props);
+	for(auto name: SNAPSHOT_INCLUDE.all(props)) {
+		AbstractIdentifier *id = ProcessorPlugin::getIdentifier(name);
+		if(id == nullptr)
+			warn(_ << "cannot find identifier " << name << ": ignored.");
+		else if(id->type().kind() != Type::BASE && SnapshotSerializer::find(id) == nullptr)
+			warn(_ << "identifier " << name << " has not a base type and no serializer: it cannot be recorded in a snapshot.");
+		else if(!ids.contains(id))
+			ids.add(id);
+	}
+	for(auto name: SNAPSHOT_PROVIDE.all(props)) {
+		AbstractFeature *f = ProcessorPlugin::getFeature(name);
+		if(f == nullptr)
+			warn(_ << "cannot find feature " << name << ": ignored.");
+		else if(!feats.contains(f))
+			feats.add(f);
+	}
+}
+
+
+/**
+ */
+void SnapshotSaver::processWorkSpace(WorkSpace *ws) {
+	if(!path)
+		throw ProcessorException(*this, "no snapshot path given (otawa::SNAPSHOT_PATH).");
+	const CFGCollection *coll = INVOLVED_CFGS(ws);
+	Writer w;
+
+	// record the program checksum
+	t::uint32 sum, size;
+	if(!sumProgram(ws, sum, size))
+		throw ProcessorException(*this, _ << "cannot read program " << ws->process()->program()->name());
+	w.set(H_SUM, sum);
+	w.set(H_SIZE, size);
+	t::uint32 flags = 0;
+	if(ws->isProvided(LOOP_HEADERS_FEATURE))
+		flags |= HAS_LOOP_HEADERS;
+	if(ws->isProvided(LOOP_INFO_FEATURE))
+		flags |= HAS_LOOP_INFO;
+	if(!ids.isEmpty() || !feats.isEmpty()) {
+		flags |= hardFlags(ws);
+		if(flags & HARD_MASK)
+			w.set(H_HARD, hard::signature(ws));
+	}
+	w.set(H_FLAGS, flags);
+
+	// properties are collected during the traversal
+	Vector<t::uint32> props;
+	auto record = [&](const PropList& list, owner_t kind, t::uint32 owner) {
+		for(PropList::Iter prop(list); prop(); prop++) {
+			int i = ids.indexOf(prop->id());
+			if(i < 0)
+				continue;
+			StringBuffer buf;
+			const SnapshotSerializer *ser = SnapshotSerializer::find(prop->id());
+			if(ser != nullptr)
+				ser->save(buf, *prop);
+			else
+				prop->id()->print(buf, *prop);
+			props.add(kind);
+			props.add(owner);
+			props.add(i);
+			props.add(w.str(buf.toString()));
+		}
+	};
+	record(*ws, OWNER_WS, 0);
+
+	// record CFGs
+	w.begin(H_CFG_CNT, H_CFG_OFF, coll->count());
+	for(auto g: *coll) {
+		w.put(g->first() == nullptr ? 0 : g->address().offset());
+		w.put(g->offset());
+		w.put(g->count());
+		record(*g, OWNER_CFG, g->index());
+	}
+
+	// record blocks
+	w.begin(H_BLOCK_CNT, H_BLOCK_OFF, coll->countBlocks());
+	int edge_cnt = 0;
+	for(auto g: *coll)
+		for(auto v: *g) {
+			t::uint32 kind, bflags = 0, addr = 0, info = 0;
+			if(v->isEntry())
+				kind = ENTRY;
+			else if(v->isExit())
+				kind = EXIT;
+			else if(v->isUnknown())
+				kind = UNKNOWN;
+			else if(v->isPhony())
+				kind = PHONY;
+			else if(v->isBasic()) {
+				kind = BASIC;
+				addr = v->toBasic()->address().offset();
+				info = v->toBasic()->size();
+			}
+			else {
+				kind = SYNTH;
+				CFG *callee = v->toSynth()->callee();
+				info = callee == nullptr ? NONE : t::uint32(callee->index());
+			}
+			if((flags & HAS_LOOP_HEADERS) && LOOP_HEADER(v))
+				bflags |= BLOCK_LOOP_HEADER;
+			w.put(kind | (bflags << 8));
+			w.put(addr);
+			w.put(info);
+			w.put((flags & HAS_LOOP_INFO) ? blockRef(ENCLOSING_LOOP_HEADER(v)) : NONE);
+			record(*v, OWNER_BLOCK, v->id());
+			edge_cnt += v->countOuts();
+		}
+
+	// record edges
+	w.begin(H_EDGE_CNT, H_EDGE_OFF, edge_cnt);
+	t::uint32 e_num = 0;
+	for(auto g: *coll)
+		for(auto v: *g)
+			for(auto e: v->outEdges()) {
+				w.put(e->source()->id());
+				w.put(e->sink()->id());
+				w.put(e->flags());
+				w.put((flags & HAS_LOOP_HEADERS) && BACK_EDGE(e) ? EDGE_BACK : 0);
+				w.put((flags & HAS_LOOP_INFO) ? blockRef(LOOP_ENTRY(e)) : NONE);
+				w.put((flags & HAS_LOOP_INFO) ? blockRef(LOOP_EXIT(e)) : NONE);
+				record(*e, OWNER_EDGE, e_num++);
+			}
+
+	// record features (the CFG transformations are kept by the snapshot)
+	Vector<const AbstractFeature *> provided;
+	const AbstractFeature *cfg_feats[] = {
+		&REDUCED_LOOPS_FEATURE,
+		&UNROLLED_LOOPS_FEATURE,
+		&VIRTUALIZED_CFG_FEATURE,
+		&DELAYED_CFG_FEATURE,
+		&CONDITIONAL_RESTRUCTURED_FEATURE,
+		&SPLIT_CFG,
+		&NORMALIZED_CFGS_FEATURE
+	};
+	for(auto f: cfg_feats)
+		if(ws->isProvided(*f) && !feats.contains(f))
+			provided.add(f);
+	for(auto f: feats)
+		if(ws->isProvided(*f))
+			provided.add(f);
+		else
+			warn(_ << "feature " << f->name() << " is not provided: not recorded in the snapshot.");
+	w.begin(H_FEAT_CNT, H_FEAT_OFF, provided.length());
+	for(auto f: provided)
+		w.put(w.str(f->name()));
+
+	// record identifiers
+	w.begin(H_ID_CNT, H_ID_OFF, ids.length());
+	for(auto id: ids)
+		w.put(w.str(id->name()));
+
+	// record properties
+	w.begin(H_PROP_CNT, H_PROP_OFF, props.length() / PROP_SIZE);
+	for(auto p: props)
+		w.put(p);
+
+	// write the file
+	const Vector<t::uint8>& buf = w.close();
+	io::OutFileStream out(path.toString().toCString());
+	if(!out.isReady())
+		throw ProcessorException(*this, _ << "cannot open \"" << path << "\": " << out.lastErrorMessage());
+	if(out.write(reinterpret_cast<const char *>(&buf[0]), buf.length()) < 0)
+		throw ProcessorException(*this, _ << "cannot write \"" << path << "\": " << out.lastErrorMessage());
+	if(logFor(LOG_PROC))
+		log << "\tsnapshot saved to " << path << " (" << buf.length() << " bytes, "
+			<< coll->count() << " CFGs, " << props.length() / PROP_SIZE << " properties)\n";
+}
+
+
+/**
+ * @class SnapshotLoader
+ * Rebuild the CFG collection, the loop information and the properties
+ * recorded in a snapshot file (see @ref snapshot). The snapshot must have
+ * been produced from the same program file and, if it is keyed by the hardware,
+ * with the same hardware descriptions: they are required by the loader.
+ *
+ * In addition to the features below, this processor provides
+ * @ref LOOP_HEADERS_FEATURE and @ref LOOP_INFO_FEATURE if they were recorded,
+ * and the features recorded with @ref SNAPSHOT_PROVIDE.
+ *
+ * @par Configuration
+ * @li @ref SNAPSHOT_PATH -- path of the snapshot file (required).
+ *
+ * @par Required features
+ * @li @ref DECODED_TEXT
+ *
+ * @par Provided features
+ * @li @ref COLLECTED_CFG_FEATURE
+ * @li @ref SNAPSHOT_RESTORED_FEATURE
+ *
+ * @ingroup snapshot
+ */
+
+p::declare SnapshotLoader::reg = p::init("otawa::SnapshotLoader", Version(1, 0, 0))
+	.maker<SnapshotLoader>()
+	.require(DECODED_TEXT)
+	.provide(COLLECTED_CFG_FEATURE)
+	.provide(SNAPSHOT_RESTORED_FEATURE);
+
+
+/**
+ */
+SnapshotLoader::SnapshotLoader(p::declare& r): Processor(r), coll(nullptr) {
+}
+
+
+/**
+ * Test if the snapshot file at the given path exists, is valid and
+ * matches the program of the given workspace.
+ *
+ * If the snapshot is keyed by the hardware, the hardware descriptions it
+ * records are required on the workspace with the given configuration before
+ * being compared: therefore this function must only be called once the
+ * configuration of the platform is known (for a script, after its
+ * platform has been scanned, see script::Script).
+ *
+ * @param ws	Current workspace.
+ * @param path	Path of the snapshot file.
+ * @param entry	If not null, entry address of the task the snapshot must have been recorded for.
+ * @param props	Configuration used to load the hardware descriptions.
+ * @return		True if the snapshot can be loaded, false else.
+ */
+bool SnapshotLoader::matches(WorkSpace *ws, const sys::Path& path, Address entry, const PropList& props) {
+	if(!path.exists())
+		return false;
+	Vector<t::uint8> buf;
+	if(!readImage(path, buf))
+		return false;
+	Image img(buf);
+	if(!img.isValid())
+		return false;
+	if(!entry.isNull()
+	&& (img.count(H_CFG_CNT) == 0 || Address(img.field(H_CFG_OFF, CFG_SIZE, 0, 0)) != entry))
+		return false;
+	t::uint32 flags = img.header(H_FLAGS);
+	if(flags & HARD_PROC)
+		ws->require(hard::PROCESSOR_FEATURE, props);
+	if(flags & HARD_MEM)
+		ws->require(hard::MEMORY_FEATURE, props);
+	if(flags & HARD_CACHE)
+		ws->require(hard::CACHE_CONFIGURATION_FEATURE, props);
+	return img.matches(ws);
+}
+
+
+/**
+ */
+void SnapshotLoader::configure(const PropList& props) {
+	Processor::configure(props);
+	path = SNAPSHOT_PATH(props);
+
+	// provide the recorded features
+	if(!path || !readImage(path, buf))
+		return;
+	Image img(buf);
+	if(!img.isValid())
+		return;
+	if(img.header(H_FLAGS) & HAS_LOOP_HEADERS)
+		provide(LOOP_HEADERS_FEATURE);
+	if(img.header(H_FLAGS) & HAS_LOOP_INFO)
+		provide(LOOP_INFO_FEATURE);
+	if(img.header(H_FLAGS) & HARD_PROC)
+		require(hard::PROCESSOR_FEATURE);
+	if(img.header(H_FLAGS) & HARD_MEM)
+		require(hard::MEMORY_FEATURE);
+	if(img.header(H_FLAGS) & HARD_CACHE)
+		require(hard::CACHE_CONFIGURATION_FEATURE);
+	for(t::uint32 i = 0; i < img.count(H_FEAT_CNT); i++) {
+		t::uint32 name = img.field(H_FEAT_OFF, FEAT_SIZE, i, 0);
+		AbstractFeature *f = img.isString(name) ? ProcessorPlugin::getFeature(img.str(name)) : nullptr;
+		if(f == nullptr)
+			warn(_ << "cannot find feature " << img.str(name) << " recorded in the snapshot.");
+		else
+			provide(*f);
+	}
+}
+
+
+/**
+ */
+void SnapshotLoader::processWorkSpace(WorkSpace *ws) {
+	if(!path)
+		throw ProcessorException(*this, "no snapshot path given (otawa::SNAPSHOT_PATH).");
+	Image img(buf);
+	if(!img.isValid())
+		throw ProcessorException(*this, _ << path << " is not a valid snapshot.");
+	if(!img.matches(ws))
+		throw ProcessorException(*this, _ << "snapshot " << path << " does not match the program "
+			<< ws->process()->program()->name() << " or the hardware configuration");
+	t::uint32 flags = img.header(H_FLAGS);
+	t::uint32 cfg_cnt = img.count(H_CFG_CNT), block_cnt = img.count(H_BLOCK_CNT);
+	auto check = [&](bool cond) {
+		if(!cond)
+			throw ProcessorException(*this, _ << "corrupted snapshot " << path);
+	};
+	auto block = [&](t::uint32 i) -> t::uint32 {
+		check(i == NONE || i < block_cnt);
+		return i;
+	};
+
+	// create the CFG makers
+	Vector<CFGMaker *> makers;
+	for(t::uint32 i = 0; i < cfg_cnt; i++)
+		makers.add(new CFGMaker(ws->findInstAt(Address(img.field(H_CFG_OFF, CFG_SIZE, i, 0))), true));
+
+	// create the blocks in their original order
+	Vector<Block *> blocks(block_cnt);
+	Vector<CFGMaker *> owners(block_cnt);
+	for(t::uint32 i = 0; i < cfg_cnt; i++) {
+		CFGMaker *m = makers[i];
+		check(img.field(H_CFG_OFF, CFG_SIZE, i, 1) == t::uint32(blocks.length()));
+		t::uint32 cnt = img.field(H_CFG_OFF, CFG_SIZE, i, 2);
+		check(blocks.length() + cnt <= block_cnt);
+		for(t::uint32 j = 0; j < cnt; j++) {
+			t::uint32 b = blocks.length();
+			t::uint32 kind = img.field(H_BLOCK_OFF, BLOCK_SIZE, b, 0);
+			Address addr = img.field(H_BLOCK_OFF, BLOCK_SIZE, b, 1);
+			t::uint32 info = img.field(H_BLOCK_OFF, BLOCK_SIZE, b, 2);
+			Block *v = nullptr;
+			check((kind & 0xff) == ENTRY ? j == 0 : j != 0);
+			switch(kind & 0xff) {
+			case ENTRY:
+				v = m->entry();
+				break;
+			case EXIT:
+				v = m->exit();
+				break;
+			case UNKNOWN:
+				v = m->unknown();
+				break;
+			case PHONY:
+				v = new PhonyBlock();
+				m->add(v);
+				break;
+			case BASIC: {
+					Vector<Inst *> is;
+					Address ea = addr + info;
+					for(auto i = ws->findInstAt(addr); i != nullptr && i->address() < ea; i = i->nextInst())
+						is.add(i);
+					check(!is.isEmpty());
+					v = new BasicBlock(is.detach());
+					m->add(v);
+				}
+				break;
+			case SYNTH: {
+					auto c = new SynthBlock();
+					if(info == NONE)
+						m->call(c, nullptr);
+					else {
+						check(info < cfg_cnt);
+						m->call(c, *makers[info]);
+					}
+					v = c;
+				}
+				break;
+			default:
+				check(false);
+				break;
+			}
+			check(v->index() == int(j));
+			if((flags & HAS_LOOP_HEADERS) && ((kind >> 8) & BLOCK_LOOP_HEADER))
+				LOOP_HEADER(v) = true;
+			blocks.add(v);
+			owners.add(m);
+		}
+	}
+	check(t::uint32(blocks.length()) == block_cnt);
+
+	// record the enclosing loop headers
+	if(flags & HAS_LOOP_INFO)
+		for(t::uint32 i = 0; i < block_cnt; i++) {
+			if(LOOP_HEADER(blocks[i]))
+				EXIT_LIST(blocks[i]) = new Vector<Edge *>();
+			t::uint32 h = block(img.field(H_BLOCK_OFF, BLOCK_SIZE, i, 3));
+			if(h != NONE)
+				ENCLOSING_LOOP_HEADER(blocks[i]) = blocks[h];
+		}
+
+	// create the edges
+	Vector<Edge *> edges(img.count(H_EDGE_CNT));
+	for(t::uint32 i = 0; i < img.count(H_EDGE_CNT); i++) {
+		t::uint32 src = block(img.field(H_EDGE_OFF, EDGE_SIZE, i, 0));
+		t::uint32 snk = block(img.field(H_EDGE_OFF, EDGE_SIZE, i, 1));
+		check(src != NONE && snk != NONE && owners[src] == owners[snk]);
+		Edge *e = new Edge(img.field(H_EDGE_OFF, EDGE_SIZE, i, 2));
+		owners[src]->add(blocks[src], blocks[snk], e);
+		if((flags & HAS_LOOP_HEADERS) && (img.field(H_EDGE_OFF, EDGE_SIZE, i, 3) & EDGE_BACK))
+			BACK_EDGE(e) = true;
+		if(flags & HAS_LOOP_INFO) {
+			t::uint32 h = block(img.field(H_EDGE_OFF, EDGE_SIZE, i, 4));
+			if(h != NONE)
+				LOOP_ENTRY(e) = blocks[h];
+			h = block(img.field(H_EDGE_OFF, EDGE_SIZE, i, 5));
+			if(h != NONE) {
+				check(EXIT_LIST(blocks[h]));
+				LOOP_EXIT(e) = blocks[h];
+				EXIT_LIST(blocks[h])->add(e);
+			}
+		}
+		edges.add(e);
+	}
+
+	// build the collection
+	coll = new CFGCollection();
+	for(auto m: makers) {
+		coll->add(m->build());
+		delete m;
+	}
+
+	// restore the properties
+	Vector<AbstractIdentifier *> ids;
+	for(t::uint32 i = 0; i < img.count(H_ID_CNT); i++) {
+		t::uint32 name = img.field(H_ID_OFF, ID_SIZE, i, 0);
+		check(img.isString(name));
+		AbstractIdentifier *id = ProcessorPlugin::getIdentifier(img.str(name));
+		if(id == nullptr)
+			warn(_ << "cannot find identifier " << img.str(name) << " recorded in the snapshot: ignored.");
+		ids.add(id);
+	}
+	for(t::uint32 i = 0; i < img.count(H_PROP_CNT); i++) {
+		t::uint32 kind = img.field(H_PROP_OFF, PROP_SIZE, i, 0);
+		t::uint32 owner = img.field(H_PROP_OFF, PROP_SIZE, i, 1);
+		t::uint32 id = img.field(H_PROP_OFF, PROP_SIZE, i, 2);
+		t::uint32 val = img.field(H_PROP_OFF, PROP_SIZE, i, 3);
+		check(id < t::uint32(ids.length()) && img.isString(val));
+		if(ids[id] == nullptr)
+			continue;
+		PropList *props = nullptr;
+		switch(kind) {
+		case OWNER_WS:
+			props = ws;
+			if(!ws_ids.contains(ids[id]))
+				ws_ids.add(ids[id]);
+			break;
+		case OWNER_CFG:
+			check(owner < cfg_cnt);
+			props = coll->get(owner);
+			break;
+		case OWNER_BLOCK:
+			check(owner < block_cnt);
+			props = blocks[owner];
+			break;
+		case OWNER_EDGE:
+			check(owner < t::uint32(edges.length()));
+			props = edges[owner];
+			break;
+		default:
+			check(false);
+			break;
+		}
+		const SnapshotSerializer *ser = SnapshotSerializer::find(ids[id]);
+		if(ser == nullptr)
+			ids[id]->fromString(*props, img.str(val));
+		else
+			check(ser->load(img.str(val), *props));
+	}
+
+	if(logFor(LOG_PROC))
+		log << "\tsnapshot restored from " << path << " (" << cfg_cnt << " CFGs, "
+			<< block_cnt << " blocks, " << img.count(H_PROP_CNT) << " properties)\n";
+	buf.clear();
+}
+
+
+/**
+ */
+void SnapshotLoader::cleanup(WorkSpace *ws) {
+	ENTRY_CFG(ws) = coll->get(0);
+	INVOLVED_CFGS(ws) = coll;
+}
+
+
+/**
+ */
+void SnapshotLoader::destroy(WorkSpace *ws) {
+	for(auto id: ws_ids)
+		ws->removeProp(id);
+	ws_ids.clear();
+	if(coll != nullptr) {
+		for(auto g: *coll)
+			for(auto v: *g)
+				if(EXIT_LIST(v)) {
+					delete EXIT_LIST(v);
+					EXIT_LIST(v).remove();
+				}
+		ENTRY_CFG(ws).remove();
+		INVOLVED_CFGS(ws).remove();
+		delete coll;
+		coll = nullptr;
+	}
+}
+
+
+/**
+ */
+void *SnapshotLoader::interfaceFor(const AbstractFeature &feature) {
+	if(feature == COLLECTED_CFG_FEATURE)
+		return coll;
+	else
+		return nullptr;
+}
+
+
+/**
+ * Path of the snapshot file to save to (@ref SnapshotSaver) or to
+ * load from (@ref SnapshotLoader).
+ * @ingroup snapshot
+ */
+p::id<sys::Path> SNAPSHOT_PATH("otawa::SNAPSHOT_PATH", "");
+
+
+/**
+ * Name of an identifier whose properties, on the workspace, the CFGs, the blocks
+ * and the edges, have to be recorded in the snapshot. Several identifiers may be
+ * given. Only identifiers of base type or with a @ref SnapshotSerializer are supported.
+ * @ingroup snapshot
+ */
+p::id<cstring> SNAPSHOT_INCLUDE("otawa::SNAPSHOT_INCLUDE", "");
+
+
+/**
+ * Name of a feature to record in the snapshot: it will be provided again
+ * when the snapshot is restored. Several features may be given. It is up
+ * to the user to record the properties representing these features with
+ * @ref SNAPSHOT_INCLUDE.
+ * @ingroup snapshot
+ */
+p::id<cstring> SNAPSHOT_PROVIDE("otawa::SNAPSHOT_PROVIDE", "");
+
+
+/**
+ * This feature is provided when the CFG collection, the loop information and
+ * the recorded properties have been restored from a snapshot.
+ *
+ * @par Configuration
+ * @li @ref SNAPSHOT_PATH
+ *
+ * @par Default processor
+ * @li @ref SnapshotLoader
+ *
+ * @ingroup snapshot
+ */
+p::feature SNAPSHOT_RESTORED_FEATURE("otawa::SNAPSHOT_RESTORED_FEATURE", p::make<SnapshotLoader>());
+
+}	// otawa
@@ -31,11 +31,14 @@
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/proc/FeatureDependency.h>
 #include <otawa/proc/Processor.h>
+#include <otawa/proc/Profiler.h>
 #include <otawa/proc/Registry.h>
+#include <otawa/proc/TaskPool.h>
 #include <otawa/prog/File.h>
 #include <otawa/prog/Loader.h>
 #include <otawa/prog/Symbol.h>
 #include <otawa/prog/WorkSpace.h>
+#include "rcu.h"
 
 // Trace
 //#define FRAMEWORK_TRACE
@@ -248,7 +251,7 @@ WorkSpace *WorkSpace::load(sys::Path path, const PropList& props) {
  * Build a new wokspace with the given process.
  * @param _proc	Process to use.
  */
-WorkSpace::WorkSpace(Process *_proc): proc(_proc), cancelled(false) {
+WorkSpace::WorkSpace(Process *_proc): proc(_proc), cancelled(false), _pool(nullptr) {
 	TRACE(this << ".WorkSpace::WorkSpace(" << _proc << ')');
 	ASSERT(_proc);
 	const List<AbstractFeature *>& feats = _proc->features();
@@ -264,7 +267,7 @@ WorkSpace::WorkSpace(Process *_proc): proc(_proc), cancelled(false) {
  * Build a new workspace on the same process as the given one.
  * @param ws	Workspace to get the process form.
  */
-WorkSpace::WorkSpace(const WorkSpace *ws): cancelled(false) {
+WorkSpace::WorkSpace(const WorkSpace *ws): cancelled(false), _pool(nullptr) {
 	TRACE(this << ".WorkSpace::WorkSpace(" << ws << ')');
 	ASSERT(ws);
 	proc = ws->process();
@@ -294,6 +297,10 @@ WorkSpace::~WorkSpace(void) {
 	// invalidate dependencies
 	for(Vector<Dependency *>::Iter i(roots); i(); i++)
 		invalidate(*i);
+
+	// release the task pool
+	if(_pool)
+		delete _pool;
 }
 
 
@@ -730,8 +737,22 @@ bool WorkSpace::provides(cstring name) {
  * @param props		Configuration properties (optional).
  */
 void WorkSpace::require(const AbstractFeature& feature, const PropList& props) {
-	if(!isProvided(feature))
-		feature.process(this, props);
+	if(!isProvided(feature)) {
+		Profiler *prof = PROFILER(this);
+		if(prof == nullptr)
+			feature.process(this, props);
+		else {
+			prof->start(feature);
+			try {
+				feature.process(this, props);
+			}
+			catch(...) {
+				prof->stop(feature);
+				throw;
+			}
+			prof->stop(feature);
+		}
+	}
 }
 
 
@@ -788,147 +809,13 @@ void WorkSpace::unserialize(elm::serial2::Unserializer& unserializer) {
 
 
 #ifdef OTAWA_CONC
-#	define CONC_DEBUG(x)	//cerr << x
-	class RCURunnable: public sys::Runnable {
-		friend class WorkSpace;
-	public:
-
-		RCURunnable(void): to_run(0) {
-			sys::Thread::make(*this);
-		}
-
-		inline bool isRoot(void) const { return this == &root; }
-
-		virtual void run(void) {
-			ASSERT(to_run);
-			CONC_DEBUG("DEBUG: running " << (void *)this << " on " << (void *)to_run << io::endl);
-
-			// launch the runnable
-			to_run->run();
-
-			// end launching
-			mutex->lock();
-			running.remove(this);
-			avail.add(this);
-			check();
-			mutex->unlock();
-		}
-
-		void clean(void) {
-			for(List<Property *>::iter i(to_free); i; i++)
-				delete *i;
-			to_free.clear();
-		}
-
-		static void init(void) {
-			static bool initialized = false;
-			if(!initialized) {
-				initialized = true;
-				mutex = sys::Mutex::make();
-				core_count = sys::System::coreCount();
-			}
-		}
-
-		static void check(void) {
-			if(!running) {
-				for(List<RCURunnable *>::iter i(avail); i; i++)
-					i->clean();
-				root.clean();
-			}
-		}
-
-		static void runInRoot(sys::Runnable *runnable) {
-			runnable->run();
-			mutex->lock();
-			check();
-			mutex->unlock();
-		}
-
-		static sys::Thread *run(sys::Runnable *runnable) {
-
-			// lock
-			init();
-			mutex->lock();
-
-			// look for a free thread
-			if(avail) {
-				RCURunnable *t = avail.pop();
-				running.add(t);
-				CONC_DEBUG("DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
-				t->to_run = runnable;
-				t->thread()->start();
-				mutex->unlock();
-				return t->thread();
-			}
-
-			// add a new one if any core is remaining
-			else if(running.count() < core_count - 1) {
-				RCURunnable *t = new RCURunnable();
-				CONC_DEBUG(cerr << "DEBUG: created " << (void *)t << io::endl);
-				running.add(t);
-				CONC_DEBUG(cerr << "DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
-				t->to_run = runnable;
-				t->thread()->start();
-				mutex->unlock();
-				return t->thread();
-			}
-
-			// only main core remains: run in main core
-			else {
-				mutex->unlock();
-				runInRoot(runnable);
-				return 0;
-			}
-		}
-
-		static void runAll(Runnable *runnable) {
-			CONC_DEBUG("DEBUG: RCU::runAll()\n");
-
-			// count available threads
-			init();
-			mutex->lock();
-			int c = RCURunnable::core_count - running.count() - 1;
-			mutex->unlock();
-			CONC_DEBUG("DEBUG: " << c << " threads available (" << core_count << ").\n");
-
-			// run available threads
-			Vector<sys::Thread *> to_wait;
-			for(int i = 0; i < c; i++) {
-				to_wait.add(run(runnable));
-				CONC_DEBUG("DEBUG: launched thread " << (void *)to_wait.top() << io::endl);
-			}
-			runInRoot(runnable);		// root thread
-
-			// wait for end of used threads
-			for(int i = 0; i < to_wait.count(); i++)
-				if(to_wait[i]) {
-					CONC_DEBUG("DEBUG: waiting for thread " << (void *)to_wait[i] << io::endl);
-					to_wait[i]->join();
-					CONC_DEBUG("DEBUG: ended for thread " << (void *)to_wait[i] << io::endl);
-				}
-		}
-
-		static void remove(Property *prop) {
-			if(!running)
-				delete prop;
-			else
-				static_cast<RCURunnable&>(current()).to_free.add(prop);
-		}
-
-	private:
-		sys::Runnable *to_run;
-		List<Property *> to_free;
-
-		static RCURunnable root;
-		static sys::Mutex *mutex;
-		static List<RCURunnable *> avail, running;
-		static int core_count;
-	};
-
 	RCURunnable RCURunnable::root;
 	sys::Mutex *RCURunnable::mutex = 0;
-	List<RCURunnable *> RCURunnable::avail, RCURunnable::running;
+	List<RCURunnable *> RCURunnable::avail, RCURunnable::running, RCURunnable::attached;
 	int RCURunnable::core_count = 0;
+	std::atomic<t::uint64> RCURunnable::epoch(0);
+	std::atomic<int> RCURunnable::active(0);
+	thread_local RCURunnable *RCURunnable::self = 0;
 #endif
 
 
@@ -971,7 +858,9 @@ void WorkSpace::runAll(sys::Runnable& runnable) {
 }
 
 /**
- * Remove a property in a thread-safe way.
+ * Remove a property in a thread-safe way. If threads are running,
+ * the property is only freed when no thread can reference it anymore
+ * (see @ref prop_conc).
  * @param prop	Property to remove.
  */
 void WorkSpace::remove(Property *prop) {
@@ -982,6 +871,31 @@ void WorkSpace::remove(Property *prop) {
 #	endif
 }
 
+/**
+ * Inform that the current thread has reached a quiescent point, that is,
+ * it does not hold any reference on properties obtained before this call.
+ * This allows to free the properties removed in the meantime. It has no
+ * effect if the current thread has not been launched by run() or runAll().
+ */
+void WorkSpace::quiesce(void) {
+#	ifdef OTAWA_CONC
+		RCURunnable::quiesce();
+#	endif
+}
+
+
+/**
+ * Get the task pool of the workspace, creating it at the first call.
+ * Its size is given by the @ref THREAD_COUNT configuration found
+ * in the workspace property list.
+ * @return	Workspace task pool.
+ */
+TaskPool& WorkSpace::pool(void) {
+	if(!_pool)
+		_pool = new TaskPool(THREAD_COUNT(this));
+	return *_pool;
+}
+
 
 /**
  */
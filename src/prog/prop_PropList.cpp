@@ -20,6 +20,10 @@
  */
 
 #include "config.h"
+#ifdef OTAWA_CONC
+#	include <atomic>
+#endif
+#include <elm/data/Vector.h>
 #include <elm/io.h>
 #include <elm/util/VarArg.h>
 #include <otawa/prog/WorkSpace.h>
@@ -29,6 +33,83 @@ using namespace elm;
 
 namespace otawa {
 
+#ifdef OTAWA_CONC
+
+	// property counters (for profiling): only updated while a profiler is active
+	static std::atomic<int> counting(0);
+	static std::atomic<t::uint64> added_count(0), disposed_count(0);
+	static inline bool isCounting(void) { return counting.load(std::memory_order_relaxed) != 0; }
+	static inline void added(void)
+		{ if(isCounting()) added_count.fetch_add(1, std::memory_order_relaxed); }
+
+	// readers walk the list without lock: links are published with release
+	// semantics and removed properties are only freed at quiescent points
+	static inline Property *load(Property *const& ref)
+		{ return __atomic_load_n(&ref, __ATOMIC_ACQUIRE); }
+	static inline void publish(Property *& ref, Property *prop)
+		{ __atomic_store_n(&ref, prop, __ATOMIC_RELEASE); }
+	static inline void dispose(Property *prop) {
+		if(isCounting())
+			disposed_count.fetch_add(1, std::memory_order_relaxed);
+		WorkSpace::remove(prop);
+	}
+	static inline void startCount(void) { counting.fetch_add(1, std::memory_order_relaxed); }
+	static inline void stopCount(void) { counting.fetch_sub(1, std::memory_order_relaxed); }
+
+	// writers are serialized per property list using a striped lock table
+	// (when two lists are locked, the stripes are taken in table order)
+	class WriteLock {
+	public:
+		inline WriteLock(const PropList *list): l1(&lockOf(list)), l2(nullptr)
+			{ acquire(*l1); }
+		inline WriteLock(const PropList *list1, const PropList *list2): l1(&lockOf(list1)), l2(&lockOf(list2)) {
+			if(l1 == l2)
+				l2 = nullptr;
+			else if(l2 < l1)
+				swap(l1, l2);
+			acquire(*l1);
+			if(l2 != nullptr)
+				acquire(*l2);
+		}
+		inline ~WriteLock(void) {
+			if(l2 != nullptr)
+				l2->store(false, std::memory_order_release);
+			l1->store(false, std::memory_order_release);
+		}
+	private:
+		static const int LOCK_COUNT = 256;
+		static std::atomic<bool> locks[LOCK_COUNT];
+		static inline std::atomic<bool>& lockOf(const PropList *list)
+			{ return locks[(reinterpret_cast<unsigned long>(list) >> 4) & (LOCK_COUNT - 1)]; }
+		static inline void acquire(std::atomic<bool>& lock) {
+			while(lock.exchange(true, std::memory_order_acquire))
+				while(lock.load(std::memory_order_relaxed))
+					continue;
+		}
+		std::atomic<bool> *l1, *l2;
+	};
+	std::atomic<bool> WriteLock::locks[WriteLock::LOCK_COUNT];
+
+#else
+
+	static int counting = 0;
+	static t::uint64 added_count = 0, disposed_count = 0;
+	static inline void added(void) { if(counting) added_count++; }
+	static inline void startCount(void) { counting++; }
+	static inline void stopCount(void) { counting--; }
+
+	static inline Property *load(Property *const& ref) { return ref; }
+	static inline void publish(Property *& ref, Property *prop) { ref = prop; }
+	static inline void dispose(Property *prop) { if(counting) disposed_count++; delete prop; }
+
+	class WriteLock {
+	public:
+		inline WriteLock(const PropList *) { }
+		inline WriteLock(const PropList *, const PropList *) { }
+	};
+
+#endif
+
 /**
  * @defgroup prop Properties System
  *
@@ -213,6 +294,22 @@ This section has listed the main primitives used to handle properties. The follo
  * @endcode
  * It is currently the preferred form to use properties but a lot of already-
  * existing identifiers in OTAWA does not already supports this work.
+ *
+ * @section prop_conc Concurrent Access
+ * When OTAWA is built with concurrency support (OTAWA_CONC), the property lists
+ * may be accessed by several threads started with WorkSpace::run() or
+ * WorkSpace::runAll():
+ * @li look-ups do not take any lock and never modify the list,
+ * @li modifications of a same list are serialized by a write lock,
+ * @li the new links are published atomically so that a reader always sees
+ * a consistent list,
+ * @li removed properties are not freed immediately but retired with
+ * WorkSpace::remove() and freed when no thread may still reference them,
+ * that is, when every running thread has passed a quiescent point
+ * (WorkSpace::quiesce()) or has ended.
+ *
+ * As a consequence, a thread must not keep a pointer to a property value
+ * across a call to WorkSpace::quiesce().
  */
 
 
@@ -328,6 +425,189 @@ const AbstractIdentifier END("end");
 }*/
 
 
+// identifier of the hidden index property
+static const AbstractIdentifier INDEX_ID("");
+
+
+/**
+ * Index of the properties of a property list by their identifier. It is
+ * an open-addressing table (linear probing) associating an identifier with
+ * the first property of the list having this identifier.
+ *
+ * The index is itself stored as a hidden property at the head of the list
+ * (with the private identifier PropList::INDEX) so that non-indexed lists do not
+ * pay for it. It only speeds up the look-up: the linked list of properties
+ * remains the reference storage and is used by iterators and getters.
+ */
+class PropIndex: public Property {
+public:
+	static const int INIT_SIZE = 16;
+
+	inline PropIndex(void): Property(INDEX_ID), tab(new entry_t[INIT_SIZE]), cap(INIT_SIZE), cnt(0)
+		{ clear(tab, cap); }
+
+	/**
+	 * Find the first property matching the given identifier.
+	 * @param id	Looked identifier.
+	 * @return		Found property or null.
+	 */
+	inline Property *get(const AbstractIdentifier *id) const {
+		for(int i = hash(id); tab[i].id; i = (i + 1) & (cap - 1))
+			if(tab[i].id == id)
+				return tab[i].prop;
+		return 0;
+	}
+
+	/**
+	 * Set the first property of its identifier.
+	 * @param prop	New first property.
+	 */
+	void put(Property *prop) {
+		int i = hash(prop->id());
+		for(; tab[i].id; i = (i + 1) & (cap - 1))
+			if(tab[i].id == prop->id()) {
+				tab[i].prop = prop;
+				return;
+			}
+		tab[i].id = prop->id();
+		tab[i].prop = prop;
+		cnt++;
+		if(cnt * 4 > cap * 3)
+			grow();
+	}
+
+	/**
+	 * Remove the given identifier from the index.
+	 * @param id	Identifier to remove.
+	 */
+	void remove(const AbstractIdentifier *id) {
+		int i = hash(id);
+		for(; tab[i].id != id; i = (i + 1) & (cap - 1))
+			if(!tab[i].id)
+				return;
+		cnt--;
+
+		// backward-shift to keep probe chains unbroken
+		int j = i;
+		while(true) {
+			j = (j + 1) & (cap - 1);
+			if(!tab[j].id)
+				break;
+			int k = hash(tab[j].id);
+			if((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+				continue;
+			tab[i] = tab[j];
+			i = j;
+		}
+		tab[i].id = 0;
+		tab[i].prop = 0;
+	}
+
+protected:
+	~PropIndex(void) override { delete [] tab; }
+	Property *copy(void) override { ASSERT(false); return 0; }
+
+private:
+	typedef struct {
+		const AbstractIdentifier *id;
+		Property *prop;
+	} entry_t;
+
+	inline int hash(const AbstractIdentifier *id) const
+		{ return int(((reinterpret_cast<unsigned long>(id) >> 4) * 0x9E3779B1UL) & (cap - 1)); }
+
+	static inline void clear(entry_t *t, int n)
+		{ for(int i = 0; i < n; i++) { t[i].id = 0; t[i].prop = 0; } }
+
+	void grow(void) {
+		entry_t *otab = tab;
+		int ocap = cap;
+		cap *= 2;
+		tab = new entry_t[cap];
+		clear(tab, cap);
+		for(int i = 0; i < ocap; i++)
+			if(otab[i].id) {
+				int j = hash(otab[i].id);
+				while(tab[j].id)
+					j = (j + 1) & (cap - 1);
+				tab[j] = otab[i];
+			}
+		delete [] otab;
+	}
+
+	entry_t *tab;
+	int cap, cnt;
+};
+
+const AbstractIdentifier& PropList::INDEX = INDEX_ID;
+
+
+/**
+ * @fn bool PropList::isIndexed(void) const;
+ * Test if the property list is in indexed mode, that is, if its properties
+ * are looked up using a hash table instead of scanning the list.
+ * @return	True if the list is indexed, false else.
+ */
+
+
+/**
+ * Switch the property list to or from the indexed mode. In indexed mode,
+ * the properties are found by hashing their identifier instead of scanning
+ * the list: this is only worth for lists supporting many properties and
+ * intensively looked up (for instance, the blocks of a heavily annotated CFG).
+ * Copies of the list (constructor, operator=(), addProps()) are not indexed.
+ *
+ * In the concurrent version of OTAWA (OTAWA_CONC), the look-up does not take
+ * the lock of the list and the indexed mode is not supported: this call has no effect.
+ *
+ * @param indexed	True to index the list, false to return to linear look-up.
+ */
+void PropList::setIndexed(bool indexed) {
+#	ifndef OTAWA_CONC
+		if(indexed == isIndexed())
+			return;
+		if(indexed) {
+			PropIndex *idx = new PropIndex();
+			for(Property *cur = head; cur; cur = cur->next())
+				if(!idx->get(cur->id()))
+					idx->put(cur);
+			idx->_next = head;
+			head = idx;
+		}
+		else {
+			Property *idx = head;
+			head = idx->next();
+			delete idx;
+		}
+#	endif
+}
+
+
+/**
+ * Get the index of the list (only if the list is indexed).
+ * @return	List index.
+ */
+inline PropIndex *PropList::index(void) const {
+	return static_cast<PropIndex *>(head);
+}
+
+
+/**
+ * Update the index after the removal of the first property with the given
+ * identifier.
+ * @param id	Identifier of the removed property.
+ * @param from	Property following the removed one.
+ */
+void PropList::reindex(const AbstractIdentifier *id, Property *from) {
+	for(Property *cur = from; cur; cur = cur->next())
+		if(cur->id() == id) {
+			index()->put(cur);
+			return;
+		}
+	index()->remove(id);
+}
+
+
 /**
  * @fn PropList::PropList(const PropList& props);
  * Build a property list as a copy of another one.
@@ -346,27 +626,59 @@ const AbstractIdentifier END("end");
  * @param props	Property list to clone.
  */
 void PropList::addProps(const PropList& props) {
-	for(Property *cur = props.head; cur; cur = cur->next()) {
+	for(Property *cur = load(props.head); cur; cur = load(cur->_next)) {
+		if(cur->id() == &INDEX)
+			continue;
 		Property *copy = cur->copy();
 		addProp(copy);
 	}
 }
 
 
+// release a detached list of properties (the index is not counted)
+static void disposeAll(Property *cur) {
+	for(Property *next; cur; cur = next) {
+		next = cur->next();
+		if(cur->id() == &INDEX_ID)
+			delete cur;
+		else
+			dispose(cur);
+	}
+}
+
+
 /**
  * Take properties from props to the current property list.
+ * The current properties are removed. Both lists keep their indexing
+ * mode (see setIndexed()).
  * @param props		Property list to move properties from.
  */
 void PropList::takeProps(PropList& props) {
-	clearProps();
-	this->head = props.head;
-	props.head = 0;
+	if(&props == this)
+		return;
+	bool indexed = isIndexed(), props_indexed = props.isIndexed();
+	Property *old;
+	{
+		WriteLock lock(this, &props);
+		old = head;
+		publish(head, props.head);
+		publish(props.head, 0);
+	}
+	disposeAll(old);
+
+	// the index, if any, has moved with the properties
+	setIndexed(indexed);
+	props.setIndexed(props_indexed);
 }
 
 
 
 /**
  * Find a property by its identifier.
+ *
+ * If the list is not indexed (see setIndexed()), the property is looked up
+ * by scanning the list and the found property is moved at the head.
+ *
  * @param id	Identifier of the property to find.
  * @return		Found property or null.
  */
@@ -374,6 +686,8 @@ Property *PropList::getProp(const AbstractIdentifier *id) const {
 
 	/* Look in this list */
 #	ifndef OTAWA_CONC
+		if(isIndexed())
+			return index()->get(id);
 		for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
 			if(cur->id() == id) {
 				if(prev) {
@@ -384,7 +698,7 @@ Property *PropList::getProp(const AbstractIdentifier *id) const {
 				return cur;
 			}
 #	else
-		for(Property *cur = head; cur; cur = cur->next())
+		for(Property *cur = load(head); cur; cur = load(cur->_next))
 			if(cur->id() == id)
 				return cur;
 #	endif
@@ -399,21 +713,37 @@ Property *PropList::getProp(const AbstractIdentifier *id) const {
  * @param prop	Property to set.
  */
 void PropList::setProp(Property *prop) {
+	Property *old = 0;
+	{
+		WriteLock lock(this);
+
+		// Find the property
+		bool indexed = isIndexed();
+		if(!indexed || index()->get(prop->id()))
+			for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
+				if(cur->id() == prop->id()) {
+					if(prev)
+						publish(prev->_next, cur->next());
+					else
+						publish(head, cur->next());
+					old = cur;
+					break;
+				}
 
-	// Find the property
-	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
-		if(cur->id() == prop->id()) {
-			if(prev)
-				prev->_next = cur->next();
-			else
-				head = cur->next();
-			delete cur;
-			break;
+		// Link the new property
+		added();
+		if(indexed) {
+			prop->_next = head->_next;
+			head->_next = prop;
+			index()->put(prop);
 		}
-
-	// Link the new property
-	prop->_next = head;
-	head = prop;
+		else {
+			prop->_next = head;
+			publish(head, prop);
+		}
+	}
+	if(old)
+		dispose(old);
 }
 
 
@@ -429,19 +759,9 @@ void PropList::setProp(Property *prop) {
  * @param id	Identifier of the property to remove.
  */
 void PropList::removeProp(const AbstractIdentifier *id) {
-	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
-		if(cur->id() == id) {
-			if(prev)
-				prev->_next = cur->next();
-			else
-				head = cur->next();
-#			ifdef OTAWA_CONC
-				WorkSpace::remove(cur);
-#			else
-				delete cur;
-#			endif
-			break;
-		}
+	Property *prop = extractProp(id);
+	if(prop)
+		dispose(prop);
 }
 
 
@@ -451,12 +771,18 @@ void PropList::removeProp(const AbstractIdentifier *id) {
  * @param id	Identifier of the property to extract.
  */
 Property *PropList::extractProp(const AbstractIdentifier *id) {
+	WriteLock lock(this);
+	bool indexed = isIndexed();
+	if(indexed && !index()->get(id))
+		return 0;
 	for(Property *cur = head, *prev = 0; cur; prev = cur, cur = cur->next())
 		if(cur->id() == id) {
 			if(prev)
-				prev->_next = cur->next();
+				publish(prev->_next, cur->next());
 			else
-				head = cur->next();
+				publish(head, cur->next());
+			if(indexed)
+				reindex(id, cur->next());
 			return cur;
 			break;
 		}
@@ -473,14 +799,68 @@ Property *PropList::extractProp(const AbstractIdentifier *id) {
 
 
 /**
- * Remove all properties from the list.
+ * Start counting the added and released properties (see countAdded() and
+ * countDisposed()). As counting has a cost on each property operation,
+ * it is only performed between calls to startCounting() and stopCounting()
+ * (calls may be nested). Mainly used by Profiler.
+ */
+void PropList::startCounting(void) {
+	startCount();
+}
+
+
+/**
+ * Stop counting the added and released properties.
+ */
+void PropList::stopCounting(void) {
+	stopCount();
+}
+
+
+/**
+ * Get the number of properties added to any property list while counting
+ * is active (see startCounting()).
+ * @return	Count of added properties.
+ */
+t::uint64 PropList::countAdded(void) {
+	return added_count;
+}
+
+
+/**
+ * Get the number of properties released from any property list while counting
+ * is active (see startCounting()).
+ * @return	Count of released properties.
+ */
+t::uint64 PropList::countDisposed(void) {
+	return disposed_count;
+}
+
+
+/**
+ * Remove all properties from the list. An indexed list stays indexed.
  */
 void PropList::clearProps(void) {
-	for(Property *cur = head, *next; cur; cur = next) {
-		next = cur->next();
-		delete cur;
+	clear(true);
+}
+
+
+/**
+ * Remove all properties from the list.
+ * @param keep_index	If true and the list is indexed, the list is indexed
+ * 						again after the removal.
+ */
+void PropList::clear(bool keep_index) {
+	bool indexed = keep_index && isIndexed();
+	Property *cur;
+	{
+		WriteLock lock(this);
+		cur = head;
+		publish(head, 0);
 	}
-	head = 0;
+	disposeAll(cur);
+	if(indexed)
+		setIndexed(true);
 }
 
 
@@ -561,8 +941,17 @@ void PropList::clearProps(void) {
  * @param prop	Property to add.
  */
 void PropList::addProp(Property *prop) {
-	prop->_next = head;
-	head = prop;
+	WriteLock lock(this);
+	added();
+	if(isIndexed()) {
+		prop->_next = head->_next;
+		head->_next = prop;
+		index()->put(prop);
+	}
+	else {
+		prop->_next = head;
+		publish(head, prop);
+	}
 }
 
 
@@ -571,25 +960,35 @@ void PropList::addProp(Property *prop) {
  * @param id	Identifier of properties to remove.
  */
 void PropList::removeAllProp(const AbstractIdentifier *id) {
-	Property *prv = 0, *cur = head;
-	while(cur) {
-		if(cur->id() != id) {
-			prv = cur;
-			cur = cur->next();
+	Vector<Property *> dead;
+	{
+		WriteLock lock(this);
+		if(isIndexed()) {
+			if(!index()->get(id))
+				return;
+			index()->remove(id);
 		}
-		else {
-			if(prv) {
-				prv->_next = cur->next();
-				delete cur;
-				cur = prv->next();
+		Property *prv = 0, *cur = head;
+		while(cur) {
+			if(cur->id() != id) {
+				prv = cur;
+				cur = cur->next();
 			}
 			else {
-				head = cur->next();
-				delete cur;
-				cur = head;
+				dead.add(cur);
+				if(prv) {
+					publish(prv->_next, cur->next());
+					cur = prv->next();
+				}
+				else {
+					publish(head, cur->next());
+					cur = head;
+				}
 			}
 		}
 	}
+	for(auto prop: dead)
+		dispose(prop);
 }
 
 
@@ -663,7 +1062,7 @@ const PropList PropList::EMPTY;
  * @param out	Output to use.
  */
 void PropList::print(elm::io::Output& out) const {
-	if(!head)
+	if(!first())
 		out << "{ }";
 	else {
 		bool first = true;
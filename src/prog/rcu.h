@@ -0,0 +1,303 @@
+/*
+ *	RCURunnable class interface
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#ifndef OTAWA_PROG_RCU_H_
+#define OTAWA_PROG_RCU_H_
+
+#include "config.h"
+
+#ifdef OTAWA_CONC
+
+#include <atomic>
+#include <elm/data/List.h>
+#include <elm/data/Vector.h>
+#include <elm/sys/System.h>
+#include <elm/sys/Thread.h>
+#include <elm/util/Pair.h>
+#include <otawa/prop/PropList.h>
+
+namespace otawa {
+
+using namespace elm;
+
+#	define CONC_DEBUG(x)	//cerr << x
+
+/*
+ * Properties removed while threads are running are reclaimed using
+ * epochs. Each thread (RCURunnable) announces the global epoch it has
+ * observed when it starts running or passes a quiescent point, and
+ * announces QUIESCENT when it stops. A removed property is tagged with
+ * the global epoch at removal time and can be freed as soon as every
+ * running thread has announced a greater epoch: such a thread cannot
+ * hold a reference to the property anymore.
+ *
+ * Threads not launched by RCURunnable (like the workers of a TaskPool)
+ * take part in the reclamation by attaching an RCURunnable to themselves.
+ */
+class RCURunnable: public sys::Runnable {
+	friend class WorkSpace;
+public:
+	static const t::uint64 QUIESCENT = ~t::uint64(0);
+
+	RCURunnable(bool with_thread = true): to_run(0), local(QUIESCENT) {
+		if(with_thread)
+			sys::Thread::make(*this);
+	}
+
+	inline bool isRoot(void) const { return this == &root; }
+
+	virtual void run(void) {
+		ASSERT(to_run);
+		CONC_DEBUG("DEBUG: running " << (void *)this << " on " << (void *)to_run << io::endl);
+
+		// launch the runnable
+		self = this;
+		enter();
+		to_run->run();
+		leave();
+		self = 0;
+
+		// end launching
+		mutex->lock();
+		running.remove(this);
+		active--;
+		avail.add(this);
+		check();
+		mutex->unlock();
+	}
+
+	inline void enter(void) { local.store(epoch.load(std::memory_order_acquire), std::memory_order_release); }
+	inline void leave(void) { local.store(QUIESCENT, std::memory_order_release); }
+
+	void clean(void) {
+		for(int i = 0; i < to_free.count(); i++)
+			delete to_free[i].snd;
+		to_free.clear();
+	}
+
+	void reclaim(t::uint64 min) {
+		int j = 0;
+		for(int i = 0; i < to_free.count(); i++)
+			if(to_free[i].fst < min)
+				delete to_free[i].snd;
+			else
+				to_free[j++] = to_free[i];
+		to_free.setLength(j);
+	}
+
+	static void init(void) {
+		static bool initialized = false;
+		if(!initialized) {
+			initialized = true;
+			mutex = sys::Mutex::make();
+			core_count = sys::System::coreCount();
+		}
+	}
+
+	// must be called with mutex locked
+	static t::uint64 minimum(void) {
+		t::uint64 min = root.local.load(std::memory_order_acquire);
+		for(List<RCURunnable *>::iter i(running); i; i++) {
+			t::uint64 e = i->local.load(std::memory_order_acquire);
+			if(e < min)
+				min = e;
+		}
+		for(List<RCURunnable *>::iter i(attached); i; i++) {
+			t::uint64 e = i->local.load(std::memory_order_acquire);
+			if(e < min)
+				min = e;
+		}
+		return min;
+	}
+
+	// must be called with mutex locked
+	static void check(void) {
+		if(!running && minimum() == QUIESCENT) {
+			for(List<RCURunnable *>::iter i(avail); i; i++)
+				i->clean();
+			root.clean();
+		}
+		else
+			root.reclaim(minimum());
+	}
+
+	static void quiesce(void) {
+		if(!self)
+			return;
+		self->local.store(epoch.fetch_add(1, std::memory_order_acq_rel) + 1, std::memory_order_release);
+		mutex->lock();
+		t::uint64 min = minimum();
+		if(!self->isRoot())
+			self->reclaim(min);
+		root.reclaim(min);
+		mutex->unlock();
+	}
+
+	/**
+	 * Make the current thread, not launched by RCURunnable, take part
+	 * in the reclamation. The thread is considered as quiescent until
+	 * enter() is called.
+	 * @param r		RCURunnable (without thread) representing the current thread.
+	 */
+	static void attach(RCURunnable *r) {
+		init();
+		mutex->lock();
+		attached.add(r);
+		active++;
+		mutex->unlock();
+		self = r;
+	}
+
+	/**
+	 * Stop the reclamation for the given attached RCURunnable.
+	 * @param r		Attached RCURunnable.
+	 */
+	static void detach(RCURunnable *r) {
+		r->leave();
+		self = 0;
+		mutex->lock();
+		attached.remove(r);
+		active--;
+		for(int i = 0; i < r->to_free.count(); i++)
+			root.to_free.add(r->to_free[i]);
+		r->to_free.clear();
+		check();
+		mutex->unlock();
+	}
+
+	static void runInRoot(sys::Runnable *runnable) {
+
+		// nested run: already inside a thread
+		if(self) {
+			runnable->run();
+			return;
+		}
+
+		self = &root;
+		root.enter();
+		runnable->run();
+		root.leave();
+		self = 0;
+		mutex->lock();
+		check();
+		mutex->unlock();
+	}
+
+	static sys::Thread *run(sys::Runnable *runnable) {
+
+		// lock
+		init();
+		mutex->lock();
+
+		// look for a free thread
+		if(avail) {
+			RCURunnable *t = avail.pop();
+			running.add(t);
+			active++;
+			CONC_DEBUG("DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
+			t->to_run = runnable;
+			t->thread()->start();
+			mutex->unlock();
+			return t->thread();
+		}
+
+		// add a new one if any core is remaining
+		else if(running.count() < core_count - 1) {
+			RCURunnable *t = new RCURunnable();
+			CONC_DEBUG(cerr << "DEBUG: created " << (void *)t << io::endl);
+			running.add(t);
+			active++;
+			CONC_DEBUG(cerr << "DEBUG: " << (void *)t << " has to run " << (void *)runnable << io::endl);
+			t->to_run = runnable;
+			t->thread()->start();
+			mutex->unlock();
+			return t->thread();
+		}
+
+		// only main core remains: run in main core
+		else {
+			mutex->unlock();
+			runInRoot(runnable);
+			return 0;
+		}
+	}
+
+	static void runAll(Runnable *runnable) {
+		CONC_DEBUG("DEBUG: RCU::runAll()\n");
+
+		// count available threads
+		init();
+		mutex->lock();
+		int c = RCURunnable::core_count - running.count() - 1;
+		mutex->unlock();
+		CONC_DEBUG("DEBUG: " << c << " threads available (" << core_count << ").\n");
+
+		// run available threads
+		Vector<sys::Thread *> to_wait;
+		for(int i = 0; i < c; i++) {
+			to_wait.add(run(runnable));
+			CONC_DEBUG("DEBUG: launched thread " << (void *)to_wait.top() << io::endl);
+		}
+		runInRoot(runnable);		// root thread
+
+		// wait for end of used threads
+		for(int i = 0; i < to_wait.count(); i++)
+			if(to_wait[i]) {
+				CONC_DEBUG("DEBUG: waiting for thread " << (void *)to_wait[i] << io::endl);
+				to_wait[i]->join();
+				CONC_DEBUG("DEBUG: ended for thread " << (void *)to_wait[i] << io::endl);
+			}
+	}
+
+	static inline RCURunnable *participant(void) { return self; }
+
+	static void remove(Property *prop) {
+		if(self && !self->isRoot())
+			self->to_free.add(pair(epoch.load(std::memory_order_acquire), prop));
+		else if(!active.load(std::memory_order_acquire))
+			delete prop;
+		else {
+			mutex->lock();
+			root.to_free.add(pair(epoch.load(std::memory_order_acquire), prop));
+			mutex->unlock();
+		}
+	}
+
+private:
+	sys::Runnable *to_run;
+	Vector<Pair<t::uint64, Property *> > to_free;
+	std::atomic<t::uint64> local;
+
+	static RCURunnable root;
+	static sys::Mutex *mutex;
+	static List<RCURunnable *> avail, running, attached;
+	static int core_count;
+	static std::atomic<t::uint64> epoch;
+	static std::atomic<int> active;
+	static thread_local RCURunnable *self;
+};
+
+}	// otawa
+
+#endif	// OTAWA_CONC
+
+#endif /* OTAWA_PROG_RCU_H_ */
@@ -35,6 +35,7 @@
 #include <otawa/proc/ProcessorPlugin.h>
 #include <otawa/prog/File.h>
 #include <otawa/prog/Manager.h>
+#include <otawa/prog/Snapshot.h>
 #include <otawa/prog/WorkSpace.h>
 #include <otawa/script/Script.h>
 #include "../../include/otawa/flowfact/FlowFactLoader.h"
@@ -296,6 +297,7 @@ private:
  * @li @ref PARAM			parameter for the script interpretation
  * @li @ref ONLY_CONFIG		cause the processor to stop its work after the configuration item building (no XSLT processing)
  * @li @ref TIME_STAT		cause the script to generate computation for each executed step
+ * @li @ref SNAPSHOT_PATH		snapshot to restore, if it matches, after the platform is configured and before the steps are run
  *
  * @par Properties
  * This processor initialize the following properties before passing them
@@ -539,6 +541,14 @@ void Script::work(WorkSpace *ws) {
 		onError(script, "no script list part");
 	makeConfig(steps, props);
 
+	// restore the snapshot, if any, once the platform is known
+	sys::Path snapshot = SNAPSHOT_PATH(props);
+	if(snapshot && SnapshotLoader::matches(ws, snapshot, TASK_ADDRESS(props), props)) {
+		if(logFor(LOG_DEPS))
+			log << "\trestoring snapshot from " << snapshot << io::endl;
+		ws->run<SnapshotLoader>(props);
+	}
+
 	// execute the script
 	sys::StopWatch sw;
 	for(int i = 0; i < steps->getChildCount(); i++) {
@@ -25,6 +25,10 @@
 #	define HAI_DEBUG
 #endif
 
+#include "config.h"
+#ifdef OTAWA_CONC
+#	include <mutex>
+#endif
 #include <otawa/dfa/State.h>
 #include <otawa/hard/Platform.h>
 #include <otawa/hard/Register.h>
@@ -49,6 +53,8 @@ using namespace otawa::dfa::hai;
 #define TRACES(t)	//t
 #define TRACED(t)	//t
 
+#include "StackState.h"
+
 namespace otawa {
 
 /**
@@ -399,204 +405,85 @@ const Value& Value::none	= bot,	/** undefined value */
 			Value::all 		= top;	/** any value */
 
 
-class State {
+/*
+ * Implementation of the state node arena (see StackState.h).
+ */
+template <class T>
+class ArenaImpl {
 public:
+	typedef union cell_t {
+		cell_t *next;
+		alignas(T) char data[sizeof(T)];
+	} cell_t;
+	static const int chunk_size = 256;
+	typedef struct chunk_t {
+		chunk_t *next;
+		cell_t cells[chunk_size];
+	} chunk_t;
+
+	static cell_t *free_list;
+	static chunk_t *chunks;
+	static int live;
+#	ifdef OTAWA_CONC
+		static std::mutex mutex;
+#	endif
+};
+template <class T> typename ArenaImpl<T>::cell_t *ArenaImpl<T>::free_list = nullptr;
+template <class T> typename ArenaImpl<T>::chunk_t *ArenaImpl<T>::chunks = nullptr;
+template <class T> int ArenaImpl<T>::live = 0;
+#ifdef OTAWA_CONC
+	template <class T> std::mutex ArenaImpl<T>::mutex;
+#	define ARENA_LOCK	std::lock_guard<std::mutex> lock(A::mutex)
+#else
+#	define ARENA_LOCK
+#endif
 
-	class Node {
-	public:
-		friend class State;
-		inline Node(void): next(0), addr(Value::none) { }
-		inline Node(const Value& address, const Value& value)
-			: next(0), addr(address), val(value) { }
-		inline Node(const Node *node)
-			: next(0), addr(node->addr), val(node->val) { }
-	private:
-		Node *next;
-		Value addr;
-		Value val;
-	};
-
-	State(const Value& def = Value::all): first(Value::none, def)
-		{ TRACED(cerr << "State(" << def << ")\n"); }
-	State(const State& state): first(Value::none, Value::all)
-		{ TRACED(cerr << "State("; state.print(cerr); cerr << ")\n"); copy(state); }
-	~State(void) { clear(); }
-
-	inline bool isBot(void) const { return first.addr == Value::none; }
-	inline State& operator=(const State& state) { copy(state); return *this; }
-
-	void copy(const State& state) {
-		TRACED(cerr << "copy("; print(cerr); cerr << ", "; state.print(cerr); cerr << ") = ");
-		clear();
-		first = state.first;
-		for(Node *prev = &first, *cur = state.first.next; cur; cur = cur->next) {
-			prev->next = new Node(cur);
-			prev = prev->next;
-		}
-		TRACED(print(cerr); cerr << io::endl);
-	}
-
-	void clear(void) {
-		for(Node *cur = first.next, *next;
-		cur;
-		cur = next) {
-			next = cur->next;
-			delete cur;
-		}
-		first.next = 0;
-	}
-
-	void set(const Value& addr, const Value& val) {
-		TRACED(cerr << "set("; print(cerr); cerr << ", " << addr << ", " << val << ") = ");
-		Node *prev, *cur, *next;
-		if(first.val == Value::none) {
-			TRACED(print(cerr); cerr << io::endl);
-			return;
-		}
-
-		// consum all memory references
-		if(addr.kind() == ALL) {
-			for(prev = &first, cur = first.next; cur && cur->addr.kind() <= SP; prev = cur, cur = cur->next) ;
-			while(cur) {
-				next = cur->next;
-				delete cur;
-				cur = next;
-			}
-			prev->next = 0;
-		}
-
-		// find a value
-		else {
-			for(prev = &first, cur = first.next; cur && cur->addr < addr; prev = cur, cur = cur->next);
-			if(cur && cur->addr == addr) {
-				if(val.kind() != ALL)
-					cur->val = val;
-				else {
-					prev->next = cur->next;
-					delete cur;
-				}
-			}
-			else if(val.kind() != ALL) {
-				next = new Node(addr, val);
-				prev->next = next;
-				prev->next->next = cur;
-			}
-		}
-
-		TRACED(print(cerr); cerr << io::endl);
-	}
-
-	bool equals(const State& state) const {
-		if(first.val.kind() != state.first.val.kind())
-			return false;
-		Node *cur = first.next, *cur2 = state.first.next;
-		while(cur && cur2) {
-			if(cur->addr != cur2->addr)
-				return false;
-			if(cur->val != cur->val)
-				return false;
-			cur = cur->next;
-			cur2 = cur2->next;
-		}
-		return cur == cur2;
-	}
-
-	void join(const State& state) {
-		TRACED(cerr << "join(\n\t"; print(cerr); cerr << ",\n\t";  state.print(cerr); cerr << "\n\t) = ");
-
-		// test none states
-		if(state.first.val == Value::none)
-			return;
-		if(first.val == Value::none) {
-			copy(state);
-			TRACED(print(cerr); cerr << io::endl;);
-			return;
-		}
-
-		Node *prev = &first, *cur = first.next, *cur2 = state.first.next, *next;
-		while(cur && cur2) {
-
-			// addr1 < addr2 -> remove cur1
-			if(cur->addr < cur2->addr) {
-				prev->next = cur->next;
-				delete cur;
-				cur = prev->next;
-			}
-
-			// equality ? remove if join result in all
-			else if(cur->addr == cur2->addr) {
-				cur->val.join(cur2->val);
-				if(cur->val.kind() == ALL) {
-					prev->next = cur->next;
-					delete cur;
-					cur = prev->next;
-				}
-				else {
-					prev = cur;
-					cur = cur->next;
-					cur2 = cur2->next;
-				}
-			}
-
-			// addr1 > addr2 => remove cur2
-			else
-				cur2 = cur2->next;
-		}
-
-		// remove tail
-		prev->next = 0;
-		while(cur) {
-			next = cur->next;
-			delete cur;
-			cur = next;
-		}
-		TRACED(print(cerr); cerr << io::endl;);
-	}
-
-	void print(io::Output& out) const {
-		if(first.val == Value::none)
-			out << '_';
-		else {
-			bool f =  true;
-			out << "{ ";
-			for(Node *cur = first.next; cur; cur = cur->next) {
-				if(f)
-					f = false;
-				else
-					out << ", ";
-				out << cur->addr << " = " << cur->val;
-			}
-			out << " }";
+template <class T>
+void *Arena<T>::allocate(void) {
+	typedef ArenaImpl<T> A;
+	ARENA_LOCK;
+	if(!A::free_list) {
+		typename A::chunk_t *chunk = new typename A::chunk_t;
+		chunk->next = A::chunks;
+		A::chunks = chunk;
+		for(int i = 0; i < A::chunk_size; i++) {
+			chunk->cells[i].next = A::free_list;
+			A::free_list = &chunk->cells[i];
 		}
 	}
+	typename A::cell_t *cell = A::free_list;
+	A::free_list = cell->next;
+	A::live++;
+	return cell;
+}
 
-	Value fromImage(const Address& addr, Process *proc, int size) const {
-		switch(size) {
-		case 1: { t::uint8 v; proc->get(addr, v); return Value(CST, v); }
-		case 2: { t::uint16 v; proc->get(addr, v); return Value(CST, v); }
-		case 4: { t::uint32 v; proc->get(addr, v); return Value(CST, v); }
+template <class T>
+void Arena<T>::release(void *p) {
+	typedef ArenaImpl<T> A;
+	ARENA_LOCK;
+	typename A::cell_t *cell = static_cast<typename A::cell_t *>(p);
+	cell->next = A::free_list;
+	A::free_list = cell;
+	A::live--;
+	if(!A::live) {
+		while(A::chunks) {
+			typename A::chunk_t *next = A::chunks->next;
+			delete A::chunks;
+			A::chunks = next;
 		}
-		return first.val;
+		A::free_list = nullptr;
 	}
+}
 
-	Value get(const Value& addr, Process *proc, int size) const {
-		Node * cur;
-		for(cur = first.next; cur && cur->addr < addr; cur = cur->next) ;
-		if(cur && cur->addr == addr)
-			return cur->val;
-		if(addr.kind() == CST)
-			for(Process::FileIter file(proc); file(); file++)
-				for(File::SegIter seg(*file); seg(); seg++)
-					if(seg->contains(addr.value()))
-						return fromImage(addr.value(), proc, size);
-		return first.val;
-	}
+template <class T>
+int Arena<T>::count(void) {
+	typedef ArenaImpl<T> A;
+	ARENA_LOCK;
+	return A::live;
+}
 
-	static const State EMPTY, FULL;
+template class Arena<State::Node>;
 
-private:
-	Node first;
-};
 const State State::EMPTY(Value::none), State::FULL(Value::all);
 io::Output& operator<<(io::Output& out, const State& state) { state.print(out); return out; }
 
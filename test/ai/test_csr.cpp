@@ -0,0 +1,179 @@
+/*
+ *	Test of CSRGraph against CompositeCFG
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <elm/sys/System.h>
+#include <otawa/ai/ArrayStore.h>
+#include <otawa/ai/CSRGraph.h>
+#include <otawa/ai/SimpleAI.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/CompositeCFG.h>
+#include <otawa/cfg/features.h>
+#include <otawa/dfa/BitSet.h>
+
+using namespace elm;
+using namespace otawa;
+
+// set of the blocks that may be executed before (and including) a block
+class ReachDomain {
+public:
+	typedef dfa::BitSet t;
+	ReachDomain(int n, Block *entry): _bot(n), _init(n) { _init.add(entry->id()); }
+	inline const t& bot(void) const { return _bot; }
+	inline const t& init(void) const { return _init; }
+	inline t join(const t& a, const t& b) const { return a.doUnion(b); }
+	inline bool equals(const t& a, const t& b) const { return a.equals(b); }
+	inline void copy(t& d, const t& s) const { d = s; }
+private:
+	t _bot, _init;
+};
+
+template <class G>
+class ReachAdapter {
+public:
+	typedef ReachDomain domain_t;
+	typedef typename domain_t::t t;
+	typedef G graph_t;
+	typedef ai::ArrayStore<domain_t, graph_t> store_t;
+
+	ReachAdapter(const CFGCollection& coll, G& graph):
+		_domain(coll.countBlocks(), coll.entry()->entry()),
+		_graph(graph),
+		_store(_domain, _graph) { }
+
+	inline domain_t& domain(void) { return _domain; }
+	inline graph_t& graph(void) { return _graph; }
+	inline store_t& store(void) { return _store; }
+
+	void update(Block *v, t& d) {
+		_domain.copy(d, _domain.bot());
+		for(auto e = _graph.preds(v); e(); e++)
+			d.add(_store.get(*e));
+		d.add(v->id());
+	}
+
+private:
+	domain_t _domain;
+	graph_t& _graph;
+	store_t _store;
+};
+
+class CSRTest: public Application {
+public:
+	CSRTest(void): Application(Make("test_csr")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		CompositeCFG g(coll);
+		ai::CSRGraph csr(coll);
+		cout << csr.count() << " blocks, " << csr.countArcs() << " arcs\n";
+
+		checkArcs(coll, g, csr);
+		checkInverse(csr);
+
+		// same analysis on both graphs
+		ReachAdapter<CompositeCFG> ref(coll, g);
+		ai::SimpleAI<ReachAdapter<CompositeCFG> > ref_ai(ref);
+		ref_ai.run();
+		ReachAdapter<ai::CSRGraph> ada(coll, csr);
+		ai::SimpleAI<ReachAdapter<ai::CSRGraph> > ada_ai(ada);
+		ada_ai.run();
+		for(auto v: coll.blocks())
+			if(csr.isReached(v) && !ref.domain().equals(ref.store().get(v), ada.store().get(v)))
+				error(_ << "state at " << v << " differs from CompositeCFG");
+
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	// arcs of CSRGraph are the edges of CompositeCFG::preds() for the reached blocks
+	void checkArcs(const CFGCollection& coll, CompositeCFG& g, ai::CSRGraph& csr) {
+		for(auto v: coll.blocks()) {
+			if(csr.vertex(csr.index(v)) != v)
+				error(_ << "bad vertex index for " << v);
+			Vector<Edge *> es;
+			if(csr.isReached(v))
+				for(auto e = g.preds(v); e(); e++)
+					es.add(*e);
+			for(auto a = csr.preds(v); a(); a++) {
+				int i = es.indexOf(a->edge());
+				if(i < 0)
+					error(_ << "arc " << a->edge() << " is not a predecessor of " << v << " in CompositeCFG");
+				else
+					es.removeAt(i);
+				if(a->source() != g.sourceOf(a->edge()))
+					error(_ << "bad source for arc " << a->edge());
+				if(a->isCall() != g.isCall(a->edge()) || a->isReturn() != g.isReturn(a->edge()))
+					error(_ << "bad call/return flags for arc " << a->edge());
+			}
+			for(auto e: es)
+				error(_ << "edge " << e << " missing in the predecessors of " << v);
+		}
+	}
+
+	// succs() and preds() are inverse of each other
+	void checkInverse(ai::CSRGraph& csr) {
+		int succ_cnt = 0, pred_cnt = 0;
+		for(ai::CSRGraph::Iterator v(csr); v(); v++) {
+			for(auto a = csr.succs(*v); a(); a++) {
+				succ_cnt++;
+				if(csr.sourceOf(*a) != *v)
+					error(_ << "successor arc " << csr.index(*a) << " of " << *v << " has another source");
+				if(!contains(csr.preds(csr.sinkOf(*a)), *a))
+					error(_ << "successor arc " << csr.index(*a) << " of " << *v << " not in the predecessors of its sink");
+			}
+			for(auto a = csr.preds(*v); a(); a++) {
+				pred_cnt++;
+				if(csr.sinkOf(*a) != *v)
+					error(_ << "predecessor arc " << csr.index(*a) << " of " << *v << " has another sink");
+				if(!contains(csr.succs(csr.sourceOf(*a)), *a))
+					error(_ << "predecessor arc " << csr.index(*a) << " of " << *v << " not in the successors of its source");
+			}
+		}
+		if(succ_cnt != csr.countArcs() || pred_cnt != csr.countArcs())
+			error(_ << succ_cnt << " successors and " << pred_cnt << " predecessors for " << csr.countArcs() << " arcs");
+	}
+
+	template <class I>
+	static bool contains(I i, ai::CSRGraph::edge_t a) {
+		for(; i(); i++)
+			if(*i == a)
+				return true;
+		return false;
+	}
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	int errors;
+};
+
+OTAWA_RUN(CSRTest);
@@ -0,0 +1,127 @@
+/*
+ *	Test of the HalfAbsInt scheduling against the previous plain order
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/dfa/BitSet.h>
+#include <otawa/dfa/hai/HalfAbsInt.h>
+#include <otawa/dfa/hai/DefaultFixPoint.h>
+#include <otawa/dfa/hai/DefaultListener.h>
+
+using namespace elm;
+using namespace otawa;
+using namespace otawa::dfa::hai;
+
+// set of the blocks that may be executed before (and including) a block
+class ReachProblem {
+public:
+	typedef dfa::BitSet Domain;
+	typedef ReachProblem Problem;
+
+	ReachProblem(int n): _bot(n) { }
+	inline Problem& getProb(void) { return *this; }
+
+	inline const Domain& top(void) const { return _bot; }
+	inline const Domain& bottom(void) const { return _bot; }
+	inline const Domain& entry(void) const { return _bot; }
+	inline void lub(Domain &a, const Domain &b) const { a.add(b); }
+	inline void assign(Domain &a, const Domain &b) const { a = b; }
+	inline bool equals(const Domain &a, const Domain &b) const { return a.equals(b); }
+	inline void update(Domain& out, const Domain& in, Block* bb) { out = in; out.add(bb->id()); }
+	inline void enterContext(Domain &dom, Block *header, hai_context_t ctx) { }
+	inline void leaveContext(Domain &dom, Block *header, hai_context_t ctx) { }
+
+private:
+	Domain _bot;
+};
+
+typedef DefaultListener<ReachProblem> ReachListener;
+typedef DefaultFixPoint<ReachListener> ReachFP;
+typedef HalfAbsInt<ReachFP> ReachAI;
+
+class HAITest: public Application {
+public:
+	HAITest(void): Application(Make("test_hai")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		require(LOOP_INFO_FEATURE);
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		ReachProblem prob(coll.countBlocks());
+
+		// same analysis with both orders
+		ReachListener old_list(workspace(), prob), new_list(workspace(), prob);
+		ReachFP old_fp(old_list), new_fp(new_list);
+		ReachAI old_ai(old_fp, *workspace(), false), new_ai(new_fp, *workspace());
+		int old_cnt = old_ai.solve(), new_cnt = new_ai.solve();
+		cout << "plain order: " << old_cnt << " iterations, ordered: " << new_cnt << " iterations\n";
+
+		// same fixpoint
+		for(auto g: coll)
+			for(auto v: *g)
+				if(!prob.equals(*old_list.results[g->index()][v->index()], *new_list.results[g->index()][v->index()]))
+					error(_ << "state at " << v << " differs from the plain order");
+
+		// statistics
+		check("plain order", old_ai, old_cnt);
+		check("ordered", new_ai, new_cnt);
+
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	void check(cstring what, const ReachAI& ai, int cnt) {
+		if(ai.iterations() != cnt)
+			error(_ << what << ": " << ai.iterations() << " iterations recorded for " << cnt);
+		int visits = 0;
+		for(HashMap<Block *, int>::PairIter v(ai.headerVisits()); v(); v++) {
+			Block *h = (*v).fst;
+			int n = (*v).snd;
+			if(!LOOP_HEADER(h))
+				error(_ << what << ": " << h << " recorded as a loop header");
+			// at least the first iteration and the iteration reaching the fixpoint
+			if(n < 2)
+				error(_ << what << ": " << n << " visit(s) of header " << h);
+			if(ai.headerVisits(h) != n)
+				error(_ << what << ": inconsistent visits of header " << h);
+			visits += n;
+		}
+		if(visits > cnt)
+			error(_ << what << ": " << visits << " header visits for " << cnt << " iterations");
+	}
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	int errors;
+};
+
+OTAWA_RUN(HAITest);
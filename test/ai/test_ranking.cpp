@@ -0,0 +1,129 @@
+/*
+ *	Test of the RankingAI work lists against SimpleAI
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/sys/System.h>
+#include <otawa/ai/ArrayStore.h>
+#include <otawa/ai/RankingAI.h>
+#include <otawa/ai/SimpleAI.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/CompositeCFG.h>
+#include <otawa/cfg/features.h>
+#include <otawa/dfa/BitSet.h>
+
+using namespace elm;
+using namespace otawa;
+
+// set of the blocks that may be executed before (and including) a block
+class ReachDomain {
+public:
+	typedef dfa::BitSet t;
+	ReachDomain(int n, Block *entry): _bot(n), _init(n) { _init.add(entry->id()); }
+	inline const t& bot(void) const { return _bot; }
+	inline const t& init(void) const { return _init; }
+	inline t join(const t& a, const t& b) const { return a.doUnion(b); }
+	inline bool equals(const t& a, const t& b) const { return a.equals(b); }
+	inline void copy(t& d, const t& s) const { d = s; }
+private:
+	t _bot, _init;
+};
+
+template <class G>
+class ReachAdapter {
+public:
+	typedef ReachDomain domain_t;
+	typedef typename domain_t::t t;
+	typedef G graph_t;
+	typedef ai::ArrayStore<domain_t, graph_t> store_t;
+
+	ReachAdapter(const CFGCollection& coll, G& graph):
+		_domain(coll.countBlocks(), coll.entry()->entry()),
+		_graph(graph),
+		_store(_domain, _graph) { }
+
+	inline domain_t& domain(void) { return _domain; }
+	inline graph_t& graph(void) { return _graph; }
+	inline store_t& store(void) { return _store; }
+
+	void update(Block *v, t& d) {
+		_domain.copy(d, _domain.bot());
+		for(auto e = _graph.preds(v); e(); e++)
+			d.add(_store.get(*e));
+		d.add(v->id());
+	}
+
+private:
+	domain_t _domain;
+	graph_t& _graph;
+	store_t _store;
+};
+
+class RankingTest: public Application {
+public:
+	RankingTest(void): Application(Make("test_ranking")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		require(ai::RANKING_FEATURE);
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		CompositeCFG g(coll);
+
+		// reference
+		ReachAdapter<CompositeCFG> ref(coll, g);
+		ai::SimpleAI<ReachAdapter<CompositeCFG> > simple(ref);
+		simple.run();
+
+		// ranking work lists
+		typedef ReachAdapter<CompositeCFG> adapter_t;
+		check<ai::RankingAI<adapter_t, ai::PropertyRanking, ai::SortedWorkList<CompositeCFG> > >("sorted", coll, g, ref, true);
+		check<ai::RankingAI<adapter_t, ai::PropertyRanking, ai::HeapWorkList<CompositeCFG> > >("heap", coll, g, ref, true);
+		check<ai::RankingAI<adapter_t, ai::PropertyRanking, ai::BucketWorkList<CompositeCFG> > >("bucket", coll, g, ref, true);
+		check<ai::RankingAI<adapter_t, ai::PropertyRanking, ai::HeapWorkList<CompositeCFG> > >("heap (no dedup)", coll, g, ref, false);
+
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	template <class AI>
+	void check(cstring name, const CFGCollection& coll, CompositeCFG& g, ReachAdapter<CompositeCFG>& ref, bool dedup) {
+		ReachAdapter<CompositeCFG> ada(coll, g);
+		AI ana(ada, single<ai::PropertyRanking>(), dedup);
+		ana.run();
+		cout << name << ": " << ana.visits() << " visits\n";
+
+		// the exit is not computed by SimpleAI and is not compared
+		for(auto v: coll.blocks())
+			if(v != g.exit() && !ref.domain().equals(ref.store().get(v), ada.store().get(v))) {
+				cerr << "ERROR: " << name << " differs from SimpleAI at " << v << io::endl;
+				errors++;
+			}
+	}
+
+	int errors;
+};
+
+OTAWA_RUN(RankingTest);
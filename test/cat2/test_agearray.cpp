@@ -0,0 +1,114 @@
+/*
+ *	Unit test of the copy-on-write age arrays of the CAT2 analyses
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <thread>
+#include <elm/test.h>
+#include <otawa/cache/cat2/AgeArray.h>
+
+using namespace elm;
+using namespace otawa::cache;
+
+static const int SIZE = 16;
+
+// copies must not see the writes made through the original and conversely
+static void checkCopy(AgePool *pool) {
+	AgeArray a(SIZE, -1, pool);
+	AgeArray b(a);
+	CHECK(a.shares(b));
+
+	a.set(3, 2);
+	CHECK(!a.shares(b));
+	CHECK_EQUAL(a[3], 2);
+	CHECK_EQUAL(b[3], -1);
+
+	AgeArray c(SIZE, 0, pool);
+	c = b;
+	CHECK(c.shares(b));
+	b.write()[5] = 1;
+	CHECK_EQUAL(b[5], 1);
+	CHECK_EQUAL(c[5], -1);
+
+	c.fill(3);
+	for(int i = 0; i < SIZE; i++)
+		CHECK_EQUAL(c[i], 3);
+	CHECK_EQUAL(b[0], -1);
+	CHECK_EQUAL(a[0], -1);
+
+	// unchanged age does not copy the storage
+	AgeArray d(a);
+	d.set(3, 2);
+	CHECK(d.shares(a));
+	CHECK(d.equals(a));
+}
+
+// copies and writes of arrays sharing the same storage from several threads
+static void hammer(const AgeArray *ref, int id, bool *ok) {
+	for(int n = 0; n < 2000; n++) {
+		AgeArray a(*ref);
+		a.set(id, n % 7);
+		AgeArray b(a);
+		if(a[id] != n % 7 || (*ref)[id] != -1 || !b.shares(a))
+			*ok = false;
+	}
+}
+
+int main(void) {
+CHECK_BEGIN("AgeArray")
+
+	// heap storage
+	checkCopy(nullptr);
+
+	// pool storage, the pool outliving its creator lock
+	AgePool *pool = new AgePool(SIZE);
+	checkCopy(pool);
+	{
+		AgeArray kept(SIZE, 1, pool);
+		pool->unlock();
+		AgeArray copy(kept);
+		copy.set(0, 2);
+		CHECK_EQUAL(kept[0], 1);
+		CHECK_EQUAL(copy[0], 2);
+	}
+
+	// concurrent copies of a shared storage
+	{
+		pool = new AgePool(SIZE);
+		AgeArray ref(SIZE, -1, pool);
+		pool->unlock();
+		static const int THREADS = 4;
+		bool ok[THREADS];
+		std::thread *ts[THREADS];
+		for(int i = 0; i < THREADS; i++) {
+			ok[i] = true;
+			ts[i] = new std::thread(hammer, &ref, i, &ok[i]);
+		}
+		for(int i = 0; i < THREADS; i++) {
+			ts[i]->join();
+			delete ts[i];
+			CHECK(ok[i]);
+		}
+		for(int i = 0; i < SIZE; i++)
+			CHECK_EQUAL(ref[i], -1);
+	}
+
+CHECK_END
+}
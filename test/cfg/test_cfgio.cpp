@@ -0,0 +1,141 @@
+/*
+ *	Test of the binary format of cfgio against the original CFGs and the XML format
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/cfgio/features.h>
+#include <otawa/cfgio/Output.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+class CFGIOTest: public Application {
+public:
+	CFGIOTest(void): Application(Make("test_cfgio")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		require(COLLECTED_CFG_FEATURE);
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		sys::Path bin_path("test_cfgio.cfgb"), xml_path("test_cfgio.xml");
+
+		// write the CFGs in both formats
+		PropList bprops(props);
+		cfgio::OUTPUT(bprops) = bin_path;
+		cfgio::BINARY(bprops) = true;
+		workspace()->run<cfgio::Output>(bprops);
+		PropList xprops(props);
+		cfgio::OUTPUT(xprops) = xml_path;
+		workspace()->run<cfgio::Output>(xprops);
+
+		// read them back
+		WorkSpace bws(workspace()), xws(workspace());
+		const CFGCollection& bcoll = read(bws, props, bin_path);
+		const CFGCollection& xcoll = read(xws, props, xml_path);
+		cout << coll.count() << " CFGs, " << coll.countBlocks() << " blocks\n";
+
+		// edge flags are not recorded in XML: only compared with the original
+		compare("binary/original", coll, bcoll, true);
+		compare("binary/XML", xcoll, bcoll, false);
+
+		bin_path.remove();
+		xml_path.remove();
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	const CFGCollection& read(WorkSpace& ws, const PropList& props, const sys::Path& path) {
+		PropList iprops(props);
+		cfgio::FROM(iprops) = path;
+		ws.require(cfgio::CFG_FILE_INPUT_FEATURE, iprops);
+		return **INVOLVED_CFGS(ws);
+	}
+
+	void compare(cstring what, const CFGCollection& ref, const CFGCollection& coll, bool flags) {
+		if(ref.count() != coll.count()) {
+			error(_ << what << ": " << coll.count() << " CFGs instead of " << ref.count());
+			return;
+		}
+		for(int i = 0; i < ref.count(); i++) {
+			CFG *rg = ref[i], *g = coll[i];
+			if(rg->address() != g->address())
+				error(_ << what << ": CFG " << i << " at " << g->address() << " instead of " << rg->address());
+			if(rg->count() != g->count()) {
+				error(_ << what << ": " << g->count() << " blocks in " << g << " instead of " << rg->count());
+				continue;
+			}
+			for(int j = 0; j < rg->count(); j++)
+				compare(what, rg->at(j), g->at(j), flags);
+		}
+	}
+
+	void compare(cstring what, Block *rv, Block *v, bool flags) {
+
+		// kind and content
+		if(rv->isEntry() != v->isEntry() || rv->isExit() != v->isExit() || rv->isUnknown() != v->isUnknown()
+		|| rv->isPhony() != v->isPhony() || rv->isBasic() != v->isBasic() || rv->isSynth() != v->isSynth()) {
+			error(_ << what << ": bad kind for " << v << " (" << rv << ")");
+			return;
+		}
+		if(rv->isBasic()
+		&& (rv->toBasic()->address() != v->toBasic()->address() || rv->toBasic()->size() != v->toBasic()->size()))
+			error(_ << what << ": " << v << " covers " << v->toBasic()->address() << ":" << v->toBasic()->size()
+				<< " instead of " << rv->toBasic()->address() << ":" << rv->toBasic()->size());
+		if(rv->isSynth()) {
+			CFG *rc = rv->toSynth()->callee(), *c = v->toSynth()->callee();
+			if((rc == nullptr) != (c == nullptr) || (rc != nullptr && rc->index() != c->index()))
+				error(_ << what << ": bad callee for " << v);
+		}
+
+		// output edges
+		if(rv->countOuts() != v->countOuts()) {
+			error(_ << what << ": " << v->countOuts() << " edges from " << v << " instead of " << rv->countOuts());
+			return;
+		}
+		for(auto re: rv->outEdges()) {
+			bool found = false;
+			for(auto e: v->outEdges())
+				if(e->sink()->index() == re->sink()->index() && (!flags || e->flags() == re->flags())) {
+					found = true;
+					break;
+				}
+			if(!found)
+				error(_ << what << ": edge " << re << " (flags " << io::hex(re->flags()) << ") not found");
+		}
+	}
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	int errors;
+};
+
+OTAWA_RUN(CFGIOTest);
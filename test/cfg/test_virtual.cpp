@@ -0,0 +1,135 @@
+/*
+ *	Test of the sharing mode of the Virtualizer against the copying mode
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/cfg/Virtualizer.h>
+#include <otawa/flowfact/features.h>
+#include <otawa/ipet/features.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+class VirtualTest: public Application {
+public:
+	VirtualTest(void): Application(Make("test_virtual")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+
+		// copying mode: one CFG per context, marked with its path
+		require(VIRTUALIZED_CFG_FEATURE);
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+		Vector<string> copies;
+		for(auto g: coll)
+			copies.add(key(g, CONTEXT(g)));
+		cout << "copying: " << coll.count() << " CFGs\n";
+
+		// sharing mode: one CFG per function, one context per copy
+		PropList sprops(props);
+		VIRTUAL_SHARING(sprops) = true;
+		WorkSpace ws(workspace());
+		ws.require(VIRTUALIZED_CFG_FEATURE, sprops);
+		const CFGCollection& scoll = **INVOLVED_CFGS(ws);
+		int cnt = 0;
+		for(auto g: scoll) {
+			if(VIRTUAL_CONTEXTS(g) == nullptr)
+				error(_ << "no context for " << g);
+			for(auto ctx = VIRTUAL_CONTEXTS(g); ctx != nullptr; ctx = ctx->next()) {
+				cnt++;
+				if(ctx->cfg() != g)
+					error(_ << "context " << ctx << " hooked to " << g);
+				string k = key(g, ctx->path());
+				int i = copies.indexOf(k);
+				if(i < 0)
+					error(_ << "context " << ctx << " (" << ctx->path() << ") has no copy");
+				else
+					copies.removeAt(i);
+			}
+		}
+		cout << "sharing: " << scoll.count() << " CFGs, " << cnt << " contexts\n";
+
+		// checks
+		if(cnt != coll.count())
+			error(_ << cnt << " contexts for " << coll.count() << " copied CFGs");
+		if(scoll.count() > coll.count())
+			error("the sharing mode builds more CFGs than the copying mode");
+		for(auto k: copies)
+			error(_ << "copy " << k << " has no context");
+
+		// contextual loop bounds: recorded on the contexts, loosest one on the shared header
+		ws.require(EXTENDED_LOOP_FEATURE, sprops);
+		int bound = 1;
+		for(auto g: scoll)
+			for(CFG::BlockIter v = g->blocks(); v(); v++)
+				if(LOOP_HEADER(*v) && v->isBasic())
+					for(auto ctx = VIRTUAL_CONTEXTS(g); ctx != nullptr; ctx = ctx->next())
+						pathOf(ctx).ref(MAX_ITERATION, v->toBasic()->first()) = bound++;
+		cout << "sharing: " << (bound - 1) << " contextual loop bounds\n";
+		ws.require(ipet::FLOW_FACTS_FEATURE, sprops);
+		bound = 1;
+		for(auto g: scoll)
+			for(CFG::BlockIter v = g->blocks(); v(); v++)
+				if(LOOP_HEADER(*v) && v->isBasic()) {
+					int max = 0;
+					for(auto ctx = VIRTUAL_CONTEXTS(g); ctx != nullptr; ctx = ctx->next()) {
+						if(MAX_ITERATION(ctx->propsOf(*v)) != bound)
+							error(_ << "bound " << MAX_ITERATION(ctx->propsOf(*v)) << " instead of " << bound
+								<< " for " << *v << " in " << ctx);
+						max = bound++;
+					}
+					if(MAX_ITERATION(*v) != max)
+						error(_ << "shared bound " << MAX_ITERATION(*v) << " instead of " << max << " for " << *v);
+				}
+
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	// path used by the loop bound lookup in the CFG of a context
+	static ContextualPath pathOf(VirtualContext *ctx) {
+		ContextualPath p = ctx->path();
+		p.push(ContextualStep::FUNCTION, ctx->cfg()->address());
+		return p;
+	}
+
+	static string key(CFG *g, const ContextualPath& path) {
+		return _ << g->address() << ":" << path;
+	}
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	int errors;
+};
+
+OTAWA_RUN(VirtualTest);
@@ -0,0 +1,92 @@
+/*
+ *	Load-time benchmark of lazy and eager instruction decoding
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/io.h>
+#include <elm/sys/StopWatch.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/program.h>
+
+using namespace elm;
+using namespace otawa;
+
+// look up all instructions of the executable segments as the CFG builder would
+static void sweep(WorkSpace *ws, Vector<Address>& addrs) {
+	Process *proc = ws->process();
+	int size = proc->instSize();
+	for(auto f: proc->files())
+		for(auto s: f->segments())
+			if(s->isExecutable())
+				for(Address a = s->address(); a < s->topAddress();) {
+					Inst *i = proc->findInstAt(a);
+					if(i == nullptr || i->size() == 0)
+						a = a + t::uint32(size ? size : 1);
+					else {
+						addrs.add(i->address());
+						a = i->topAddress();
+					}
+				}
+}
+
+// load and sweep the binary, return the time in microseconds
+static t::int64 run(const string& path, bool eager, Vector<Address>& addrs) {
+	sys::StopWatch watch;
+	watch.start();
+	PropList props;
+	PREDECODE(props) = eager;
+	WorkSpace *ws = MANAGER.load(path, props);
+	sweep(ws, addrs);
+	watch.stop();
+	delete ws;
+	return watch.delay().micros();
+}
+
+int main(int argc, char **argv) {
+	bool ok = true;
+	for(int i = 1; i < argc; i++) {
+		try {
+			Vector<Address> lazy_addrs, eager_addrs;
+			t::int64 lazy = run(argv[i], false, lazy_addrs);
+			t::int64 eager = run(argv[i], true, eager_addrs);
+			cout << argv[i] << ": " << lazy_addrs.count() << " instructions, lazy "
+				 << lazy << "us, eager " << eager << "us\n";
+			if(lazy_addrs.count() != eager_addrs.count()) {
+				cerr << "ERROR: " << lazy_addrs.count() << " instructions found in lazy mode, "
+					 << eager_addrs.count() << " in eager mode\n";
+				ok = false;
+			}
+			else
+				for(int j = 0; j < lazy_addrs.count(); j++)
+					if(lazy_addrs[j] != eager_addrs[j]) {
+						cerr << "ERROR: instruction at " << lazy_addrs[j] << " in lazy mode, at "
+							 << eager_addrs[j] << " in eager mode\n";
+						ok = false;
+						break;
+					}
+		}
+		catch(otawa::Exception& e) {
+			cerr << "ERROR: " << e.message() << io::endl;
+			ok = false;
+		}
+	}
+	return ok ? 0 : 1;
+}
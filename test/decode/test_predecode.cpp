@@ -0,0 +1,109 @@
+/*
+ *	Test of the instruction look-up at real addresses after pre-decoding
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/data/Vector.h>
+#include <elm/io.h>
+#include <elm/util/Pair.h>
+#include <otawa/cfg/features.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/prog/Process.h>
+#include <otawa/prog/WorkSpace.h>
+#include <otawa/program.h>
+
+using namespace elm;
+using namespace otawa;
+
+static int errors = 0;
+
+static void error(const string& msg) {
+	cerr << "ERROR: " << msg << io::endl;
+	errors++;
+}
+
+// collect the instructions of the CFGs built from a lazily decoded binary
+static void collect(const string& path, Vector<Pair<Address, int> >& insts) {
+	PropList props;
+	PREDECODE(props) = false;
+	TASK_ENTRY(props) = "main";
+	WorkSpace *ws = MANAGER.load(path, props);
+	ws->require(COLLECTED_CFG_FEATURE, props);
+	for(auto v: (*INVOLVED_CFGS(ws))->blocks())
+		if(v->isBasic())
+			for(BasicBlock::InstIter i = v->toBasic()->insts(); i; i++)
+				insts.add(pair(i->address(), int(i->size())));
+	delete ws;
+}
+
+// look up the real instructions in a pre-decoded binary
+static void check(const string& path, const Vector<Pair<Address, int> >& insts) {
+	PropList props;
+	PREDECODE(props) = true;
+	WorkSpace *ws = MANAGER.load(path, props);
+	Process *proc = ws->process();
+
+	// in reverse order to decode on demand after the sweep
+	for(int j = insts.count() - 1; j >= 0; j--) {
+		Address a = insts[j].fst;
+		try {
+			Inst *i = proc->findInstAt(a);
+			if(i == nullptr)
+				error(_ << "no instruction at " << a);
+			else if(i->address() != a || int(i->size()) != insts[j].snd)
+				error(_ << "instruction " << i->address() << ":" << i->size() << " found at "
+					<< a << " instead of " << a << ":" << insts[j].snd);
+		}
+		catch(DecodingException& e) {
+			error(_ << "look-up at " << a << " failed: " << e.message());
+		}
+	}
+
+	// the item lists must not contain overlapping items
+	for(auto f: proc->files())
+		for(auto s: f->segments()) {
+			ProgItem *prev = nullptr;
+			for(auto item: s->items()) {
+				if(prev != nullptr && prev->topAddress() > item->address())
+					error(_ << "item at " << item->address() << " overlaps item at " << prev->address());
+				prev = item;
+			}
+		}
+	delete ws;
+}
+
+int main(int argc, char **argv) {
+	for(int i = 1; i < argc; i++) {
+		try {
+			Vector<Pair<Address, int> > insts;
+			collect(argv[i], insts);
+			cout << argv[i] << ": " << insts.count() << " instructions in the CFGs\n";
+			check(argv[i], insts);
+		}
+		catch(otawa::Exception& e) {
+			error(e.message());
+		}
+	}
+	if(errors != 0) {
+		cerr << "Test failed!\n";
+		return 1;
+	}
+	cerr << "Test passed!\n";
+	return 0;
+}
@@ -50,6 +50,17 @@ protected:
 						out << " " << w->address();
 				out << io::endl;
 			}
+
+			// check immediate dominators (silent unless an error is found)
+			for(auto w: *g) {
+				Block *d = info->idom(w);
+				if(w->isEntry() ? d != nullptr : (d == w || (d != nullptr && !info->dom(d, w))))
+					out << "ERROR: bad idom for " << w << io::endl;
+				else if(d != nullptr)
+					for(auto v: *g)
+						if(v != w && info->dom(v, w) && !info->dom(v, d))
+							out << "ERROR: " << v << " dominates " << w << " but not its idom " << d << io::endl;
+			}
 		}
 
 	}
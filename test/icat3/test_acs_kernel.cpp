@@ -0,0 +1,124 @@
+/*
+ *	Randomized test of the vector ACS kernels against the scalar ones
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <elm/test.h>
+#include "../../src/icat3/ACSKernel.h"
+
+using namespace elm;
+using namespace otawa;
+using namespace otawa::icat3;
+
+// sizes around the vector widths (16 ages for SSE2, 32 for AVX2) to cover the tails
+static const int sizes[] = { 1, 2, 15, 16, 17, 31, 32, 33, 47, 48, 49, 63, 64, 65, 95, 96, 97 };
+static const int MAX_SIZE = 97 + 3, ROUNDS = 200;
+
+// ages in [-1, 127[ with many ⊥ and small ages as in actual ACS
+static age_t randomAge(int ways) {
+	switch(rand() % 4) {
+	case 0:		return -1;
+	case 1:		return rand() % 127;
+	default:	return rand() % (ways + 1);
+	}
+}
+
+static void fill(age_t *a, int n, int ways) {
+	for(int i = 0; i < n; i++)
+		a[i] = randomAge(ways);
+}
+
+static bool same(const age_t *a, const age_t *b, int n) {
+	return memcmp(a, b, n) == 0;
+}
+
+// compare an implementation with the scalar one
+static bool check(const ACSKernel::impl_t& ref, const ACSKernel::impl_t& impl) {
+	age_t sa[MAX_SIZE], sb[MAX_SIZE], ra[MAX_SIZE], va[MAX_SIZE];
+	for(auto n: sizes)
+		for(int r = 0; r < ROUNDS; r++) {
+			int ways = 1 << (rand() % 5);
+			int off = rand() % 4;		// unaligned accesses
+			age_t *a = sa + off, *b = sb + (rand() % 4);
+			fill(a, n, ways);
+			fill(b, n, ways);
+
+			// join
+			memcpy(ra, a, n);
+			memcpy(va, a, n);
+			ref.max(ra, b, n);
+			impl.max(va, b, n);
+			if(!same(ra, va, n)) {
+				cerr << impl.name << ": max differs for " << n << " ages\n";
+				return false;
+			}
+			memcpy(ra, a, n);
+			memcpy(va, a, n);
+			ref.min(ra, b, n);
+			impl.min(va, b, n);
+			if(!same(ra, va, n)) {
+				cerr << impl.name << ": min differs for " << n << " ages\n";
+				return false;
+			}
+
+			// equals, including a difference in the tail
+			memcpy(va + off, a, n);
+			if(!impl.equals(va + off, a, n)) {
+				cerr << impl.name << ": equals fails for " << n << " equal ages\n";
+				return false;
+			}
+			int d = rand() % 2 ? n - 1 : rand() % n;
+			va[off + d] = va[off + d] == 0 ? 1 : 0;
+			if(impl.equals(va + off, a, n) != ref.equals(va + off, a, n)) {
+				cerr << impl.name << ": equals differs for " << n << " ages at " << d << "\n";
+				return false;
+			}
+
+			// update
+			age_t lo = rand() % 2 ? -128 : -1, hi = rand() % (ways + 2), ex = rand() % 3 ? ways : randomAge(ways);
+			memcpy(ra, a, n);
+			memcpy(va, a, n);
+			ref.inc(ra, n, lo, hi, ex);
+			impl.inc(va, n, lo, hi, ex);
+			if(!same(ra, va, n)) {
+				cerr << impl.name << ": inc(" << int(lo) << ", " << int(hi) << ", " << int(ex)
+					 << ") differs for " << n << " ages\n";
+				return false;
+			}
+		}
+	return true;
+}
+
+int main(void) {
+CHECK_BEGIN("ACSKernel")
+
+	srand(0);
+	CHECK(ACSKernel::countImpls() >= 1);
+	const ACSKernel::impl_t& scalar = ACSKernel::impl(0);
+	CHECK_EQUAL(ACSKernel::name(), ACSKernel::impl(ACSKernel::countImpls() - 1).name);
+	for(int i = 1; i < ACSKernel::countImpls(); i++) {
+		cerr << "TESTING " << ACSKernel::impl(i).name << io::endl;
+		CHECK(check(scalar, ACSKernel::impl(i)));
+	}
+
+CHECK_END
+}
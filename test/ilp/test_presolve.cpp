@@ -0,0 +1,228 @@
+/*
+ *	Test of the ILP presolve against the unpresolved system
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <elm/data/HashMap.h>
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/ilp/PresolvedSystem.h>
+#include <otawa/ipet/features.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+class PresolveTest: public Application {
+public:
+	PresolveTest(void): Application(Make("test_presolve")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		testSmall();
+		testIPET(props);
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	/*
+	 * Small system exercising each reduction:
+	 * a is fixed by a singleton equality, b is substituted by c,
+	 * b + c <= 100 is implied by the bound of c and f, only bounded,
+	 * is fixed to its best bound. The optimum is unique: a = 3, b = c = 10,
+	 * d = 0, e = 7, f = 2 for a value of 42.
+	 */
+	void testSmall(void) {
+		ilp::PresolvedSystem *sys = new ilp::PresolvedSystem(workspace()->process()->manager());
+		ilp::Var
+			*a = sys->newVar("a"),
+			*b = sys->newVar("b"),
+			*c = sys->newVar("c"),
+			*d = sys->newVar("d"),
+			*e = sys->newVar("e"),
+			*f = sys->newVar("f");
+		sys->newConstraint("fix_a", ilp::Constraint::EQ, 3)->addLeft(1, a);
+		ilp::Constraint *k = sys->newConstraint("b_eq_c", ilp::Constraint::EQ, 0);
+		k->addLeft(1, b);
+		k->addRight(1, c);
+		sys->newConstraint("bound_c", ilp::Constraint::LE, 10)->addLeft(1, c);
+		k = sys->newConstraint("implied", ilp::Constraint::LE, 100);
+		k->addLeft(1, b);
+		k->addLeft(1, c);
+		k = sys->newConstraint("d_e", ilp::Constraint::LE, 7);
+		k->addLeft(1, d);
+		k->addLeft(1, e);
+		sys->newConstraint("bound_d", ilp::Constraint::LE, 4)->addLeft(1, d);
+		sys->newConstraint("bound_f", ilp::Constraint::LE, 2)->addLeft(1, f);
+		sys->addObjectFunction(2, a);
+		sys->addObjectFunction(1, b);
+		sys->addObjectFunction(1, c);
+		sys->addObjectFunction(1, d);
+		sys->addObjectFunction(2, e);
+		sys->addObjectFunction(1, f);
+
+		if(!sys->solve(workspace()))
+			fail(_ << "small: presolved system failed: " << sys->lastErrorMessage());
+		if(sys->countFixed() == 0)
+			error("small: no fixed variable");
+		if(sys->countSubstituted() == 0)
+			error("small: no substituted variable");
+		if(sys->countRemoved() == 0)
+			error("small: no removed constraint");
+		if(!equals(sys->value(), 42))
+			error(_ << "small: value " << sys->value() << " instead of 42");
+		double expected[] = { 3, 10, 10, 0, 7, 2 };
+		ilp::Var *vars[] = { a, b, c, d, e, f };
+		for(int i = 0; i < 6; i++)
+			if(!equals(sys->valueOf(vars[i]), expected[i]))
+				error(_ << "small: " << vars[i]->name() << " = " << sys->valueOf(vars[i])
+					<< " instead of " << expected[i]);
+		ilp::System *ref = copy(sys);
+		if(!ref->solve(workspace()))
+			fail(_ << "small: ILP plugin failed: " << ref->lastErrorMessage());
+		if(check("small", sys, ref) != 0)
+			error("small: the optimum is unique but values differ from the ILP plugin");
+		delete ref;
+		delete sys;
+	}
+
+	/*
+	 * IPET system of the task: the presolved solution is compared with
+	 * the solution of the original system by the ILP plugin.
+	 */
+	void testIPET(PropList& props) {
+		ipet::PRESOLVE(props) = true;
+		require(ipet::WCET_FEATURE);
+		ilp::PresolvedSystem *sys = dynamic_cast<ilp::PresolvedSystem *>(ipet::SYSTEM(workspace()));
+		if(sys == nullptr)
+			fail("ILP_SYSTEM_FEATURE did not build a presolved system");
+		cout << "IPET: " << sys->countFixed() << " fixed, " << sys->countSubstituted() << " substituted, "
+			 << sys->countRemoved() << " removed\n";
+		if(sys->countSubstituted() == 0)
+			error("IPET: no substituted variable");
+		if(sys->countRemoved() == 0)
+			error("IPET: no removed constraint");
+		if(!equals(sys->value(), ipet::WCET(workspace())))
+			error(_ << "IPET: WCET " << ipet::WCET(workspace()) << " differs from system value " << sys->value());
+
+		ilp::System *ref = copy(sys);
+		if(!ref->solve(workspace()))
+			fail(_ << "IPET: ILP plugin failed: " << ref->lastErrorMessage());
+		int diffs = check("IPET", sys, ref);
+		if(diffs != 0)
+			cout << "IPET: " << diffs << " variables differ from the ILP plugin (several optimal paths)\n";
+		delete ref;
+	}
+
+	static inline bool equals(double x, double y) { return fabs(x - y) < .5; }
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	void fail(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		sys::System::exit(1);
+	}
+
+	/*
+	 * Copy the given system in a new system of the ILP plugin.
+	 */
+	ilp::System *copy(ilp::System *sys) {
+		ilp::System *ref = workspace()->process()->manager()->newILPSystem("", true);
+		if(ref == nullptr)
+			fail("no ILP plugin available");
+		map.clear();
+		for(ilp::System::ConstIterator c(sys); c(); c++) {
+			ilp::Constraint *rc = ref->newConstraint((*c)->label(), (*c)->comparator(), (*c)->constant());
+			for(ilp::Constraint::TermIterator t(*c); t(); t++)
+				rc->add((*t).snd, var(ref, (*t).fst));
+		}
+		for(ilp::System::ObjTermIterator t(sys); t(); t++)
+			ref->addObjectFunction((*t).snd, (*t).fst == nullptr ? nullptr : var(ref, (*t).fst));
+		return ref;
+	}
+
+	ilp::Var *var(ilp::System *ref, ilp::Var *x) {
+		ilp::Var *r = map.get(x, nullptr);
+		if(r == nullptr) {
+			r = ref->newVar(x->type(), x->name());
+			map.put(x, r);
+		}
+		return r;
+	}
+
+	/*
+	 * Check that the values given by sys for every original variable form
+	 * a feasible solution of the original system reaching the optimum
+	 * found by the ILP plugin ref.
+	 * @return	Number of variables whose value differs from ref.
+	 */
+	int check(cstring name, ilp::System *sys, ilp::System *ref) {
+		if(!equals(sys->value(), ref->value()))
+			error(_ << name << ": value " << sys->value() << " differs from ILP plugin " << ref->value());
+
+		// feasibility
+		for(ilp::System::ConstIterator c(sys); c(); c++) {
+			double sum = 0;
+			for(ilp::Constraint::TermIterator t(*c); t(); t++)
+				sum += (*t).snd * sys->valueOf((*t).fst);
+			double d = sum - (*c)->constant();
+			bool ok;
+			switch((*c)->comparator()) {
+			case ilp::Constraint::LT:	ok = d < 0; break;
+			case ilp::Constraint::LE:	ok = d < .5; break;
+			case ilp::Constraint::EQ:	ok = fabs(d) < .5; break;
+			case ilp::Constraint::GE:	ok = d > -.5; break;
+			case ilp::Constraint::GT:	ok = d > 0; break;
+			default:					ok = true; break;
+			}
+			if(!ok)
+				error(_ << name << ": constraint " << (*c)->label() << " violated by the rebuilt values");
+		}
+
+		// optimality
+		double obj = 0;
+		for(ilp::System::ObjTermIterator t(sys); t(); t++)
+			obj += (*t).fst == nullptr ? (*t).snd : (*t).snd * sys->valueOf((*t).fst);
+		if(!equals(obj, ref->value()))
+			error(_ << name << ": objective of the rebuilt values " << obj << " is not optimal (" << ref->value() << ")");
+
+		// comparison with the original solution
+		int diffs = 0;
+		for(HashMap<ilp::Var *, ilp::Var *>::PairIter x(map); x(); x++)
+			if(!equals(sys->valueOf((*x).fst), ref->valueOf((*x).snd)))
+				diffs++;
+		return diffs;
+	}
+
+	HashMap<ilp::Var *, ilp::Var *> map;
+	int errors;
+};
+
+OTAWA_RUN(PresolveTest);
@@ -0,0 +1,193 @@
+/*
+ *	Test of the native network solver against the ILP plugin
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <math.h>
+#include <elm/data/HashMap.h>
+#include <elm/sys/System.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg/features.h>
+#include <otawa/ilp/System.h>
+#include <otawa/ipet/features.h>
+#include <otawa/ipet/NetworkSystem.h>
+#include <otawa/prog/Manager.h>
+#include <otawa/prog/WorkSpace.h>
+
+using namespace elm;
+using namespace otawa;
+
+class NetworkTest: public Application {
+public:
+	NetworkTest(void): Application(Make("test_network")), errors(0) { }
+
+protected:
+
+	void work(const string& entry, PropList &props) override {
+		ipet::NETWORK_SOLVER(props) = true;
+		require(ipet::WCET_FEATURE);
+		ipet::NetworkSystem *net = dynamic_cast<ipet::NetworkSystem *>(ipet::SYSTEM(workspace()));
+		if(net == nullptr)
+			fail("ILP_SYSTEM_FEATURE did not build a network system");
+		const CFGCollection& coll = **INVOLVED_CFGS(workspace());
+
+		// native solution
+		if(!net->isNative())
+			error("the IPET system is not solved natively");
+		double wcet = net->value();
+		if(!equals(wcet, ipet::WCET(workspace())))
+			error(_ << "WCET " << ipet::WCET(workspace()) << " differs from system value " << wcet);
+		cout << "native WCET: " << wcet << io::endl;
+
+		// reference: same system solved by the ILP plugin
+		ilp::System *ref = copy(net);
+		if(!ref->solve(workspace()))
+			fail(_ << "ILP plugin failed: " << ref->lastErrorMessage());
+		check("native", net, ref, coll);
+		delete ref;
+
+		// fallback: a variable out of the CFG makes the network form not apply
+		ilp::Var *y = net->newVar("y");
+		ilp::Constraint *c = net->newConstraint("y_bound", ilp::Constraint::LE, 5);
+		c->addLeft(1, y);
+		net->addObjectFunction(1, y);
+		if(!net->solve(workspace()))
+			fail(_ << "fallback failed: " << net->lastErrorMessage());
+		if(net->isNative() || net->fallback() == nullptr)
+			error("the extended system is not solved by the ILP plugin");
+		if(!equals(net->value(), wcet + 5))
+			error(_ << "fallback value " << net->value() << " instead of " << (wcet + 5));
+		if(!equals(net->valueOf(y), 5))
+			error(_ << "fallback value of y is " << net->valueOf(y) << " instead of 5");
+		ref = copy(net);
+		if(!ref->solve(workspace()))
+			fail(_ << "ILP plugin failed: " << ref->lastErrorMessage());
+		check("fallback", net, ref, coll);
+		delete ref;
+
+		if(errors != 0) {
+			cerr << "Test failed!\n";
+			sys::System::exit(1);
+		}
+		cerr << "Test passed!\n";
+	}
+
+private:
+
+	static inline bool equals(double x, double y) { return fabs(x - y) < .5; }
+
+	void error(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		errors++;
+	}
+
+	void fail(const string& msg) {
+		cerr << "ERROR: " << msg << io::endl;
+		sys::System::exit(1);
+	}
+
+	/*
+	 * Copy the given system in a new system of the ILP plugin.
+	 */
+	ilp::System *copy(ilp::System *sys) {
+		ilp::System *ref = workspace()->process()->manager()->newILPSystem("", true);
+		if(ref == nullptr)
+			fail("no ILP plugin available");
+		map.clear();
+		for(ilp::System::ConstIterator c(sys); c(); c++) {
+			ilp::Constraint *rc = ref->newConstraint((*c)->label(), (*c)->comparator(), (*c)->constant());
+			for(ilp::Constraint::TermIterator t(*c); t(); t++)
+				rc->add((*t).snd, var(ref, (*t).fst));
+		}
+		for(ilp::System::ObjTermIterator t(sys); t(); t++)
+			ref->addObjectFunction((*t).snd, (*t).fst == nullptr ? nullptr : var(ref, (*t).fst));
+		return ref;
+	}
+
+	ilp::Var *var(ilp::System *ref, ilp::Var *x) {
+		ilp::Var *r = map.get(x, nullptr);
+		if(r == nullptr) {
+			r = ref->newVar(x->type(), x->name());
+			map.put(x, r);
+		}
+		return r;
+	}
+
+	/*
+	 * Compare the solution of sys with the one of the ILP plugin ref.
+	 * The optimal values must be equal. When the variable values differ
+	 * (several optimal solutions), the values of sys must still be a feasible
+	 * solution reaching the optimum.
+	 */
+	void check(cstring name, ilp::System *sys, ilp::System *ref, const CFGCollection& coll) {
+		if(!equals(sys->value(), ref->value()))
+			error(_ << name << ": value " << sys->value() << " differs from ILP plugin " << ref->value());
+
+		// compare block and edge variables
+		int diffs = 0;
+		for(auto v: coll.blocks()) {
+			diffs += compare(sys, ref, ipet::VAR(v));
+			for(auto e: v->outEdges())
+				diffs += compare(sys, ref, ipet::VAR(e));
+		}
+		if(diffs == 0)
+			return;
+		cout << name << ": " << diffs << " variables differ from the ILP plugin, checking optimality\n";
+
+		// check feasibility and optimality of sys solution
+		for(ilp::System::ConstIterator c(sys); c(); c++) {
+			double sum = 0;
+			for(ilp::Constraint::TermIterator t(*c); t(); t++)
+				sum += (*t).snd * sys->valueOf((*t).fst);
+			double d = sum - (*c)->constant();
+			bool ok;
+			switch((*c)->comparator()) {
+			case ilp::Constraint::LT:	ok = d < 0; break;
+			case ilp::Constraint::LE:	ok = d < .5; break;
+			case ilp::Constraint::EQ:	ok = fabs(d) < .5; break;
+			case ilp::Constraint::GE:	ok = d > -.5; break;
+			case ilp::Constraint::GT:	ok = d > 0; break;
+			default:					ok = true; break;
+			}
+			if(!ok)
+				error(_ << name << ": constraint " << (*c)->label() << " violated");
+		}
+		double obj = 0;
+		for(ilp::System::ObjTermIterator t(sys); t(); t++)
+			obj += (*t).fst == nullptr ? (*t).snd : (*t).snd * sys->valueOf((*t).fst);
+		if(!equals(obj, ref->value()))
+			error(_ << name << ": objective of the solution " << obj << " is not optimal (" << ref->value() << ")");
+	}
+
+	int compare(ilp::System *sys, ilp::System *ref, ilp::Var *x) {
+		if(x == nullptr)
+			return 0;
+		ilp::Var *r = map.get(x, nullptr);
+		if(r == nullptr) {
+			error(_ << "variable " << x->name() << " is not in the system");
+			return 0;
+		}
+		return equals(sys->valueOf(x), ref->valueOf(r)) ? 0 : 1;
+	}
+
+	HashMap<ilp::Var *, ilp::Var *> map;
+	int errors;
+};
+
+OTAWA_RUN(NetworkTest);
@@ -0,0 +1,114 @@
+/*
+ *	PropList look-up micro-benchmark
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <elm/option/ValueOption.h>
+#include <elm/sys/StopWatch.h>
+#include <otawa/app/Application.h>
+#include <otawa/cfg.h>
+#include <otawa/cfg/features.h>
+#include <otawa/ipet/features.h>
+
+using namespace elm;
+using namespace elm::option;
+using namespace otawa;
+
+/*
+ * Usage: bench_props [-n ROUNDS] [-e EXTRA] EXECUTABLE [TASK]
+ *
+ * Annotate the CFGs of the executable with the usual features (loops,
+ * dominance, ILP variables) plus EXTRA dummy properties per block and
+ * measure the throughput of the property look-up, first in linear mode
+ * and then in indexed mode (see PropList::setIndexed()).
+ */
+class BenchProps: public Application {
+public:
+	BenchProps(void):
+		Application(Make("bench_props", Version(1, 0, 0))),
+		rounds	(ValueOption<int>::Make(*this).cmd("-n").cmd("--rounds").description("number of look-up rounds").def(1000)),
+		extra	(ValueOption<int>::Make(*this).cmd("-e").cmd("--extra").description("number of extra properties per block").def(16))
+	{ }
+
+protected:
+
+	void work(const string& entry, PropList& props) override {
+		require(COLLECTED_CFG_FEATURE);
+		require(LOOP_INFO_FEATURE);
+		require(DOMINANCE_FEATURE);
+		require(ipet::ASSIGNED_VARS_FEATURE);
+
+		// add extra annotations
+		Vector<Identifier<int> *> ids;
+		for(int i = 0; i < *extra; i++)
+			ids.add(new Identifier<int>("", i));
+		Vector<Block *> blocks;
+		for(auto g: **INVOLVED_CFGS(workspace()))
+			for(auto v: *g) {
+				blocks.add(v);
+				for(auto id: ids)
+					(*id)(v) = 0;
+			}
+
+		// look-ups: a mix of hot identifiers and extra ones
+		Vector<const AbstractIdentifier *> looked;
+		looked.add(&LOOP_HEADER);
+		looked.add(&ENCLOSING_LOOP_HEADER);
+		looked.add(&ipet::VAR);
+		looked.add(&ipet::TIME);
+		for(int i = 0; i < ids.length(); i += 4)
+			looked.add(ids[i]);
+
+		measure("linear", blocks, looked);
+		for(auto v: blocks)
+			v->setIndexed(true);
+		measure("indexed", blocks, looked);
+		for(auto v: blocks)
+			v->setIndexed(false);
+
+		for(auto v: blocks)
+			for(auto id: ids)
+				v->removeProp(id);
+		for(auto id: ids)
+			delete id;
+	}
+
+private:
+
+	void measure(cstring name, const Vector<Block *>& blocks, const Vector<const AbstractIdentifier *>& looked) {
+		t::uint64 found = 0, cnt = 0;
+		sys::StopWatch watch;
+		watch.start();
+		for(int r = 0; r < *rounds; r++)
+			for(auto v: blocks)
+				for(auto id: looked) {
+					if(v->getProp(id))
+						found++;
+					cnt++;
+				}
+		watch.stop();
+		t::uint64 time = watch.delay().micros();
+		cout << name << ": " << cnt << " look-ups (" << found << " found) in "
+			 << time << "us, " << (time ? cnt * 1000000 / time : 0) << " look-ups/s" << io::endl;
+	}
+
+	ValueOption<int> rounds, extra;
+};
+
+OTAWA_RUN(BenchProps)
@@ -229,5 +229,102 @@ CHECK_BEGIN("otawa_props")
 		CHECK(set.isFull());
 	}
 
+	// indexed mode (not supported in concurrent mode)
+#	ifndef OTAWA_CONC
+	{
+		const int N = 64;
+		Identifier<int> *ids[N];
+		for(int i = 0; i < N; i++)
+			ids[i] = new Identifier<int>("", -1);
+		PropList props;
+		for(int i = 0; i < N; i++)
+			(*ids[i])(props) = i;
+		CHECK(!props.isIndexed());
+		CHECK_EQUAL(int((*ids[0])(props)), 0);
+		CHECK(!props.isIndexed());
+		props.setIndexed(true);
+		CHECK(props.isIndexed());
+		int n = 0;
+		for(PropList::Iter p(props); p(); p++)
+			n++;
+		CHECK_EQUAL(n, N);
+
+		// look-up and replacement
+		bool ok = true;
+		for(int i = 0; i < N; i++)
+			if((*ids[i])(props) != i)
+				ok = false;
+		CHECK(ok);
+		(*ids[1])(props) = 111;
+		CHECK_EQUAL(int((*ids[1])(props)), 111);
+
+		// multi-valued properties
+		(*ids[2])(props).add(222);
+		(*ids[2])(props).add(333);
+		CHECK_EQUAL(int((*ids[2])(props)), 333);
+		int cnt = 0;
+		for(auto v: (*ids[2])(props).all()) {
+			cnt++;
+			if(v != 2 && v != 222 && v != 333)
+				ok = false;
+		}
+		CHECK(ok);
+		CHECK_EQUAL(cnt, 3);
+		props.removeProp(*ids[2]);
+		CHECK_EQUAL(int((*ids[2])(props)), 222);
+		props.removeAllProp(*ids[2]);
+		CHECK(!props.hasProp(*ids[2]));
+
+		// removal
+		for(int i = 0; i < N; i += 2)
+			props.removeProp(*ids[i]);
+		for(int i = 0; i < N; i++)
+			if(props.hasProp(*ids[i]) != (i % 2 == 1))
+				ok = false;
+		CHECK(ok);
+		Property *prop = props.extractProp(*ids[3]);
+		CHECK(prop != nullptr);
+		CHECK(!props.hasProp(*ids[3]));
+		delete prop;
+
+		// copy
+		PropList copy(props);
+		CHECK(!copy.isIndexed());
+		CHECK_EQUAL(int((*ids[5])(copy)), 5);
+
+		// back to linear mode
+		props.setIndexed(false);
+		CHECK(!props.isIndexed());
+		CHECK_EQUAL(int((*ids[5])(props)), 5);
+		props.setIndexed(true);
+
+		// moving keeps the indexing mode of both lists
+		PropList moved;
+		moved.setIndexed(true);
+		moved.takeProps(props);
+		CHECK(moved.isIndexed());
+		CHECK(props.isIndexed());
+		CHECK_EQUAL(int((*ids[5])(moved)), 5);
+		CHECK(!props.hasProp(*ids[5]));
+		copy.takeProps(moved);
+		CHECK(!copy.isIndexed());
+		CHECK(moved.isIndexed());
+		CHECK_EQUAL(int((*ids[5])(copy)), 5);
+		props.takeProps(copy);
+		CHECK(props.isIndexed());
+		CHECK_EQUAL(int((*ids[5])(props)), 5);
+
+		props.clearProps();
+		CHECK(props.isIndexed());
+		CHECK(!props.hasProp(*ids[5]));
+		(*ids[5])(props) = 55;
+		CHECK_EQUAL(int((*ids[5])(props)), 55);
+		props.clearProps();
+		copy.clearProps();
+		for(int i = 0; i < N; i++)
+			delete ids[i];
+	}
+#	endif
+
 CHECK_RETURN
 }
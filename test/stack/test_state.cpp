@@ -0,0 +1,201 @@
+/*
+ *	Unit test of the states of the stack analysis
+ *
+ *	This file is part of OTAWA
+ *	Copyright (c) 2026, IRIT UPS.
+ *
+ *	OTAWA is free software; you can redistribute it and/or modify
+ *	it under the terms of the GNU General Public License as published by
+ *	the Free Software Foundation; either version 2 of the License, or
+ *	(at your option) any later version.
+ *
+ *	OTAWA is distributed in the hope that it will be useful,
+ *	but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *	GNU General Public License for more details.
+ *
+ *	You should have received a copy of the GNU General Public License
+ *	along with OTAWA; if not, write to the Free Software
+ *	Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ *	02110-1301  USA
+ */
+
+#include <stdlib.h>
+#include <elm/test.h>
+#include "../../src/prog/StackState.h"
+
+using namespace otawa;
+using namespace otawa::stack;
+
+// only register and SP-relative addresses: the look-up of other addresses
+// falls back to the program image
+static const int REGS = 8, SLOTS = 16, KEYS = REGS + SLOTS;
+
+static Value key(int k) {
+	if(k < REGS)
+		return Value::reg(k);
+	else
+		return Value::sp(4 * (k - REGS) - 32);
+}
+
+static Value randomValue(void) {
+	if(rand() % 4 == 0)
+		return Value::all;
+	else
+		return Value::cst(rand() % 8);
+}
+
+static bool sameAs(const State& s, const Value *m) {
+	for(int k = 0; k < KEYS; k++)
+		if(s.get(key(k), nullptr, 4) != m[k])
+			return false;
+	return true;
+}
+
+// random operations checked against an array model
+static bool randomTest(int steps) {
+	static const int N = 8;
+	State s[N];
+	Value m[N][KEYS];
+	for(int i = 0; i < N; i++)
+		for(int k = 0; k < KEYS; k++)
+			m[i][k] = Value::all;
+	bool ok = true;
+
+	for(int n = 0; ok && n < steps; n++) {
+		int i = rand() % N, j = rand() % N;
+		switch(rand() % 4) {
+		case 0:
+		case 1: {
+				int k = rand() % KEYS;
+				Value v = randomValue();
+				s[i].set(key(k), v);
+				m[i][k] = v;
+			}
+			break;
+		case 2:
+			s[i].join(s[j]);
+			for(int k = 0; k < KEYS; k++)
+				m[i][k].join(m[j][k]);
+			break;
+		case 3: {
+				// a copy shares the tree but is not changed by the writes to the original
+				State c(s[j]);
+				int k = rand() % KEYS;
+				Value v = Value::cst(8 + rand() % 8);
+				s[j].set(key(k), v);
+				if(!sameAs(c, m[j]))
+					ok = false;
+				m[j][k] = v;
+				s[i] = c;
+				for(int l = 0; l < KEYS; l++)
+					m[i][l] = m[j][l];
+				m[i][k] = c.get(key(k), nullptr, 4);
+			}
+			break;
+		}
+
+		// check content and equality
+		if(!sameAs(s[i], m[i]) || !sameAs(s[j], m[j]))
+			ok = false;
+		bool meq = true;
+		for(int k = 0; k < KEYS; k++)
+			if(m[i][k] != m[j][k])
+				meq = false;
+		if(s[i].equals(s[j]) != meq)
+			ok = false;
+	}
+	return ok;
+}
+
+int main(void) {
+CHECK_BEGIN("stack::State")
+
+	Value r0 = Value::reg(0), r1 = Value::reg(1), sp4 = Value::sp(4), cst = Value::cst(0x1000);
+	Value one = Value::cst(1), two = Value::cst(2);
+
+	{
+		// set / get
+		State s;
+		CHECK_EQUAL(s.get(r0, nullptr, 4), Value::all);
+		s.set(r0, one);
+		s.set(sp4, two);
+		CHECK_EQUAL(s.get(r0, nullptr, 4), one);
+		CHECK_EQUAL(s.get(sp4, nullptr, 4), two);
+		CHECK_EQUAL(s.get(r1, nullptr, 4), Value::all);
+		s.set(r0, Value::all);
+		CHECK_EQUAL(s.get(r0, nullptr, 4), Value::all);
+
+		// the shape does not depend on the order of insertion
+		State s1, s2;
+		for(int k = 0; k < KEYS; k++)
+			s1.set(key(k), Value::cst(k));
+		for(int k = KEYS - 1; k >= 0; k--)
+			s2.set(key(k), Value::cst(k));
+		CHECK(s1.equals(s2));
+		s2.set(key(3), one);
+		CHECK(!s1.equals(s2));
+
+		// bottom
+		State b(Value::none);
+		CHECK(b.isBot());
+		b.set(r0, one);
+		CHECK(b.equals(State(Value::none)));
+		CHECK(!b.equals(s));
+	}
+
+	{
+		// copy shares the nodes but not the writes
+		State s;
+		s.set(r0, one);
+		s.set(r1, two);
+		State c(s);
+		CHECK(c.equals(s));
+		s.set(r0, two);
+		CHECK_EQUAL(c.get(r0, nullptr, 4), one);
+		CHECK_EQUAL(s.get(r0, nullptr, 4), two);
+		CHECK(!c.equals(s));
+		c.set(r1, one);
+		CHECK_EQUAL(s.get(r1, nullptr, 4), two);
+	}
+
+	{
+		// join
+		State s1, s2;
+		s1.set(r0, one);
+		s1.set(r1, one);
+		s1.set(sp4, two);
+		s2.set(r0, one);
+		s2.set(r1, two);
+		s1.join(s2);
+		CHECK_EQUAL(s1.get(r0, nullptr, 4), one);
+		CHECK_EQUAL(s1.get(r1, nullptr, 4), Value::all);
+		CHECK_EQUAL(s1.get(sp4, nullptr, 4), Value::all);
+		State b(Value::none);
+		b.join(s2);
+		CHECK(b.equals(s2));
+		s2.join(State(Value::none));
+		CHECK(b.equals(s2));
+	}
+
+	{
+		// a write at any address only keeps the register and SP-relative cells
+		State s, r;
+		s.set(r0, one);
+		s.set(sp4, two);
+		r = s;
+		s.set(cst, one);
+		CHECK(!s.equals(r));
+		s.set(Value::all, one);
+		CHECK(s.equals(r));
+	}
+
+	// random test against an array model
+	srand(0);
+	CHECK(randomTest(20000));
+
+	// all nodes are released with the states
+	CHECK_EQUAL(Arena<State::Node>::count(), 0);
+
+CHECK_END
+}
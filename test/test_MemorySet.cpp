@@ -20,230 +20,346 @@
  *	02110-1301  USA
  */
 
+#include <stdlib.h>
 #include <elm/test.h>
+#include <elm/sys/StopWatch.h>
+#include <elm/util/BitVector.h>
 #include <otawa/dfa/MemorySet.h>
 
 using namespace otawa;
 using namespace otawa::dfa;
 
+// reference model: one bit per byte of [0, MODEL_SIZE[
+static const int MODEL_SIZE = 0x400;
+
+static inline MemArea randomArea(void) {
+	int base = rand() % (MODEL_SIZE - 0x40);
+	return MemArea(Address(base), 1 + rand() % 0x40);
+}
+
+static inline void replace(MemorySet& set, MemorySet::t& s, MemorySet::t n) {
+	set.free(s);
+	s = n;
+}
+
+// random operations checked against the bit model
+static bool randomTest(MemorySet& set, int steps) {
+	static const int N = 16;
+	MemorySet::t s[N];
+	BitVector m[N];
+	for(int i = 0; i < N; i++)
+		m[i] = BitVector(MODEL_SIZE);
+	bool ok = true;
+
+	for(int k = 0; ok && k < steps; k++) {
+		int i = rand() % N, j = rand() % N;
+		MemArea a = randomArea();
+		switch(rand() % 5) {
+		case 0:
+		case 1:
+			replace(set, s[i], set.add(s[i], a));
+			for(int b = a.address().offset(); b < int(a.topAddress().offset()); b++)
+				m[i].set(b);
+			break;
+		case 2:
+			replace(set, s[i], set.remove(s[i], a));
+			for(int b = a.address().offset(); b < int(a.topAddress().offset()); b++)
+				m[i].clear(b);
+			break;
+		case 3:
+			replace(set, s[i], set.join(s[i], s[j]));
+			for(int b = 0; b < MODEL_SIZE; b++)
+				if(m[j].bit(b))
+					m[i].set(b);
+			break;
+		case 4:
+			replace(set, s[i], set.meet(s[i], s[j]));
+			for(int b = 0; b < MODEL_SIZE; b++)
+				if(!m[j].bit(b))
+					m[i].clear(b);
+			break;
+		}
+
+		// check content
+		for(int b = 0; b < MODEL_SIZE; b++)
+			if((Address(b) % s[i]) != m[i].bit(b))
+				ok = false;
+
+		// check equality (conservative as meet() may split areas)
+		if(s[i] == s[j])
+			for(int b = 0; b < MODEL_SIZE; b++)
+				if(m[i].bit(b) != m[j].bit(b))
+					ok = false;
+	}
+
+	for(int i = 0; i < N; i++)
+		set.free(s[i]);
+	return ok;
+}
+
+// throughput on a slicing-like workload: sets built area by area and joined
+static void throughput(cstring name, MemorySet& set, int rounds) {
+	static const int N = 64;
+	MemorySet::t s[N];
+	t::uint64 ops = 0;
+	srand(0);
+	sys::StopWatch watch;
+	watch.start();
+	for(int r = 0; r < rounds; r++) {
+		int i = rand() % N;
+		MemArea a(Address((rand() % 0x200) * 8), 4);
+		replace(set, s[i], set.add(s[i], a));
+		int j = rand() % N;
+		replace(set, s[j], set.join(s[j], s[i]));
+		MemorySet::t n = set.meet(s[i], s[j]);
+		if(n != MemorySet::empty)
+			replace(set, s[i], set.remove(s[i], *n.areas()));
+		set.free(n);
+		if(s[i] == s[j])
+			ops++;
+		if(a % s[j])
+			ops++;
+		ops += 5;
+	}
+	watch.stop();
+	for(int i = 0; i < N; i++)
+		set.free(s[i]);
+	t::uint64 time = watch.delay().micros();
+	cerr << name << ": " << ops << " operations in " << time << "us, "
+		 << (time ? ops * 1000000 / time : 0) << " operations/s" << io::endl;
+}
+
 int main(void) {
 CHECK_BEGIN("MemorySet")
 
-	MemorySet set;
 	typedef MemorySet::t t;
-	MemArea a1(0x100, Address(0x200));	// --XXXX-------------
-	MemArea a2(0x400, Address(0x500));	// -------------XXXX--
-	MemArea a3(0x300, Address(0x350));	// --------XX---------
-	MemArea a4(0x150, Address(0x450));	// ---XXXXXXXXXXXX----
-	MemArea a5(0x050, Address(0x150));	// -XXX---------------
-	MemArea a6(0x450, Address(0x550));  // ---------------XXX-
-	MemArea a7(0x120, Address(0x180));			// ---XX--------------
-
-	// empty test
-	CHECK_EQUAL(set.empty, set.empty);
-	CHECK(!(Address(0x150) % set.empty));
-
-	// addition tests
+	MemorySet set;
 	{
-		// simple addition
-		t m1 = set.add(set.empty, a1);
-		CHECK_EQUAL(m1, m1);
-		CHECK(Address(0x150) % m1);
-		CHECK(Address(0x100) % m1);
-		CHECK(!(Address(0x200) % m1));
-		CHECK(!(Address(0x450) % m1));
-		cerr << "DEBUG: a1 = " << a1 << ", " << a1.isEmpty() << io::endl;
-		CHECK(a1 % m1);
-		CHECK(!(a2 % m1));
-		CHECK(!(a4 % m1));
-		CHECK(!(a5 % m1));
-
-		// disjoined addition
-		t m2 = set.add(m1, a2);
-		CHECK_EQUAL(m2, m2);
-		CHECK(Address(0x150) % m1);
-		CHECK(Address(0x450) % m2);
-		CHECK(!(Address(0x300) % m2));
-		CHECK(!(Address(0x50) % m2));
-		CHECK(!(Address(0x550) % m2));
-
-		// joined addition
-		t m3 = set.add(m1, a4);
-		CHECK(Address(0x150) % m3);
-		CHECK(Address(0x200) % m3);
-		CHECK(Address(0x250) % m3);
-		CHECK(Address(0x400) % m3);
-		CHECK(!(Address(0x50) % m3));
-		CHECK(!(Address(0x500) % m3));
-		CHECK(!(Address(0x450) % m3));
-
-		// free all
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-	}
 
-	// remove test
-	{
-		// remove in middle
-		t m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
-		t m2 = set.remove(m1, MemArea(0x120, 0x60));
-		CHECK(Address(0x110) % m2);
-		CHECK(Address(0x190) % m2);
-		CHECK(!(Address(0x150) % m2));
-		CHECK(!(Address(0x50) % m2));
-		CHECK(!(Address(0x250) % m2));
-		set.free(m1);
-		set.free(m2);
-
-		// remove before
-		m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
-		m2 = set.remove(m1, MemArea(0x50, 0x100));
-		CHECK(Address(0x150) % m2);
-		CHECK(Address(0x180) % m2);
-		CHECK(!(Address(0x100) % m2));
-		CHECK(!(Address(0x50) % m2));
-		CHECK(!(Address(0x200) % m2));
-		CHECK(!(Address(0x300) % m2));
-		set.free(m1);
-		set.free(m2);
-
-		// remove after
-		m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
-		m2 = set.remove(m1, MemArea(0x150, 0x100));
-		CHECK(Address(0x100) % m2);
-		CHECK(Address(0x120) % m2);
-		CHECK(!(Address(0x50) % m2));
-		CHECK(!(Address(0x150) % m2));
-		CHECK(!(Address(0x200) % m2));
-		CHECK(!(Address(0x300) % m2));
-		set.free(m1);
-		set.free(m2);
-
-		// remove between
-		m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
-		m2 = set.add(m1, MemArea(0x300, 0x100));
-		t m3 = set.remove(m2, MemArea(0x220, 0x280));
-		CHECK(Address(0x100) % m3);
-		CHECK(Address(0x150) % m3);
-		CHECK(Address(0x300) % m3);
-		CHECK(Address(0x350) % m3);
-		CHECK(!(Address(0x50) % m3));
-		CHECK(!(Address(0x250) % m3));
-		CHECK(!(Address(0x450) % m3));
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-
-		// remove across
-		m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
-		m2 = set.add(m1, MemArea(0x300, 0x100));
-		m3 = set.remove(m2, MemArea(0x150, 0x200));
-		CHECK(!(Address(0x50) % m3));
-		CHECK(Address(0x100) % m3);
-		CHECK(Address(0x120) % m3);
-		CHECK(!(Address(0x150) % m3));
-		CHECK(!(Address(0x200) % m3));
-		CHECK(!(Address(0x300) % m3));
-		CHECK(Address(0x350) % m3);
-		CHECK(Address(0x380) % m3);
-		CHECK(!(Address(0x400) % m3));
-		CHECK(!(Address(0x450) % m3));
-	}
+		MemArea a1(0x100, Address(0x200));	// --XXXX-------------
+		MemArea a2(0x400, Address(0x500));	// -------------XXXX--
+		MemArea a3(0x300, Address(0x350));	// --------XX---------
+		MemArea a4(0x150, Address(0x450));	// ---XXXXXXXXXXXX----
+		MemArea a5(0x050, Address(0x150));	// -XXX---------------
+		MemArea a6(0x450, Address(0x550));  // ---------------XXX-
+		MemArea a7(0x120, Address(0x180));			// ---XX--------------
 
-	// equality test
-	{
-		// different source
-		t m1 = set.add(set.empty, MemArea(0x100, 0x100));
-		t m2 = set.add(set.empty, MemArea(0x100, 0x100));
-		CHECK_EQUAL(m1, m2);
-		set.free(m1);
-		set.free(m2);
-
-		// sparse set
-		m1 = set.add(set.empty, MemArea(0x100, 0x100));
-		m2 = set.add(m1, MemArea(0x300, 0x100));
-		t m3 = set.add(m1, MemArea(0x300, 0x100));
-		CHECK_EQUAL(m2, m3);
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-
-		// join set
-		m1 = set.add(set.empty, MemArea(0x100, 0x200));
-		m2 = set.add(set.empty, MemArea(0x100, 0x100));
-		m3 = set.add(m2, MemArea(0x200, 0x100));
-		CHECK_EQUAL(m1, m3);
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
+		// empty test
+		CHECK_EQUAL(set.empty, set.empty);
+		CHECK(!(Address(0x150) % set.empty));
+
+		// addition tests
+		{
+			// simple addition
+			t m1 = set.add(set.empty, a1);
+			CHECK_EQUAL(m1, m1);
+			CHECK(Address(0x150) % m1);
+			CHECK(Address(0x100) % m1);
+			CHECK(!(Address(0x200) % m1));
+			CHECK(!(Address(0x450) % m1));
+			cerr << "DEBUG: a1 = " << a1 << ", " << a1.isEmpty() << io::endl;
+			CHECK(a1 % m1);
+			CHECK(!(a2 % m1));
+			CHECK(!(a4 % m1));
+			CHECK(!(a5 % m1));
+
+			// disjoined addition
+			t m2 = set.add(m1, a2);
+			CHECK_EQUAL(m2, m2);
+			CHECK(Address(0x150) % m1);
+			CHECK(Address(0x450) % m2);
+			CHECK(!(Address(0x300) % m2));
+			CHECK(!(Address(0x50) % m2));
+			CHECK(!(Address(0x550) % m2));
+
+			// joined addition
+			t m3 = set.add(m1, a4);
+			CHECK(Address(0x150) % m3);
+			CHECK(Address(0x200) % m3);
+			CHECK(Address(0x250) % m3);
+			CHECK(Address(0x400) % m3);
+			CHECK(!(Address(0x50) % m3));
+			CHECK(!(Address(0x500) % m3));
+			CHECK(!(Address(0x450) % m3));
+
+			// free all
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+		}
+
+		// remove test
+		{
+			// remove in middle
+			t m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
+			t m2 = set.remove(m1, MemArea(0x120, 0x60));
+			CHECK(Address(0x110) % m2);
+			CHECK(Address(0x190) % m2);
+			CHECK(!(Address(0x150) % m2));
+			CHECK(!(Address(0x50) % m2));
+			CHECK(!(Address(0x250) % m2));
+			set.free(m1);
+			set.free(m2);
+
+			// remove before
+			m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
+			m2 = set.remove(m1, MemArea(0x50, 0x100));
+			CHECK(Address(0x150) % m2);
+			CHECK(Address(0x180) % m2);
+			CHECK(!(Address(0x100) % m2));
+			CHECK(!(Address(0x50) % m2));
+			CHECK(!(Address(0x200) % m2));
+			CHECK(!(Address(0x300) % m2));
+			set.free(m1);
+			set.free(m2);
+
+			// remove after
+			m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
+			m2 = set.remove(m1, MemArea(0x150, 0x100));
+			CHECK(Address(0x100) % m2);
+			CHECK(Address(0x120) % m2);
+			CHECK(!(Address(0x50) % m2));
+			CHECK(!(Address(0x150) % m2));
+			CHECK(!(Address(0x200) % m2));
+			CHECK(!(Address(0x300) % m2));
+			set.free(m1);
+			set.free(m2);
+
+			// remove between
+			m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
+			m2 = set.add(m1, MemArea(0x300, 0x100));
+			t m3 = set.remove(m2, MemArea(0x220, 0x280));
+			CHECK(Address(0x100) % m3);
+			CHECK(Address(0x150) % m3);
+			CHECK(Address(0x300) % m3);
+			CHECK(Address(0x350) % m3);
+			CHECK(!(Address(0x50) % m3));
+			CHECK(!(Address(0x250) % m3));
+			CHECK(!(Address(0x450) % m3));
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+
+			// remove across
+			m1 = set.add(MemorySet::empty, MemArea(0x100, 0x100));
+			m2 = set.add(m1, MemArea(0x300, 0x100));
+			m3 = set.remove(m2, MemArea(0x150, 0x200));
+			CHECK(!(Address(0x50) % m3));
+			CHECK(Address(0x100) % m3);
+			CHECK(Address(0x120) % m3);
+			CHECK(!(Address(0x150) % m3));
+			CHECK(!(Address(0x200) % m3));
+			CHECK(!(Address(0x300) % m3));
+			CHECK(Address(0x350) % m3);
+			CHECK(Address(0x380) % m3);
+			CHECK(!(Address(0x400) % m3));
+			CHECK(!(Address(0x450) % m3));
+		}
+
+		// equality test
+		{
+			// different source
+			t m1 = set.add(set.empty, MemArea(0x100, 0x100));
+			t m2 = set.add(set.empty, MemArea(0x100, 0x100));
+			CHECK_EQUAL(m1, m2);
+			set.free(m1);
+			set.free(m2);
+
+			// sparse set
+			m1 = set.add(set.empty, MemArea(0x100, 0x100));
+			m2 = set.add(m1, MemArea(0x300, 0x100));
+			t m3 = set.add(m1, MemArea(0x300, 0x100));
+			CHECK_EQUAL(m2, m3);
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+
+			// join set
+			m1 = set.add(set.empty, MemArea(0x100, 0x200));
+			m2 = set.add(set.empty, MemArea(0x100, 0x100));
+			m3 = set.add(m2, MemArea(0x200, 0x100));
+			CHECK_EQUAL(m1, m3);
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+		}
+
+		// join tests
+		{
+
+			// sparse join
+			t m1 = set.add(set.empty, MemArea(0x100, 0x100));
+			t m2 = set.add(set.empty, MemArea(0x300, 0x100));
+			t m3 = set.join(m1, m2);
+			CHECK(Address(0x100) % m3);
+			CHECK(Address(0x150) % m3);
+			CHECK(Address(0x300) % m3);
+			CHECK(Address(0x350) % m3);
+			CHECK(!(Address(0x50) % m3));
+			CHECK(!(Address(0x200) % m3));
+			CHECK(!(Address(0x250) % m3));
+			CHECK(!(Address(0x400) % m3));
+			CHECK(!(Address(0x450) % m3));
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+
+			// melting join
+			m1 = set.add(set.empty, MemArea(0x100, 0x200));
+			m2 = set.add(set.empty, MemArea(0x200, 0x200));
+			m3 = set.join(m1, m2);
+			CHECK(Address(0x100) % m3);
+			CHECK(Address(0x200) % m3);
+			CHECK(Address(0x300) % m3);
+			CHECK(!(Address(0x50) % m3));
+			CHECK(!(Address(0x400) % m3));
+			CHECK(!(Address(0x500) % m3));
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+
+			// interleaved join
+			m1 = set.add(set.empty, MemArea(0x100, 0x100));
+			m2 = set.add(m1, MemArea(0x500, 0x100));
+			m3 = set.add(set.empty, MemArea(0x300, 0x100));
+			t m4 = set.add(m3, MemArea(0x600, 0x100));
+			t m5 = set.join(m2, m4);
+			CHECK(!(Address(0x50) % m5));
+			CHECK(Address(0x150) % m5);
+			CHECK(!(Address(0x250) % m5));
+			CHECK(Address(0x350) % m5);
+			CHECK(!(Address(0x450) % m5));
+			CHECK(Address(0x550) % m5);
+			CHECK(Address(0x650) % m5);
+			CHECK(!(Address(0x750) % m5));
+			set.free(m1);
+			set.free(m2);
+			set.free(m3);
+			set.free(m4);
+			set.free(m5);
+
+			// empty is null element for join
+			t t1 = set.add(set.empty, MemArea(0x100, 0x100));
+			t t2 = set.add(t1, MemArea(0x300, 0x100));
+			t t3 = set.join(set.empty, t2);
+			CHECK_EQUAL(t2, t3);
+			t t4 = set.join(t2, set.empty);
+			CHECK_EQUAL(t2, t4);
+			set.free(t1);
+			set.free(t2);
+			set.free(t3);
+			set.free(t4);
+		}
+
+		// random test against a bit model
+		srand(0);
+		CHECK(randomTest(set, 5000));
 	}
 
-	// join tests
+	// throughput
 	{
-
-		// sparse join
-		t m1 = set.add(set.empty, MemArea(0x100, 0x100));
-		t m2 = set.add(set.empty, MemArea(0x300, 0x100));
-		t m3 = set.join(m1, m2);
-		CHECK(Address(0x100) % m3);
-		CHECK(Address(0x150) % m3);
-		CHECK(Address(0x300) % m3);
-		CHECK(Address(0x350) % m3);
-		CHECK(!(Address(0x50) % m3));
-		CHECK(!(Address(0x200) % m3));
-		CHECK(!(Address(0x250) % m3));
-		CHECK(!(Address(0x400) % m3));
-		CHECK(!(Address(0x450) % m3));
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-
-		// melting join
-		m1 = set.add(set.empty, MemArea(0x100, 0x200));
-		m2 = set.add(set.empty, MemArea(0x200, 0x200));
-		m3 = set.join(m1, m2);
-		CHECK(Address(0x100) % m3);
-		CHECK(Address(0x200) % m3);
-		CHECK(Address(0x300) % m3);
-		CHECK(!(Address(0x50) % m3));
-		CHECK(!(Address(0x400) % m3));
-		CHECK(!(Address(0x500) % m3));
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-
-		// interleaved join
-		m1 = set.add(set.empty, MemArea(0x100, 0x100));
-		m2 = set.add(m1, MemArea(0x500, 0x100));
-		m3 = set.add(set.empty, MemArea(0x300, 0x100));
-		t m4 = set.add(m3, MemArea(0x600, 0x100));
-		t m5 = set.join(m2, m4);
-		CHECK(!(Address(0x50) % m5));
-		CHECK(Address(0x150) % m5);
-		CHECK(!(Address(0x250) % m5));
-		CHECK(Address(0x350) % m5);
-		CHECK(!(Address(0x450) % m5));
-		CHECK(Address(0x550) % m5);
-		CHECK(Address(0x650) % m5);
-		CHECK(!(Address(0x750) % m5));
-		set.free(m1);
-		set.free(m2);
-		set.free(m3);
-		set.free(m4);
-		set.free(m5);
-
-		// empty is null element for join
-		t t1 = set.add(set.empty, MemArea(0x100, 0x100));
-		t t2 = set.add(t1, MemArea(0x300, 0x100));
-		t t3 = set.join(set.empty, t2);
-		CHECK_EQUAL(t2, t3);
-		t t4 = set.join(t2, set.empty);
-		CHECK_EQUAL(t2, t4);
-		set.free(t1);
-		set.free(t2);
-		set.free(t3);
-		set.free(t4);
+		MemorySet simple;
+		throughput("MemorySet", simple, 5000);
 	}
 
 CHECK_END